@@ -0,0 +1,122 @@
+/**
+ * @file Bench.hpp
+ * @author Summer
+ * @brief 加载路径基准测试的公共设施
+ *
+ * 每个基准用例是一个独立的函数，由 main.cpp 按名称调度：
+ * @code
+ * bench                     # 运行全部用例
+ * bench snapshot-map        # 只运行指定用例
+ * bench snapshot-map --readers 16 --loaders 4 --entries 50000
+ * @endcode
+ *
+ * 需要GPU的用例通过 headlessContext() 以无窗口模式初始化 Vulkan，没有可用设备时该用例报告失败。
+ *
+ * @version 1.0
+ * @date 2025-12-01
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace vkcore
+{
+class VkContext;
+}
+
+namespace bench
+{
+
+/**
+ * @struct BenchOptions
+ * @brief 命令行可调整的基准参数
+ */
+struct BenchOptions
+{
+    uint32_t readers = 8;     ///< 并发读线程数量
+    uint32_t loaders = 2;     ///< 并发加载（写入）线程数量
+    uint32_t entries = 20000; ///< 加载阶段插入的条目数量
+    uint32_t repeats = 5;     ///< 每项测量的重复次数，报告中位数
+    uint32_t pipelines = 48;  ///< 管线缓存用例创建的管线数量
+    uint32_t shaders = 256;   ///< 反射缓存用例的着色器程序数量
+    uint32_t uploads = 4096;  ///< 小块上传用例每轮的上传次数
+};
+
+/**
+ * @class Stopwatch
+ * @brief 基于 steady_clock 的计时器
+ */
+class Stopwatch
+{
+  public:
+    Stopwatch() : m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    void restart()
+    {
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    double elapsedMs() const
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+  private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * @brief 打印一行 "名称: 数值 单位" 格式的结果
+ */
+void report(const std::string &name, double value, const std::string &unit);
+
+/**
+ * @brief 中位数，空集合返回0
+ */
+double median(std::vector<double> values);
+
+/**
+ * @brief 自当前目录向上查找包含 assets 目录的项目根目录下的 assets
+ * @throws std::runtime_error 找不到 assets 目录
+ */
+std::filesystem::path findAssetsRoot();
+
+/**
+ * @brief 无窗口模式的 Vulkan 上下文，首次调用时初始化（关闭验证层，避免影响计时）
+ * @throws std::runtime_error 没有可用的 Vulkan 设备
+ */
+vkcore::VkContext &headlessContext();
+
+/**
+ * @brief N个读线程查找、M个加载线程批量插入时 SnapshotMap 的吞吐与写放大
+ */
+void runSnapshotMapBench(const BenchOptions &options);
+
+/**
+ * @brief 冷（空）管线缓存与暖（预填充）管线缓存下批量创建图形管线的耗时
+ */
+void runPipelineCacheBench(const BenchOptions &options);
+
+/**
+ * @brief 着色器库的反射缓存：未命中（spirv-reflect）、内存命中与磁盘命中的单程序耗时
+ */
+void runReflectionCacheBench(const BenchOptions &options);
+
+/**
+ * @brief 可映射设备内存上直接写入与staging复制两条上传路径的吞吐
+ */
+void runDirectWriteBench(const BenchOptions &options);
+
+/**
+ * @brief 小块上传的每秒次数：逐次提交（依赖命令缓冲复用）与合并为一个UploadBatch
+ */
+void runSmallUploadBench(const BenchOptions &options);
+
+} // namespace bench
@@ -0,0 +1,83 @@
+#include "Bench.hpp"
+#include "TransferManager.hpp"
+#include "VkContext.hpp"
+#include "VkResource.hpp"
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
+namespace bench
+{
+namespace
+{
+/// 每轮上传的总字节数
+constexpr vk::DeviceSize kPassBytes = 16ull * 1024 * 1024;
+/// 单次 uploadToBuffer 的大小：小块常量/实例数据、中等网格、大网格
+constexpr std::array<vk::DeviceSize, 3> kChunkSizes = {4ull * 1024, 256ull * 1024, 4ull * 1024 * 1024};
+
+/**
+ * @brief 以chunk为单位把一轮数据上传到buffer并等待全部完成，返回吞吐（GB/s）
+ */
+double uploadPass(vkcore::TransferManager &transfer, const vkcore::ManagedBuffer &buffer,
+                  const std::vector<uint8_t> &data, vk::DeviceSize chunk)
+{
+    std::vector<vkcore::TransferToken> tokens;
+    tokens.reserve(static_cast<size_t>(kPassBytes / chunk));
+    Stopwatch stopwatch;
+    for (vk::DeviceSize offset = 0; offset < kPassBytes; offset += chunk)
+    {
+        tokens.push_back(transfer.uploadToBuffer(buffer, data.data() + offset, chunk, offset));
+    }
+    for (auto &token : tokens)
+    {
+        token.wait();
+    }
+    const double seconds = stopwatch.elapsedMs() / 1000.0;
+    return static_cast<double>(kPassBytes) / seconds / 1.0e9;
+}
+} // namespace
+
+void runDirectWriteBench(const BenchOptions &options)
+{
+    vkcore::VkContext &context = headlessContext();
+    vkcore::VkResourceAllocator allocator;
+    allocator.initialize(context);
+
+    vkcore::BufferDesc desc{};
+    desc.size = kPassBytes;
+    desc.usage = vkcore::BufferUsageFlags::Vertex | vkcore::BufferUsageFlags::TransferDst;
+    desc.memory = vkcore::MemoryUsage::GpuOnly;
+    desc.debugName = "Bench Direct Write Buffer";
+    desc.allowDirectWrite = true;
+    vkcore::ManagedBuffer buffer = allocator.createBuffer(desc);
+    // 设备没有HOST_VISIBLE|DEVICE_LOCAL内存时buffer不会被映射，两种模式都走staging
+    report("direct write supported", allocator.supportsDirectWrite() ? 1.0 : 0.0, "");
+    report("buffer mapped", buffer.getMappedData() ? 1.0 : 0.0, "");
+
+    std::vector<uint8_t> data(static_cast<size_t>(kPassBytes));
+    std::iota(data.begin(), data.end(), uint8_t{0});
+
+    for (const bool directWrite : {false, true})
+    {
+        vkcore::TransferManagerConfig config;
+        config.enableDirectWrite = directWrite;
+        vkcore::TransferManager transfer;
+        transfer.initialize(context, allocator, config);
+        for (const vk::DeviceSize chunk : kChunkSizes)
+        {
+            std::vector<double> throughput;
+            for (uint32_t repeat = 0; repeat < (std::max)(options.repeats, 1u); ++repeat)
+            {
+                throughput.push_back(uploadPass(transfer, buffer, data, chunk));
+            }
+            report(std::string(directWrite ? "direct write " : "staging ") + std::to_string(chunk / 1024) + " KB",
+                   median(throughput), "GB/s");
+        }
+        const vkcore::StagingStats stats = transfer.getStagingStats();
+        report(std::string(directWrite ? "direct write" : "staging") + " path: direct writes",
+               static_cast<double>(stats.directWrites), "");
+    }
+}
+
+} // namespace bench
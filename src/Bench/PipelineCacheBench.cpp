@@ -0,0 +1,195 @@
+#include "Bench.hpp"
+#include "ResourceManager.hpp"
+#include "VkContext.hpp"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace bench
+{
+namespace
+{
+/**
+ * @brief 一组管线状态，对应场景中的材质/渲染状态组合（共48种，超出后循环）
+ */
+struct PipelineVariant
+{
+    vk::CullModeFlags cullMode;
+    vk::FrontFace frontFace;
+    vk::CompareOp depthCompare;
+    bool blend;
+};
+
+PipelineVariant makeVariant(uint32_t index)
+{
+    constexpr std::array cullModes = {vk::CullModeFlags{vk::CullModeFlagBits::eNone},
+                                      vk::CullModeFlags{vk::CullModeFlagBits::eBack},
+                                      vk::CullModeFlags{vk::CullModeFlagBits::eFront}};
+    constexpr std::array compareOps = {vk::CompareOp::eLess, vk::CompareOp::eLessOrEqual, vk::CompareOp::eGreater,
+                                       vk::CompareOp::eAlways};
+    PipelineVariant variant{};
+    variant.cullMode = cullModes[index % cullModes.size()];
+    index /= static_cast<uint32_t>(cullModes.size());
+    variant.depthCompare = compareOps[index % compareOps.size()];
+    index /= static_cast<uint32_t>(compareOps.size());
+    variant.frontFace = (index % 2) ? vk::FrontFace::eClockwise : vk::FrontFace::eCounterClockwise;
+    variant.blend = ((index / 2) % 2) != 0;
+    return variant;
+}
+
+/**
+ * @brief 与 app.cpp 相同的动态渲染图形管线，仅光栅化/深度/混合状态随变体变化
+ */
+vk::Pipeline createPipeline(vk::Device device, vk::PipelineCache cache, vk::PipelineLayout layout,
+                            const asset::shaderProgram &program, const PipelineVariant &variant)
+{
+    vk::PipelineShaderStageCreateInfo stages[2]{};
+    stages[0].stage = vk::ShaderStageFlagBits::eVertex;
+    stages[0].module = program.vertexShader->shaderModule;
+    stages[0].pName = "main";
+    stages[1].stage = vk::ShaderStageFlagBits::eFragment;
+    stages[1].module = program.fragmentShader->shaderModule;
+    stages[1].pName = "main";
+
+    auto bindingDescription = asset::Vertex::getBindingDescription();
+    auto attributeDescriptions = asset::Vertex::getAttributeDescriptions();
+    vk::PipelineVertexInputStateCreateInfo vertexInput{};
+    vertexInput.vertexBindingDescriptionCount = 1;
+    vertexInput.pVertexBindingDescriptions = &bindingDescription;
+    vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+    vertexInput.pVertexAttributeDescriptions = attributeDescriptions.data();
+
+    vk::PipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.topology = vk::PrimitiveTopology::eTriangleList;
+
+    vk::PipelineViewportStateCreateInfo viewportState{};
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+    std::array dynamicStates = {vk::DynamicState::eViewport, vk::DynamicState::eScissor};
+    vk::PipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicState.pDynamicStates = dynamicStates.data();
+
+    vk::PipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.polygonMode = vk::PolygonMode::eFill;
+    rasterizer.lineWidth = 1.0f;
+    rasterizer.cullMode = variant.cullMode;
+    rasterizer.frontFace = variant.frontFace;
+
+    vk::PipelineMultisampleStateCreateInfo multisampling{};
+    multisampling.rasterizationSamples = vk::SampleCountFlagBits::e1;
+
+    vk::PipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.depthTestEnable = VK_TRUE;
+    depthStencil.depthWriteEnable = VK_TRUE;
+    depthStencil.depthCompareOp = variant.depthCompare;
+
+    vk::PipelineColorBlendAttachmentState blendAttachment{};
+    blendAttachment.colorWriteMask = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
+                                     vk::ColorComponentFlagBits::eB | vk::ColorComponentFlagBits::eA;
+    blendAttachment.blendEnable = variant.blend ? VK_TRUE : VK_FALSE;
+    blendAttachment.srcColorBlendFactor = vk::BlendFactor::eSrcAlpha;
+    blendAttachment.dstColorBlendFactor = vk::BlendFactor::eOneMinusSrcAlpha;
+    blendAttachment.colorBlendOp = vk::BlendOp::eAdd;
+    blendAttachment.srcAlphaBlendFactor = vk::BlendFactor::eOne;
+    blendAttachment.dstAlphaBlendFactor = vk::BlendFactor::eZero;
+    blendAttachment.alphaBlendOp = vk::BlendOp::eAdd;
+    vk::PipelineColorBlendStateCreateInfo colorBlending{};
+    colorBlending.attachmentCount = 1;
+    colorBlending.pAttachments = &blendAttachment;
+
+    const vk::Format colorFormat = vk::Format::eB8G8R8A8Unorm;
+    vk::PipelineRenderingCreateInfo renderingInfo{};
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachmentFormats = &colorFormat;
+    renderingInfo.depthAttachmentFormat = vk::Format::eD32Sfloat;
+
+    vk::GraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.pNext = &renderingInfo;
+    pipelineInfo.stageCount = 2;
+    pipelineInfo.pStages = stages;
+    pipelineInfo.pVertexInputState = &vertexInput;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisampling;
+    pipelineInfo.pDepthStencilState = &depthStencil;
+    pipelineInfo.pColorBlendState = &colorBlending;
+    pipelineInfo.pDynamicState = &dynamicState;
+    pipelineInfo.layout = layout;
+    return device.createGraphicsPipeline(cache, pipelineInfo).value;
+}
+
+/**
+ * @brief 用给定缓存创建全部变体，返回耗时（毫秒）
+ */
+double createAll(vk::Device device, vk::PipelineCache cache, vk::PipelineLayout layout,
+                 const asset::shaderProgram &program, uint32_t count)
+{
+    std::vector<vk::Pipeline> pipelines;
+    pipelines.reserve(count);
+    Stopwatch stopwatch;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        pipelines.push_back(createPipeline(device, cache, layout, program, makeVariant(i)));
+    }
+    const double elapsed = stopwatch.elapsedMs();
+    for (vk::Pipeline pipeline : pipelines)
+    {
+        device.destroyPipeline(pipeline);
+    }
+    return elapsed;
+}
+} // namespace
+
+void runPipelineCacheBench(const BenchOptions &options)
+{
+    vkcore::VkContext &context = headlessContext();
+    vk::Device device = context.getDevice();
+
+    // 着色器与描述符布局走与 app.cpp 相同的加载路径
+    asset::ResourceManager resourceManager(context);
+    const std::string shaderName = resourceManager.loadShader(findAssetsRoot() / "shaders/spv", "car");
+    const asset::shaderProgram program = resourceManager.getShaderprogram(shaderName);
+    std::vector<vk::DescriptorSetLayout> setLayouts;
+    for (const auto &schema : resourceManager.getShaderDescriptorSchemas("car"))
+    {
+        setLayouts.push_back(schema->getLayout());
+    }
+    vk::PipelineLayoutCreateInfo layoutInfo{};
+    layoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+    layoutInfo.pSetLayouts = setLayouts.data();
+    vk::PipelineLayout layout = device.createPipelineLayout(layoutInfo);
+
+    const uint32_t count = (std::max)(options.pipelines, 1u);
+    std::vector<double> coldMs;
+    std::vector<double> warmMs;
+    std::vector<double> cacheBytes;
+    for (uint32_t repeat = 0; repeat < (std::max)(options.repeats, 1u); ++repeat)
+    {
+        // 冷：空缓存，相当于首次启动；暖：以冷缓存导出的数据初始化，相当于从磁盘加载后的再次启动
+        vk::PipelineCache coldCache = device.createPipelineCache(vk::PipelineCacheCreateInfo{});
+        coldMs.push_back(createAll(device, coldCache, layout, program, count));
+        const std::vector<uint8_t> data = device.getPipelineCacheData(coldCache);
+        cacheBytes.push_back(static_cast<double>(data.size()));
+
+        vk::PipelineCacheCreateInfo warmInfo{};
+        warmInfo.initialDataSize = data.size();
+        warmInfo.pInitialData = data.data();
+        vk::PipelineCache warmCache = device.createPipelineCache(warmInfo);
+        warmMs.push_back(createAll(device, warmCache, layout, program, count));
+
+        device.destroyPipelineCache(coldCache);
+        device.destroyPipelineCache(warmCache);
+    }
+    device.destroyPipelineLayout(layout);
+
+    report("pipelines per pass", count, "");
+    report("cold cache", median(coldMs), "ms");
+    report("warm cache", median(warmMs), "ms");
+    report("cold per pipeline", median(coldMs) / count, "ms");
+    report("warm per pipeline", median(warmMs) / count, "ms");
+    report("cache data", median(cacheBytes) / 1024.0, "KB");
+}
+
+} // namespace bench
@@ -0,0 +1,168 @@
+#include "Bench.hpp"
+#include "ShaderReflectionCache.hpp"
+#include "Utils.hpp"
+#include <algorithm>
+#include <fstream>
+#include <spirv_reflect.h>
+#include <stdexcept>
+#include <vector>
+
+namespace bench
+{
+namespace
+{
+using Program = std::vector<std::vector<uint32_t>>;
+
+std::vector<uint32_t> readSpirv(const std::filesystem::path &file)
+{
+    std::ifstream stream(file, std::ios::binary | std::ios::ate);
+    if (!stream.is_open())
+        throw std::runtime_error("failed to open " + file.string());
+    const auto size = static_cast<size_t>(stream.tellg());
+    std::vector<uint32_t> words(size / sizeof(uint32_t));
+    stream.seekg(0);
+    stream.read(reinterpret_cast<char *>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint32_t)));
+    if (!stream || words.size() < 5)
+        throw std::runtime_error("invalid SPIR-V file " + file.string());
+    return words;
+}
+
+/**
+ * @brief 未命中时的工作：与 ResourceManager::reflectDescriptorSetLayouts 相同的逐阶段反射与合并
+ */
+asset::DescriptorSetBindings reflectProgram(const Program &program)
+{
+    constexpr vk::ShaderStageFlagBits stages[] = {vk::ShaderStageFlagBits::eVertex,
+                                                  vk::ShaderStageFlagBits::eFragment};
+    asset::DescriptorSetBindings merged;
+    for (size_t stageIndex = 0; stageIndex < program.size(); ++stageIndex)
+    {
+        const auto &spirv = program[stageIndex];
+        SpvReflectShaderModule module{};
+        if (spvReflectCreateShaderModule(spirv.size() * sizeof(uint32_t), spirv.data(), &module) !=
+            SPV_REFLECT_RESULT_SUCCESS)
+            throw std::runtime_error("Failed to create SPIR-V reflection module");
+
+        uint32_t setCount = 0;
+        spvReflectEnumerateDescriptorSets(&module, &setCount, nullptr);
+        std::vector<SpvReflectDescriptorSet *> sets(setCount);
+        spvReflectEnumerateDescriptorSets(&module, &setCount, sets.data());
+        for (const SpvReflectDescriptorSet *set : sets)
+        {
+            auto &bindings = merged[set->set];
+            for (uint32_t i = 0; i < set->binding_count; ++i)
+            {
+                const SpvReflectDescriptorBinding *rb = set->bindings[i];
+                const vk::DescriptorType type = asset::ToVkDescriptorType(rb->descriptor_type);
+                auto it = std::find_if(bindings.begin(), bindings.end(), [&](const vkcore::DescriptorBindingInfo &b) {
+                    return b.binding == rb->binding && b.descriptorType == type;
+                });
+                if (it != bindings.end())
+                {
+                    it->stageFlags |= stages[stageIndex];
+                    continue;
+                }
+                vkcore::DescriptorBindingInfo info{};
+                info.name = rb->name ? rb->name : "";
+                info.binding = rb->binding;
+                info.descriptorType = type;
+                info.descriptorCount = rb->count;
+                info.stageFlags = stages[stageIndex];
+                bindings.push_back(std::move(info));
+            }
+        }
+        spvReflectDestroyShaderModule(&module);
+    }
+    for (auto &[set, bindings] : merged)
+    {
+        std::sort(bindings.begin(), bindings.end(),
+                  [](const vkcore::DescriptorBindingInfo &a, const vkcore::DescriptorBindingInfo &b) {
+                      return a.binding < b.binding;
+                  });
+    }
+    return merged;
+}
+
+/**
+ * @brief 以 car 着色器为模板生成互不相同的程序：改写头部的生成器字，内容哈希不同而反射结果不变
+ */
+std::vector<Program> makeLibrary(uint32_t count)
+{
+    const std::filesystem::path spvRoot = findAssetsRoot() / "shaders/spv";
+    const Program base = {readSpirv(spvRoot / "car.vert.spv"), readSpirv(spvRoot / "car.frag.spv")};
+    std::vector<Program> library(count, base);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        for (auto &stage : library[i])
+            stage[2] = 0xBE000000u | i;
+    }
+    return library;
+}
+} // namespace
+
+void runReflectionCacheBench(const BenchOptions &options)
+{
+    const uint32_t count = (std::max)(options.shaders, 1u);
+    const std::vector<Program> library = makeLibrary(count);
+    const std::filesystem::path cacheDir = std::filesystem::temp_directory_path() / "qtrender_bench_reflection";
+
+    std::vector<double> hashMs;
+    std::vector<double> missMs;
+    std::vector<double> memoryHitMs;
+    std::vector<double> diskHitMs;
+    uint64_t hits = 0;
+    for (uint32_t repeat = 0; repeat < (std::max)(options.repeats, 1u); ++repeat)
+    {
+        std::filesystem::remove_all(cacheDir);
+        asset::ShaderReflectionCache cache(cacheDir);
+
+        // 每次查找都要先对全部阶段的SPIR-V求哈希，单独计时以区分哈希与查找本身
+        Stopwatch hashWatch;
+        uint64_t keySum = 0;
+        for (const Program &program : library)
+            keySum += asset::ShaderReflectionCache::computeKey(program);
+        hashMs.push_back(hashWatch.elapsedMs());
+        if (keySum == 0)
+            throw std::runtime_error("unexpected zero key sum");
+
+        // 未命中：查找失败（含磁盘探测）后反射、合并并写入缓存，即首次加载着色器库
+        Stopwatch stopwatch;
+        for (const Program &program : library)
+        {
+            const uint64_t key = asset::ShaderReflectionCache::computeKey(program);
+            if (!cache.find(key))
+                cache.store(key, reflectProgram(program));
+        }
+        missMs.push_back(stopwatch.elapsedMs());
+
+        // 内存命中：同一进程内重复加载
+        stopwatch.restart();
+        for (const Program &program : library)
+        {
+            if (!cache.find(asset::ShaderReflectionCache::computeKey(program)))
+                throw std::runtime_error("reflection cache lost an entry");
+        }
+        memoryHitMs.push_back(stopwatch.elapsedMs());
+
+        // 磁盘命中：新进程（新的缓存实例）读取上次写入的条目
+        asset::ShaderReflectionCache diskCache(cacheDir);
+        stopwatch.restart();
+        for (const Program &program : library)
+        {
+            if (!diskCache.find(asset::ShaderReflectionCache::computeKey(program)))
+                throw std::runtime_error("reflection cache entry missing on disk");
+        }
+        diskHitMs.push_back(stopwatch.elapsedMs());
+        hits = diskCache.getStats().diskHits;
+    }
+    std::filesystem::remove_all(cacheDir);
+
+    report("shader programs", count, "");
+    report("content hash (part of every lookup)", median(hashMs) * 1000.0 / count, "us/program");
+    report("miss (reflect + store)", median(missMs) * 1000.0 / count, "us/program");
+    report("memory hit", median(memoryHitMs) * 1000.0 / count, "us/program");
+    report("disk hit", median(diskHitMs) * 1000.0 / count, "us/program");
+    report("disk hits (last pass)", static_cast<double>(hits), "");
+}
+
+} // namespace bench
@@ -0,0 +1,93 @@
+#include "Bench.hpp"
+#include "TransferManager.hpp"
+#include "VkContext.hpp"
+#include "VkResource.hpp"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace bench
+{
+namespace
+{
+/// 单次上传的大小，对应每个物体的常量、实例数据等小块更新
+constexpr vk::DeviceSize kUploadSize = 256;
+
+/**
+ * @brief 每次上传独立录制与提交（每次都要取得命令缓冲），返回每秒上传次数
+ */
+double unbatchedPass(vkcore::TransferManager &transfer, const vkcore::ManagedBuffer &buffer,
+                     const std::array<uint8_t, kUploadSize> &data, uint32_t count)
+{
+    std::vector<vkcore::TransferToken> tokens;
+    tokens.reserve(count);
+    Stopwatch stopwatch;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        tokens.push_back(transfer.uploadToBuffer(buffer, data.data(), kUploadSize, i * kUploadSize));
+    }
+    for (auto &token : tokens)
+    {
+        token.wait();
+    }
+    return count / (stopwatch.elapsedMs() / 1000.0);
+}
+
+/**
+ * @brief 全部上传录制到一个UploadBatch中一次提交，返回每秒上传次数
+ */
+double batchedPass(vkcore::TransferManager &transfer, const vkcore::ManagedBuffer &buffer,
+                   const std::array<uint8_t, kUploadSize> &data, uint32_t count)
+{
+    Stopwatch stopwatch;
+    vkcore::UploadBatch batch = transfer.createUploadBatch();
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        batch.uploadToBuffer(buffer, data.data(), kUploadSize, i * kUploadSize);
+    }
+    batch.submit().wait();
+    return count / (stopwatch.elapsedMs() / 1000.0);
+}
+} // namespace
+
+void runSmallUploadBench(const BenchOptions &options)
+{
+    vkcore::VkContext &context = headlessContext();
+    vkcore::VkResourceAllocator allocator;
+    allocator.initialize(context);
+
+    // 关闭直接写入，保证每次上传都经过staging与命令缓冲
+    vkcore::TransferManagerConfig config;
+    config.enableDirectWrite = false;
+    vkcore::TransferManager transfer;
+    transfer.initialize(context, allocator, config);
+
+    const uint32_t count = (std::max)(options.uploads, 1u);
+    vkcore::BufferDesc desc{};
+    desc.size = count * kUploadSize;
+    desc.usage = vkcore::BufferUsageFlags::Uniform | vkcore::BufferUsageFlags::TransferDst;
+    desc.memory = vkcore::MemoryUsage::GpuOnly;
+    desc.debugName = "Bench Small Upload Buffer";
+    vkcore::ManagedBuffer buffer = allocator.createBuffer(desc);
+
+    std::array<uint8_t, kUploadSize> data{};
+    data.fill(0x5A);
+
+    std::vector<double> unbatched;
+    std::vector<double> batched;
+    for (uint32_t repeat = 0; repeat < (std::max)(options.repeats, 1u); ++repeat)
+    {
+        unbatched.push_back(unbatchedPass(transfer, buffer, data, count));
+        batched.push_back(batchedPass(transfer, buffer, data, count));
+    }
+
+    const vkcore::CommandBufferStats stats = transfer.getCommandBufferStats();
+    report("uploads per pass", count, "");
+    report("unbatched", median(unbatched) / 1000.0, "K uploads/s");
+    report("batched (one UploadBatch)", median(batched) / 1000.0, "K uploads/s");
+    report("command buffers allocated", static_cast<double>(stats.allocations), "");
+    report("command buffers reused", static_cast<double>(stats.reuses), "");
+    report("command buffers freed", static_cast<double>(stats.frees), "");
+}
+
+} // namespace bench
@@ -0,0 +1,161 @@
+#include "Bench.hpp"
+#include "VkContext.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+/**
+ * @brief 基准用例：名称、说明与入口
+ */
+struct BenchCase
+{
+    std::string_view name;
+    std::string_view description;
+    void (*run)(const bench::BenchOptions &options);
+};
+
+constexpr std::array kCases = {
+    BenchCase{"snapshot-map", "SnapshotMap: N readers vs M bulk loaders", bench::runSnapshotMapBench},
+    BenchCase{"pipeline-cache", "Graphics pipeline creation: cold vs warm VkPipelineCache",
+              bench::runPipelineCacheBench},
+    BenchCase{"reflection-cache", "SPIR-V reflection: spirv-reflect vs ShaderReflectionCache hits",
+              bench::runReflectionCacheBench},
+    BenchCase{"direct-write", "Buffer uploads: direct write vs staging copy", bench::runDirectWriteBench},
+    BenchCase{"small-uploads", "256-byte uploads: per-upload submit vs one UploadBatch", bench::runSmallUploadBench},
+};
+
+void printUsage()
+{
+    std::cout << "usage: bench [case...] [--readers N] [--loaders N] [--entries N] [--repeats N] [--pipelines N]\n"
+                 "             [--shaders N] [--uploads N]\n\n"
+                 "cases:\n";
+    for (const auto &benchCase : kCases)
+    {
+        std::cout << "  " << std::left << std::setw(18) << benchCase.name << benchCase.description << "\n";
+    }
+}
+} // namespace
+
+namespace bench
+{
+void report(const std::string &name, double value, const std::string &unit)
+{
+    std::cout << "  " << std::left << std::setw(36) << name << std::right << std::setw(14) << std::fixed
+              << std::setprecision(3) << value << " " << unit << "\n";
+}
+
+double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return values.empty() ? 0.0 : values[values.size() / 2];
+}
+
+std::filesystem::path findAssetsRoot()
+{
+    auto current = std::filesystem::current_path();
+    while (!current.empty())
+    {
+        if (std::filesystem::is_directory(current / "assets"))
+            return current / "assets";
+        auto parent = current.parent_path();
+        if (parent == current)
+            break;
+        current = parent;
+    }
+    throw std::runtime_error("assets directory not found above " + std::filesystem::current_path().string());
+}
+
+vkcore::VkContext &headlessContext()
+{
+    // 只尝试初始化一次：失败后后续GPU用例直接报告同一错误，不重复创建实例
+    static std::string initError;
+    static bool attempted = false;
+    auto &context = vkcore::VkContext::getInstance();
+    if (!attempted)
+    {
+        attempted = true;
+        vkcore::InstanceConfig instanceConfig;
+        instanceConfig.appName = "bench";
+        instanceConfig.enableValidation = false;
+        try
+        {
+            context.initialize(instanceConfig, vkcore::DeviceConfig{}, nullptr);
+        }
+        catch (const std::exception &e)
+        {
+            initError = e.what();
+        }
+    }
+    if (!initError.empty())
+        throw std::runtime_error("no Vulkan device: " + initError);
+    return context;
+}
+} // namespace bench
+
+int main(int argc, char **argv)
+{
+    bench::BenchOptions options;
+    std::vector<std::string_view> selected;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        auto value = [&]() -> uint32_t {
+            if (i + 1 >= argc)
+            {
+                std::cerr << "missing value for " << arg << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
+            return static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        };
+
+        if (arg == "--readers")
+            options.readers = value();
+        else if (arg == "--loaders")
+            options.loaders = value();
+        else if (arg == "--entries")
+            options.entries = value();
+        else if (arg == "--repeats")
+            options.repeats = value();
+        else if (arg == "--pipelines")
+            options.pipelines = value();
+        else if (arg == "--shaders")
+            options.shaders = value();
+        else if (arg == "--uploads")
+            options.uploads = value();
+        else if (arg == "--help" || arg == "-h")
+        {
+            printUsage();
+            return EXIT_SUCCESS;
+        }
+        else
+            selected.push_back(arg);
+    }
+
+    int failures = 0;
+    for (const auto &benchCase : kCases)
+    {
+        if (!selected.empty() && std::find(selected.begin(), selected.end(), benchCase.name) == selected.end())
+            continue;
+
+        std::cout << "[" << benchCase.name << "] " << benchCase.description << "\n";
+        try
+        {
+            benchCase.run(options);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "  failed: " << e.what() << std::endl;
+            ++failures;
+        }
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,203 @@
+#include "FileWatcher.hpp"
+#include <algorithm>
+#include <iostream>
+#include <system_error>
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace asset
+{
+namespace
+{
+std::filesystem::path normalizePath(const std::filesystem::path &path)
+{
+    return std::filesystem::absolute(path).lexically_normal();
+}
+} // namespace
+
+FileWatcher::FileWatcher(std::chrono::milliseconds pollInterval)
+    : m_pollInterval(pollInterval), m_lastScan(std::chrono::steady_clock::now())
+{
+#ifdef __linux__
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0)
+    {
+        std::cerr << "FileWatcher: inotify unavailable, falling back to polling" << std::endl;
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+    if (m_inotifyFd >= 0)
+    {
+        close(m_inotifyFd);
+    }
+#endif
+}
+
+bool FileWatcher::watchDirectory(const std::filesystem::path &directory, bool recursive)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_directory(directory, ec))
+    {
+        return false;
+    }
+
+    const auto normalized = normalizePath(directory);
+    if (isNative())
+    {
+        addNativeWatch(normalized, recursive);
+        return true;
+    }
+
+    // 轮询模式：先记录当前修改时间，之后只报告变化
+    Watch watch{normalized, recursive};
+    scanDirectory(watch, nullptr);
+    m_polledDirs.push_back(std::move(watch));
+    return true;
+}
+
+std::vector<std::filesystem::path> FileWatcher::poll()
+{
+    std::vector<std::filesystem::path> changed;
+    if (isNative())
+    {
+        readNativeEvents(changed);
+    }
+    else
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - m_lastScan < m_pollInterval)
+        {
+            return changed;
+        }
+        m_lastScan = now;
+        for (const auto &watch : m_polledDirs)
+        {
+            scanDirectory(watch, &changed);
+        }
+    }
+
+    // 编辑器保存一次可能产生多个事件，同一文件只报告一次
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+    return changed;
+}
+
+void FileWatcher::addNativeWatch(const std::filesystem::path &directory, bool recursive)
+{
+#ifdef __linux__
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | (recursive ? IN_CREATE : 0u);
+    const int wd = inotify_add_watch(m_inotifyFd, directory.c_str(), mask);
+    if (wd < 0)
+    {
+        std::cerr << "FileWatcher: failed to watch " << directory << std::endl;
+        return;
+    }
+    m_watches[wd] = Watch{directory, recursive};
+
+    if (recursive)
+    {
+        std::error_code ec;
+        for (const auto &entry : std::filesystem::directory_iterator(directory, ec))
+        {
+            if (entry.is_directory(ec))
+            {
+                addNativeWatch(entry.path(), true);
+            }
+        }
+    }
+#else
+    (void)directory;
+    (void)recursive;
+#endif
+}
+
+void FileWatcher::readNativeEvents(std::vector<std::filesystem::path> &changed)
+{
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    while (true)
+    {
+        const ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+        {
+            // EAGAIN：当前没有更多事件
+            break;
+        }
+
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const auto *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            auto it = m_watches.find(event->wd);
+            if (it == m_watches.end() || event->len == 0)
+                continue;
+
+            const auto path = it->second.directory / event->name;
+            if (event->mask & IN_ISDIR)
+            {
+                // 新建或移入的子目录同样需要监视
+                if (it->second.recursive && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+                {
+                    addNativeWatch(path, true);
+                }
+                continue;
+            }
+            if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+            {
+                changed.push_back(path);
+            }
+        }
+    }
+#else
+    (void)changed;
+#endif
+}
+
+void FileWatcher::scanDirectory(const Watch &watch, std::vector<std::filesystem::path> *changed)
+{
+    auto visit = [&](const std::filesystem::directory_entry &entry) {
+        std::error_code ec;
+        if (!entry.is_regular_file(ec))
+            return;
+        const auto writeTime = entry.last_write_time(ec);
+        if (ec)
+            return;
+
+        const auto path = entry.path().lexically_normal();
+        auto [it, inserted] = m_timestamps.try_emplace(path.string(), writeTime);
+        if (!inserted && it->second != writeTime)
+        {
+            it->second = writeTime;
+            if (changed)
+                changed->push_back(path);
+        }
+        else if (inserted && changed)
+        {
+            // 扫描期间新出现的文件
+            changed->push_back(path);
+        }
+    };
+
+    std::error_code ec;
+    if (watch.recursive)
+    {
+        for (const auto &entry : std::filesystem::recursive_directory_iterator(watch.directory, ec))
+            visit(entry);
+    }
+    else
+    {
+        for (const auto &entry : std::filesystem::directory_iterator(watch.directory, ec))
+            visit(entry);
+    }
+}
+
+} // namespace asset
@@ -0,0 +1,185 @@
+#include "HotReloadService.hpp"
+#include "MaterialManager.hpp"
+#include "ResourceManager.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+
+namespace asset
+{
+namespace
+{
+/**
+ * @brief 将着色器阶段文件（SPIR-V或GLSL源码）映射为着色器程序标识符（目录/名称）
+ * @return 程序标识符，不是着色器阶段文件时返回空字符串
+ */
+std::string shaderProgramIdFromStage(const std::string &resourceId)
+{
+    static constexpr std::array<std::string_view, 6> kStageSuffixes = {".vert.spv", ".frag.spv", ".comp.spv",
+                                                                       ".vert",     ".frag",     ".comp"};
+    for (auto suffix : kStageSuffixes)
+    {
+        if (resourceId.size() > suffix.size() &&
+            resourceId.compare(resourceId.size() - suffix.size(), suffix.size(), suffix) == 0)
+        {
+            return resourceId.substr(0, resourceId.size() - suffix.size());
+        }
+    }
+    return {};
+}
+} // namespace
+
+HotReloadService::HotReloadService(ResourceManager &resourceManager, MaterialManager &materialManager)
+    : m_resourceManager(&resourceManager), m_materialManager(&materialManager)
+{
+}
+
+bool HotReloadService::watchDirectory(const std::filesystem::path &directory)
+{
+    return m_watcher.watchDirectory(directory, true);
+}
+
+void HotReloadService::addListener(Listener listener)
+{
+    m_listeners.push_back(std::move(listener));
+}
+
+size_t HotReloadService::poll()
+{
+    size_t submitted = 0;
+    for (const auto &path : m_watcher.poll())
+    {
+        if (submitReload(path))
+        {
+            ++submitted;
+        }
+    }
+    dispatchCompleted();
+    return submitted;
+}
+
+bool HotReloadService::submitReload(const std::filesystem::path &path)
+{
+    const std::string resourceId = normalizeResourcePath(path);
+
+    auto submit = [&](ReloadKind kind, const std::string &id, auto &&makeRequest) {
+        // 同一资源已有尚未开始的请求时，它会读取到最新的文件内容，无需重复提交
+        if (isPending(kind, id))
+            return true;
+        LoadRequest request = makeRequest();
+        m_pending.push_back({kind, id, request, request.getFuture()});
+        return true;
+    };
+
+    if (m_resourceManager->getMeshHandle(resourceId))
+    {
+        return submit(ReloadKind::Mesh, resourceId,
+                      [&]() { return m_resourceManager->requestMeshReload(resourceId); });
+    }
+    if (m_resourceManager->getTextureHandle(resourceId))
+    {
+        return submit(ReloadKind::Texture, resourceId,
+                      [&]() { return m_resourceManager->requestTextureReload(resourceId); });
+    }
+    if (auto programId = shaderProgramIdFromStage(resourceId); !programId.empty())
+    {
+        // GLSL源码可能编译出多个宏定义变体，逐个重新编译；SPIR-V阶段文件对应唯一的程序
+        std::vector<std::string> programs = m_resourceManager->findShaderProgramsBySource(programId);
+        if (programs.empty() && m_resourceManager->getShaderHandle(programId))
+        {
+            programs.push_back(programId);
+        }
+        for (const auto &id : programs)
+        {
+            submit(ReloadKind::Shader, id, [&]() { return m_resourceManager->requestShaderReload(id); });
+        }
+        if (!programs.empty())
+            return true;
+    }
+    if (auto materialId = m_materialManager->findMaterialBySource(path))
+    {
+        // 材质加载在执行期间无法被新的请求取代：标记为脏，完成后追加一次重新加载，保证最新内容生效
+        auto inFlight = std::find_if(m_pending.begin(), m_pending.end(), [&](const PendingReload &pending) {
+            return pending.kind == ReloadKind::Material && pending.resourceId == *materialId &&
+                   pending.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+        });
+        if (inFlight != m_pending.end())
+        {
+            inFlight->dirtyAgain = true;
+            return true;
+        }
+        submitMaterialReload(*materialId, path);
+        return true;
+    }
+    return false;
+}
+
+void HotReloadService::submitMaterialReload(const std::string &materialId, const std::filesystem::path &source)
+{
+    // 材质加载会等待其纹理请求，不能占用加载线程池的工作线程
+    m_pending.push_back({ReloadKind::Material, materialId, LoadRequest{},
+                         m_materialManager->loadMaterialFromJsonAsync(source, LoadPriority::Visible), source});
+}
+
+bool HotReloadService::isPending(ReloadKind kind, const std::string &resourceId) const
+{
+    return std::any_of(m_pending.begin(), m_pending.end(), [&](const PendingReload &pending) {
+        if (pending.kind != kind || pending.resourceId != resourceId)
+            return false;
+        if (pending.request.isValid())
+            return pending.request.getStatus() == LoadStatus::Pending;
+        return pending.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready;
+    });
+}
+
+void HotReloadService::dispatchCompleted()
+{
+    std::vector<ReloadEvent> events;
+    std::vector<std::pair<std::string, std::filesystem::path>> followUps;
+    auto it = std::remove_if(m_pending.begin(), m_pending.end(), [&](const PendingReload &pending) {
+        if (pending.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return false;
+
+        if (pending.dirtyAgain)
+        {
+            followUps.emplace_back(pending.resourceId, pending.source);
+        }
+
+        ReloadEvent event;
+        event.kind = pending.kind;
+        event.resourceId = pending.resourceId;
+        try
+        {
+            pending.future.get();
+            event.succeeded = true;
+        }
+        catch (const std::exception &e)
+        {
+            event.error = e.what();
+        }
+        events.push_back(std::move(event));
+        return true;
+    });
+    m_pending.erase(it, m_pending.end());
+
+    // 执行期间再次保存的材质只追加一次重新加载，多次保存合并为一次
+    for (const auto &[materialId, source] : followUps)
+    {
+        submitMaterialReload(materialId, source);
+    }
+
+    for (const auto &event : events)
+    {
+        if (!event.succeeded)
+        {
+            std::cerr << "Hot reload failed for " << event.resourceId << ": " << event.error << std::endl;
+        }
+        for (const auto &listener : m_listeners)
+        {
+            listener(event);
+        }
+    }
+}
+
+} // namespace asset
@@ -0,0 +1,89 @@
+/**
+ * @file FileWatcher.hpp
+ * @author Summer
+ * @brief 目录变更监视器
+ *
+ * Linux 下使用 inotify 监听文件写入完成与重命名事件，
+ * 其他平台（或 inotify 不可用时）退化为按间隔比较文件修改时间。
+ *
+ * @version 1.0
+ * @date 2025-11-27
+ */
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace asset
+{
+
+/**
+ * @class FileWatcher
+ * @brief 非阻塞的文件变更监视器
+ *
+ * @details
+ * - 以目录为单位监视，poll() 返回自上次调用以来发生变化的文件（已去重）
+ * - 只报告写入完成（IN_CLOSE_WRITE）与移动到目录中（IN_MOVED_TO）的文件，
+ *   编辑器“写临时文件再重命名”的保存方式同样会被捕获
+ * - 非线程安全，应在同一线程中调用（通常为渲染线程每帧一次）
+ */
+class FileWatcher
+{
+  public:
+    /**
+     * @brief 创建监视器
+     * @param pollInterval 退化为轮询时两次扫描之间的最小间隔
+     */
+    explicit FileWatcher(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(500));
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher &) = delete;
+    FileWatcher &operator=(const FileWatcher &) = delete;
+
+    /**
+     * @brief 监视目录
+     * @param directory 目录路径
+     * @param recursive 是否同时监视子目录（包括之后新建的子目录）
+     * @return true 如果目录存在并开始监视
+     */
+    bool watchDirectory(const std::filesystem::path &directory, bool recursive = true);
+
+    /**
+     * @brief 取出自上次调用以来发生变化的文件（不阻塞）
+     * @return 变化文件的归一化绝对路径
+     */
+    std::vector<std::filesystem::path> poll();
+
+    /**
+     * @brief 是否使用系统原生通知（否则为轮询）
+     */
+    bool isNative() const
+    {
+        return m_inotifyFd >= 0;
+    }
+
+  private:
+    struct Watch
+    {
+        std::filesystem::path directory; ///< 被监视的目录
+        bool recursive = false;          ///< 是否监视子目录
+    };
+
+    void addNativeWatch(const std::filesystem::path &directory, bool recursive);
+    void readNativeEvents(std::vector<std::filesystem::path> &changed);
+    void scanDirectory(const Watch &watch, std::vector<std::filesystem::path> *changed);
+
+    int m_inotifyFd = -1;                     ///< inotify 描述符，-1 表示使用轮询
+    std::unordered_map<int, Watch> m_watches; ///< inotify 监视描述符 -> 目录
+    std::vector<Watch> m_polledDirs;          ///< 轮询模式下监视的目录
+
+    std::chrono::milliseconds m_pollInterval;                                     ///< 轮询间隔
+    std::chrono::steady_clock::time_point m_lastScan;                             ///< 上次轮询时间
+    std::unordered_map<std::string, std::filesystem::file_time_type> m_timestamps; ///< 轮询模式下的文件修改时间
+};
+
+} // namespace asset
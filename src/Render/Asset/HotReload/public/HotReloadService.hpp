@@ -0,0 +1,132 @@
+/**
+ * @file HotReloadService.hpp
+ * @author Summer
+ * @brief 资源热重载服务
+ *
+ * 监视资源目录，将变化的文件映射到 ResourceManager 与 MaterialManager 中已加载的资源，
+ * 在加载线程池中重新导入并原子替换，无需重启即可看到修改结果。
+ *
+ * @version 1.0
+ * @date 2025-11-27
+ */
+
+#pragma once
+
+#include "FileWatcher.hpp"
+#include "LoadRequest.hpp"
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace asset
+{
+
+class ResourceManager;
+class MaterialManager;
+
+/**
+ * @enum ReloadKind
+ * @brief 被重新加载的资源类型
+ */
+enum class ReloadKind : uint8_t
+{
+    Mesh,
+    Texture,
+    Shader,
+    Material
+};
+
+/**
+ * @struct ReloadEvent
+ * @brief 一次重新加载的结果
+ */
+struct ReloadEvent
+{
+    ReloadKind kind = ReloadKind::Mesh; ///< 资源类型
+    std::string resourceId;             ///< 资源标识符（材质为材质名称）
+    bool succeeded = false;             ///< 是否成功替换
+    std::string error;                  ///< 失败原因（成功时为空）
+};
+
+/**
+ * @class HotReloadService
+ * @brief 文件变更到资源重新加载的调度器
+ *
+ * @details
+ * - 网格/纹理按归一化路径匹配缓存中的资源
+ * - 着色器按 `<目录>/<名称>.{vert,frag,comp}.spv` 匹配着色器程序，同一程序的多个阶段合并为一次重新加载
+ * - GLSL源码 `<目录>/<名称>.{vert,frag,comp}` 匹配由其编译的所有宏定义变体
+ * - 材质按加载时使用的JSON文件匹配
+ * - 未被加载过的文件被忽略；重新加载失败时保留旧资源并通过事件报告错误
+ * - poll() 与监听器都在调用 poll() 的线程中执行，通常为渲染线程每帧一次
+ */
+class HotReloadService
+{
+  public:
+    using Listener = std::function<void(const ReloadEvent &)>;
+
+    HotReloadService(ResourceManager &resourceManager, MaterialManager &materialManager);
+
+    HotReloadService(const HotReloadService &) = delete;
+    HotReloadService &operator=(const HotReloadService &) = delete;
+
+    /**
+     * @brief 监视资源目录（包括子目录）
+     * @return true 如果目录存在并开始监视
+     */
+    bool watchDirectory(const std::filesystem::path &directory);
+
+    /**
+     * @brief 注册重新加载完成的监听器（如重建管线、更新描述符集）
+     */
+    void addListener(Listener listener);
+
+    /**
+     * @brief 处理文件变更并分发已完成的重新加载
+     * @return 本次提交的重新加载数量
+     */
+    size_t poll();
+
+    /**
+     * @brief 是否还有未完成的重新加载
+     */
+    bool hasPendingReloads() const
+    {
+        return !m_pending.empty();
+    }
+
+  private:
+    struct PendingReload
+    {
+        ReloadKind kind;
+        std::string resourceId;
+        LoadRequest request;                    ///< 调度器中的请求（材质重新加载时无效）
+        std::shared_future<std::string> future; ///< 结果
+        std::filesystem::path source;           ///< 材质的JSON文件（仅材质重新加载）
+        bool dirtyAgain = false;                ///< 执行期间文件再次变化，完成后需追加一次重新加载
+    };
+
+    /**
+     * @brief 将变化的文件映射为重新加载请求
+     * @return true 如果文件对应一个已加载的资源
+     */
+    bool submitReload(const std::filesystem::path &path);
+
+    /**
+     * @brief 提交材质的重新加载
+     */
+    void submitMaterialReload(const std::string &materialId, const std::filesystem::path &source);
+
+    bool isPending(ReloadKind kind, const std::string &resourceId) const;
+    void dispatchCompleted();
+
+    ResourceManager *m_resourceManager = nullptr;
+    MaterialManager *m_materialManager = nullptr;
+    FileWatcher m_watcher;
+    std::vector<PendingReload> m_pending; ///< 已提交、尚未分发结果的重新加载
+    std::vector<Listener> m_listeners;
+};
+
+} // namespace asset
@@ -1,8 +1,9 @@
 #include "MaterialManager.hpp"
 #include "ResourceManager.hpp"
-#include <fstream>
+#include "Trace.hpp"
 #include <iostream>
 #include <stdexcept>
+#include <thread>
 
 namespace asset
 {
@@ -12,37 +13,101 @@ MaterialManager::MaterialManager(ResourceManager &resourceManager) : m_resourceM
 
 std::string MaterialManager::loadMaterialFromJson(const std::filesystem::path &filepath)
 {
-    if (!std::filesystem::exists(filepath))
+    PendingMaterial pending = beginMaterialLoad(filepath, LoadPriority::Visible);
+    return finishMaterialLoad(pending);
+}
+
+std::shared_future<std::string> MaterialManager::loadMaterialFromJsonAsync(const std::filesystem::path &filepath,
+                                                                           LoadPriority priority)
+{
+    std::packaged_task<std::string()> task([this, filepath, priority]() {
+        PendingMaterial pending = beginMaterialLoad(filepath, priority);
+        return finishMaterialLoad(pending);
+    });
+
+    auto sfut = task.get_future().share();
+    std::thread(std::move(task)).detach();
+    return sfut;
+}
+
+std::shared_future<std::vector<std::string>> MaterialManager::loadMaterialsFromJsonAsync(
+    const std::vector<std::filesystem::path> &filepaths, LoadPriority priority)
+{
+    std::packaged_task<std::vector<std::string>()> task(
+        [this, paths = std::vector<std::filesystem::path>(filepaths), priority]() {
+            // 先提交全部材质的纹理请求，再逐个等待，使所有纹理在加载线程池中并发解码
+            std::vector<PendingMaterial> pendings;
+            pendings.reserve(paths.size());
+            for (const auto &p : paths)
+            {
+                pendings.push_back(beginMaterialLoad(p, priority));
+            }
+
+            std::vector<std::string> ids;
+            ids.reserve(pendings.size());
+            for (auto &pending : pendings)
+            {
+                ids.push_back(finishMaterialLoad(pending));
+            }
+            return ids;
+        });
+
+    auto sfut = task.get_future().share();
+    std::thread(std::move(task)).detach();
+    return sfut;
+}
+
+MaterialManager::PendingMaterial MaterialManager::beginMaterialLoad(const std::filesystem::path &filepath,
+                                                                    LoadPriority priority)
+{
+    TRACE_SCOPE_NAMED(traceZone, "MaterialManager::beginMaterialLoad");
+    TRACE_SET_DETAIL(traceZone, filepath.string());
+    VirtualFileSystem &fileSystem = m_resourceManager->getFileSystem();
+    if (!fileSystem.exists(filepath))
     {
         throw std::runtime_error("Material json file does not exist: " + filepath.string());
     }
 
-    std::ifstream file(filepath);
-    if (!file.is_open())
+    const FileBlob file = fileSystem.readFile(filepath);
+    const std::string_view text = file.asString();
+    nlohmann::json materialJson = nlohmann::json::parse(text.begin(), text.end());
+
+    return parseMaterialJson(filepath, materialJson, priority);
+}
+
+std::string MaterialManager::finishMaterialLoad(PendingMaterial &pending)
+{
+    TRACE_SCOPE_NAMED(traceZone, "MaterialManager::waitTextures");
+    TRACE_SET_DETAIL(traceZone, pending.source.string());
+    for (auto &[slot, request] : pending.textures)
     {
-        throw std::runtime_error("Failed to open material json file: " + filepath.string());
+        pending.material.textures.*slot = request.getFuture().get();
     }
 
-    nlohmann::json materialJson;
-    file >> materialJson;
-
-    PBRMaterial material = parseMaterialJson(filepath, materialJson);
-    const std::string materialId = material.name.empty() ? filepath.stem().string() : material.name;
+    PBRMaterial &material = pending.material;
+    const std::string materialId = material.name.empty() ? pending.source.stem().string() : material.name;
 
     {
         std::lock_guard<std::mutex> lock(m_mutex);
-        auto iter = m_materials.find(materialId);
-        if (iter != m_materials.end())
-        {
-            *(iter->second) = std::move(material);
-            return materialId;
-        }
-        m_materials.emplace(materialId, std::make_shared<PBRMaterial>(std::move(material)));
+        // 替换指针而不是原地修改，其他线程读取到的始终是完整的材质
+        m_materials[materialId] = std::make_shared<PBRMaterial>(std::move(material));
+        m_materialSources[normalizeResourcePath(pending.source)] = materialId;
     }
 
     return materialId;
 }
 
+std::optional<std::string> MaterialManager::findMaterialBySource(const std::filesystem::path &filepath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto iter = m_materialSources.find(normalizeResourcePath(filepath));
+    if (iter != m_materialSources.end())
+    {
+        return iter->second;
+    }
+    return std::nullopt;
+}
+
 std::shared_ptr<PBRMaterial> MaterialManager::getMaterial(const std::string &name)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -58,17 +123,21 @@ void MaterialManager::clear()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
     m_materials.clear();
+    m_materialSources.clear();
 }
 
-PBRMaterial MaterialManager::parseMaterialJson(const std::filesystem::path &filepath,
-                                               const nlohmann::json &materialJson)
+MaterialManager::PendingMaterial MaterialManager::parseMaterialJson(const std::filesystem::path &filepath,
+                                                                    const nlohmann::json &materialJson,
+                                                                    LoadPriority priority)
 {
     if (!m_resourceManager)
     {
         throw std::runtime_error("MaterialManager requires a valid ResourceManager");
     }
 
-    PBRMaterial material;
+    PendingMaterial pending;
+    pending.source = filepath;
+    PBRMaterial &material = pending.material;
     const auto baseDir = filepath.parent_path();
 
     material.name = materialJson.value("name", filepath.stem().string());
@@ -78,23 +147,24 @@ PBRMaterial MaterialManager::parseMaterialJson(const std::filesystem::path &file
     if (materialJson.contains("textures"))
     {
         const auto &textures = materialJson.at("textures");
-        auto loadIfPresent = [&](const char *key, std::string &target) {
+        // 只提交请求不等待，各纹理在加载线程池中并发解码
+        auto requestIfPresent = [&](const char *key, std::string PBRMaterial::TextureIds::*slot) {
             if (textures.contains(key))
             {
                 auto texName = textures.at(key).get<std::string>();
                 if (!texName.empty())
                 {
                     auto texPath = baseDir / texName;
-                    target = m_resourceManager->loadTexture(texPath);
+                    pending.textures.emplace_back(slot, m_resourceManager->requestTextureLoad(texPath, priority));
                 }
             }
         };
-        loadIfPresent("baseColor", material.textures.baseColor);
-        loadIfPresent("metallic", material.textures.metallic);
-        loadIfPresent("roughness", material.textures.roughness);
-        loadIfPresent("normal", material.textures.normal);
-        loadIfPresent("occlusion", material.textures.occlusion);
-        loadIfPresent("emissive", material.textures.emissive);
+        requestIfPresent("baseColor", &PBRMaterial::TextureIds::baseColor);
+        requestIfPresent("metallic", &PBRMaterial::TextureIds::metallic);
+        requestIfPresent("roughness", &PBRMaterial::TextureIds::roughness);
+        requestIfPresent("normal", &PBRMaterial::TextureIds::normal);
+        requestIfPresent("occlusion", &PBRMaterial::TextureIds::occlusion);
+        requestIfPresent("emissive", &PBRMaterial::TextureIds::emissive);
     }
 
     // Factors
@@ -132,7 +202,7 @@ PBRMaterial MaterialManager::parseMaterialJson(const std::filesystem::path &file
         material.optical.refractionIndex = optical.value("refractionIndex", material.optical.refractionIndex);
     }
 
-    return material;
+    return pending;
 }
 
 glm::vec4 MaterialManager::parseVec4(const nlohmann::json &j, const glm::vec4 &defaultValue)
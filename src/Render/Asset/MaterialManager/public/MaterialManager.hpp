@@ -1,12 +1,17 @@
 #pragma once
 
+#include "LoadRequest.hpp"
 #include "Material.hpp"
 #include "ResourceType.hpp"
 #include <filesystem>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <nlohmann/json.hpp>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace asset
 {
@@ -26,9 +31,40 @@ class MaterialManager
      * @brief 从JSON文件加载PBR材质
      * @param filepath 材质描述文件路径
      * @return 材质名称（作为ID）
+     *
+     * @note 材质引用的纹理并发加载，全部完成后才返回
+     * @note 同名材质已存在时整体替换为新对象，已持有旧指针的调用者不受影响，
+     *       重新调用 getMaterial() 即可获得新材质（用于热重载）
      */
     std::string loadMaterialFromJson(const std::filesystem::path &filepath);
 
+    /**
+     * @brief 异步从JSON文件加载PBR材质
+     * @param filepath 材质描述文件路径
+     * @param priority 材质纹理的加载优先级
+     * @return std::shared_future<std::string> 异步任务，所有纹理就绪后返回材质名称
+     */
+    std::shared_future<std::string> loadMaterialFromJsonAsync(const std::filesystem::path &filepath,
+                                                              LoadPriority priority = LoadPriority::Normal);
+
+    /**
+     * @brief 异步批量加载PBR材质
+     * @param filepaths 材质描述文件路径列表
+     * @param priority 材质纹理的加载优先级
+     * @return std::shared_future<std::vector<std::string>> 异步任务，返回与输入顺序一致的材质名称列表
+     *
+     * @note 先解析全部JSON并一次性提交所有材质的纹理请求，共享的纹理只加载一次
+     */
+    std::shared_future<std::vector<std::string>> loadMaterialsFromJsonAsync(
+        const std::vector<std::filesystem::path> &filepaths, LoadPriority priority = LoadPriority::Normal);
+
+    /**
+     * @brief 查找由指定JSON文件加载的材质
+     * @param filepath 材质描述文件路径
+     * @return 材质名称，该文件未被加载过时返回 std::nullopt
+     */
+    std::optional<std::string> findMaterialBySource(const std::filesystem::path &filepath);
+
     /**
      * @brief 获取材质
      * @param name 材质名称
@@ -46,11 +82,34 @@ class MaterialManager
     static glm::vec3 parseVec3(const nlohmann::json &j, const glm::vec3 &defaultValue);
     static AlphaMode parseAlphaMode(const std::string &modeStr);
 
-    PBRMaterial parseMaterialJson(const std::filesystem::path &filepath, const nlohmann::json &materialJson);
+    /**
+     * @brief 已解析、纹理仍在加载中的材质
+     */
+    struct PendingMaterial
+    {
+        std::filesystem::path source; ///< 材质描述文件路径
+        PBRMaterial material;         ///< 除纹理ID外已解析完成的材质
+        std::vector<std::pair<std::string PBRMaterial::TextureIds::*, LoadRequest>> textures; ///< 纹理槽 -> 加载请求
+    };
+
+    /**
+     * @brief 读取并解析JSON，同时提交材质引用的全部纹理加载请求（不等待）
+     */
+    PendingMaterial beginMaterialLoad(const std::filesystem::path &filepath, LoadPriority priority);
+
+    /**
+     * @brief 等待纹理加载完成，填入纹理ID并发布材质
+     * @return 材质名称
+     */
+    std::string finishMaterialLoad(PendingMaterial &pending);
+
+    PendingMaterial parseMaterialJson(const std::filesystem::path &filepath, const nlohmann::json &materialJson,
+                                      LoadPriority priority);
 
   private:
     ResourceManager *m_resourceManager{nullptr};
     std::unordered_map<std::string, std::shared_ptr<PBRMaterial>> m_materials;
+    std::unordered_map<std::string, std::string> m_materialSources; ///< 归一化的JSON路径 -> 材质名称
     std::mutex m_mutex;
 };
 
@@ -0,0 +1,417 @@
+#include "AssetPackage.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#ifdef ENABLE_LZ4_PACKAGES
+#include <lz4.h>
+#endif
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace asset
+{
+namespace
+{
+constexpr uint64_t kEntryAlignment = 4096;
+
+uint64_t alignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::vector<uint8_t> readWholeFile(const std::filesystem::path &file)
+{
+    std::ifstream stream(file, std::ios::binary | std::ios::ate);
+    if (!stream.is_open())
+    {
+        throw std::runtime_error("Failed to open file for packaging: " + file.string());
+    }
+    const std::streamoff size = stream.tellg();
+    if (size < 0)
+    {
+        throw std::runtime_error("Failed to query file size for packaging: " + file.string());
+    }
+    std::vector<uint8_t> bytes(static_cast<size_t>(size));
+    stream.seekg(0);
+    stream.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!stream || stream.gcount() != static_cast<std::streamsize>(bytes.size()))
+    {
+        throw std::runtime_error("Failed to read file for packaging: " + file.string());
+    }
+    return bytes;
+}
+
+/**
+ * @brief 尝试压缩条目
+ * @return 压缩后的数据，压缩不可用或没有收益时返回空
+ */
+std::vector<uint8_t> tryCompress(const std::vector<uint8_t> &bytes)
+{
+#ifdef ENABLE_LZ4_PACKAGES
+    if (bytes.empty() || bytes.size() > static_cast<size_t>(LZ4_MAX_INPUT_SIZE))
+    {
+        return {};
+    }
+    std::vector<uint8_t> compressed(static_cast<size_t>(LZ4_compressBound(static_cast<int>(bytes.size()))));
+    const int written =
+        LZ4_compress_default(reinterpret_cast<const char *>(bytes.data()), reinterpret_cast<char *>(compressed.data()),
+                             static_cast<int>(bytes.size()), static_cast<int>(compressed.size()));
+    if (written <= 0 || static_cast<size_t>(written) >= bytes.size())
+    {
+        return {};
+    }
+    compressed.resize(static_cast<size_t>(written));
+    return compressed;
+#else
+    (void)bytes;
+    return {};
+#endif
+}
+
+void writePadding(std::ofstream &stream, uint64_t alignment)
+{
+    const auto position = static_cast<uint64_t>(stream.tellp());
+    const uint64_t padding = alignUp(position, alignment) - position;
+    static const char zeros[kEntryAlignment] = {};
+    stream.write(zeros, static_cast<std::streamsize>(padding));
+}
+} // namespace
+
+// ============================================================================
+// AssetPackageBuilder
+// ============================================================================
+
+void AssetPackageBuilder::addFile(const std::string &packagePath, const std::filesystem::path &sourceFile,
+                                  bool compress)
+{
+    m_sources.push_back({std::filesystem::path(packagePath).lexically_normal().generic_string(), sourceFile, compress});
+}
+
+size_t AssetPackageBuilder::addDirectory(const std::filesystem::path &directory, bool compress)
+{
+    size_t added = 0;
+    for (const auto &entry : std::filesystem::recursive_directory_iterator(directory))
+    {
+        if (!entry.is_regular_file())
+            continue;
+        addFile(std::filesystem::relative(entry.path(), directory).generic_string(), entry.path(), compress);
+        ++added;
+    }
+    return added;
+}
+
+void AssetPackageBuilder::write(const std::filesystem::path &outputFile) const
+{
+    // 目录表按路径哈希排序，读取时二分查找
+    std::vector<const Source *> sorted;
+    sorted.reserve(m_sources.size());
+    for (const auto &source : m_sources)
+    {
+        sorted.push_back(&source);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Source *a, const Source *b) {
+        const uint64_t ha = fnv1a64(a->packagePath);
+        const uint64_t hb = fnv1a64(b->packagePath);
+        return ha != hb ? ha < hb : a->packagePath < b->packagePath;
+    });
+    auto duplicate = std::adjacent_find(sorted.begin(), sorted.end(), [](const Source *a, const Source *b) {
+        return a->packagePath == b->packagePath;
+    });
+    if (duplicate != sorted.end())
+    {
+        throw std::runtime_error("Duplicate package path: " + (*duplicate)->packagePath);
+    }
+
+    std::ofstream stream(outputFile, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open())
+    {
+        throw std::runtime_error("Failed to create package: " + outputFile.string());
+    }
+
+    PackageHeader header;
+    header.entryCount = static_cast<uint32_t>(sorted.size());
+    header.alignment = static_cast<uint32_t>(kEntryAlignment);
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    std::vector<PackageEntry> entries;
+    entries.reserve(sorted.size());
+    std::string strings;
+    for (const Source *source : sorted)
+    {
+        std::vector<uint8_t> bytes = readWholeFile(source->file);
+
+        PackageEntry entry;
+        entry.pathHash = fnv1a64(source->packagePath);
+        entry.size = bytes.size();
+        entry.pathOffset = static_cast<uint32_t>(strings.size());
+        entry.pathLength = static_cast<uint32_t>(source->packagePath.size());
+        strings += source->packagePath;
+
+        if (source->compress)
+        {
+            std::vector<uint8_t> compressed = tryCompress(bytes);
+            if (!compressed.empty())
+            {
+                bytes = std::move(compressed);
+                entry.compression = PackageCompression::LZ4;
+            }
+        }
+        entry.storedSize = bytes.size();
+
+        writePadding(stream, kEntryAlignment);
+        entry.offset = static_cast<uint64_t>(stream.tellp());
+        stream.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        entries.push_back(entry);
+    }
+
+    writePadding(stream, alignof(PackageEntry));
+    header.tocOffset = static_cast<uint64_t>(stream.tellp());
+    stream.write(reinterpret_cast<const char *>(entries.data()),
+                 static_cast<std::streamsize>(entries.size() * sizeof(PackageEntry)));
+    header.stringTableOffset = static_cast<uint64_t>(stream.tellp());
+    header.stringTableSize = strings.size();
+    stream.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+    stream.seekp(0);
+    stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    if (!stream)
+    {
+        throw std::runtime_error("Failed to write package: " + outputFile.string());
+    }
+}
+
+// ============================================================================
+// AssetPackage
+// ============================================================================
+
+AssetPackage::AssetPackage(const std::filesystem::path &packageFile) : m_filePath(packageFile)
+{
+    map(packageFile);
+    try
+    {
+        validate();
+    }
+    catch (...)
+    {
+        unmap();
+        throw;
+    }
+}
+
+AssetPackage::~AssetPackage()
+{
+    unmap();
+}
+
+void AssetPackage::map(const std::filesystem::path &packageFile)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileW(packageFile.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw std::runtime_error("Failed to open package: " + packageFile.string());
+    }
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        throw std::runtime_error("Invalid package size: " + packageFile.string());
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+    {
+        throw std::runtime_error("Failed to map package: " + packageFile.string());
+    }
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        throw std::runtime_error("Failed to map package: " + packageFile.string());
+    }
+    m_mappingHandle = mapping;
+    m_data = static_cast<const uint8_t *>(view);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = open(packageFile.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::runtime_error("Failed to open package: " + packageFile.string());
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        close(fd);
+        throw std::runtime_error("Invalid package size: " + packageFile.string());
+    }
+    void *view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // 映射建立后即可关闭描述符
+    close(fd);
+    if (view == MAP_FAILED)
+    {
+        throw std::runtime_error("Failed to map package: " + packageFile.string());
+    }
+    m_data = static_cast<const uint8_t *>(view);
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+}
+
+void AssetPackage::unmap()
+{
+    if (!m_data)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    m_mappingHandle = nullptr;
+#else
+    munmap(const_cast<uint8_t *>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+}
+
+void AssetPackage::validate()
+{
+    const std::string name = m_filePath.string();
+    if (m_size < sizeof(PackageHeader))
+    {
+        throw std::runtime_error("Package is truncated: " + name);
+    }
+    std::memcpy(&m_header, m_data, sizeof(PackageHeader));
+    if (m_header.magic != PackageHeader::kMagic || m_header.version != PackageHeader::kVersion)
+    {
+        throw std::runtime_error("Not a supported asset package: " + name);
+    }
+
+    // 以减法比较范围，避免被篡改的偏移相加溢出后绕过检查
+    const uint64_t tocSize = static_cast<uint64_t>(m_header.entryCount) * sizeof(PackageEntry);
+    if (m_header.tocOffset % alignof(PackageEntry) != 0 || m_header.tocOffset > m_size ||
+        tocSize > m_size - m_header.tocOffset || m_header.stringTableOffset > m_size ||
+        m_header.stringTableSize > m_size - m_header.stringTableOffset)
+    {
+        throw std::runtime_error("Package table of contents is out of range: " + name);
+    }
+    m_entries = reinterpret_cast<const PackageEntry *>(m_data + m_header.tocOffset);
+    m_strings = reinterpret_cast<const char *>(m_data + m_header.stringTableOffset);
+
+    uint64_t previousHash = 0;
+    for (const PackageEntry &entry : getEntries())
+    {
+        if (entry.offset > m_size || entry.storedSize > m_size - entry.offset ||
+            static_cast<uint64_t>(entry.pathOffset) + entry.pathLength > m_header.stringTableSize)
+        {
+            throw std::runtime_error("Package entry is out of range: " + name);
+        }
+        // view直接返回映射的size字节，未压缩条目的原始大小必须等于存储大小
+        if ((entry.compression == PackageCompression::None && entry.size != entry.storedSize) ||
+            (entry.compression != PackageCompression::None && entry.compression != PackageCompression::LZ4))
+        {
+            throw std::runtime_error("Package entry has an invalid size or compression: " + name);
+        }
+        // find按哈希二分查找，目录表必须按哈希排序且哈希与路径一致
+        if (entry.pathHash < previousHash)
+        {
+            throw std::runtime_error("Package table of contents is not sorted by path hash: " + name);
+        }
+        if (entry.pathHash != fnv1a64(getPath(entry)))
+        {
+            throw std::runtime_error("Package entry path hash does not match its path: " + name);
+        }
+        previousHash = entry.pathHash;
+        // 记录所有上级目录，使目录存在性检查也无需访问磁盘
+        const std::string_view path = getPath(entry);
+        for (size_t slash = path.find('/'); slash != std::string_view::npos; slash = path.find('/', slash + 1))
+        {
+            m_directories.emplace(path.substr(0, slash));
+        }
+    }
+}
+
+const PackageEntry *AssetPackage::find(std::string_view packagePath) const
+{
+    const uint64_t hash = fnv1a64(packagePath);
+    const auto entries = getEntries();
+    auto it = std::lower_bound(entries.begin(), entries.end(), hash,
+                               [](const PackageEntry &entry, uint64_t value) { return entry.pathHash < value; });
+    for (; it != entries.end() && it->pathHash == hash; ++it)
+    {
+        if (getPath(*it) == packagePath)
+        {
+            return &*it;
+        }
+    }
+    return nullptr;
+}
+
+bool AssetPackage::containsDirectory(std::string_view packagePath) const
+{
+    return packagePath.empty() || m_directories.contains(std::string(packagePath));
+}
+
+std::optional<std::span<const uint8_t>> AssetPackage::view(const PackageEntry &entry) const
+{
+    if (entry.compression != PackageCompression::None)
+    {
+        return std::nullopt;
+    }
+    return std::span<const uint8_t>(m_data + entry.offset, static_cast<size_t>(entry.size));
+}
+
+std::vector<uint8_t> AssetPackage::read(const PackageEntry &entry) const
+{
+    const uint8_t *stored = m_data + entry.offset;
+    switch (entry.compression)
+    {
+    case PackageCompression::None:
+        return std::vector<uint8_t>(stored, stored + entry.size);
+    case PackageCompression::LZ4: {
+#ifdef ENABLE_LZ4_PACKAGES
+        TRACE_SCOPE_NAMED(traceZone, "AssetPackage::decompress");
+        TRACE_SET_BYTES(traceZone, entry.size);
+        if (entry.size > static_cast<uint64_t>(std::numeric_limits<int>::max()))
+        {
+            throw std::runtime_error("Compressed package entry is too large: " + std::string(getPath(entry)));
+        }
+        std::vector<uint8_t> bytes(static_cast<size_t>(entry.size));
+        const int decoded =
+            LZ4_decompress_safe(reinterpret_cast<const char *>(stored), reinterpret_cast<char *>(bytes.data()),
+                                static_cast<int>(entry.storedSize), static_cast<int>(bytes.size()));
+        if (decoded < 0 || static_cast<uint64_t>(decoded) != entry.size)
+        {
+            throw std::runtime_error("Failed to decompress package entry: " + std::string(getPath(entry)));
+        }
+        return bytes;
+#else
+        throw std::runtime_error("Package entry is LZ4 compressed but LZ4 support is disabled: " +
+                                 std::string(getPath(entry)));
+#endif
+    }
+    }
+    throw std::runtime_error("Unknown package compression: " + std::string(getPath(entry)));
+}
+
+std::string_view AssetPackage::getPath(const PackageEntry &entry) const
+{
+    return {m_strings + entry.pathOffset, entry.pathLength};
+}
+
+} // namespace asset
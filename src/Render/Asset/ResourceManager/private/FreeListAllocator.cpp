@@ -0,0 +1,129 @@
+#include "FreeListAllocator.hpp"
+#include <stdexcept>
+
+namespace asset
+{
+
+FreeListAllocator::FreeListAllocator(uint64_t capacity) : m_capacity(capacity)
+{
+    reset();
+}
+
+std::optional<uint64_t> FreeListAllocator::allocate(uint64_t size, uint64_t alignment)
+{
+    if (size == 0 || alignment == 0)
+    {
+        throw std::runtime_error("FreeListAllocator: size and alignment must be non-zero");
+    }
+
+    // 从能容纳 size 的最小空闲块开始尝试；对齐填充可能使较小的块放不下，继续向更大的块查找
+    for (auto it = m_freeBySize.lower_bound(size); it != m_freeBySize.end(); ++it)
+    {
+        const uint64_t blockSize = it->first;
+        const uint64_t blockOffset = it->second;
+        const uint64_t alignedOffset = (blockOffset + alignment - 1) / alignment * alignment;
+        const uint64_t padding = alignedOffset - blockOffset;
+        if (padding + size > blockSize)
+            continue;
+
+        eraseFreeBlock(m_freeByOffset.find(blockOffset));
+
+        // 对齐填充计入占用块，剩余部分放回空闲链表
+        const uint64_t used = padding + size;
+        if (blockSize > used)
+        {
+            insertFreeBlock(blockOffset + used, blockSize - used);
+        }
+        m_allocated.emplace(alignedOffset, Block{blockOffset, used});
+        m_used += used;
+        return alignedOffset;
+    }
+    return std::nullopt;
+}
+
+bool FreeListAllocator::free(uint64_t offset)
+{
+    auto allocIt = m_allocated.find(offset);
+    if (allocIt == m_allocated.end())
+        return false;
+
+    uint64_t blockOffset = allocIt->second.offset;
+    uint64_t blockSize = allocIt->second.size;
+    m_used -= blockSize;
+    m_allocated.erase(allocIt);
+
+    // 与后一个空闲块合并
+    auto next = m_freeByOffset.lower_bound(blockOffset);
+    if (next != m_freeByOffset.end() && blockOffset + blockSize == next->first)
+    {
+        blockSize += next->second;
+        next = std::next(next);
+        eraseFreeBlock(std::prev(next));
+    }
+
+    // 与前一个空闲块合并
+    if (next != m_freeByOffset.begin())
+    {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == blockOffset)
+        {
+            blockOffset = prev->first;
+            blockSize += prev->second;
+            eraseFreeBlock(prev);
+        }
+    }
+
+    insertFreeBlock(blockOffset, blockSize);
+    return true;
+}
+
+void FreeListAllocator::reset()
+{
+    m_freeByOffset.clear();
+    m_freeBySize.clear();
+    m_allocated.clear();
+    m_used = 0;
+    if (m_capacity > 0)
+    {
+        insertFreeBlock(0, m_capacity);
+    }
+}
+
+FreeListStats FreeListAllocator::getStats() const
+{
+    FreeListStats stats;
+    stats.capacity = m_capacity;
+    stats.used = m_used;
+    stats.allocationCount = m_allocated.size();
+    stats.freeBlockCount = m_freeByOffset.size();
+    stats.largestFreeBlock = m_freeBySize.empty() ? 0 : m_freeBySize.rbegin()->first;
+
+    const uint64_t freeTotal = m_capacity - m_used;
+    if (freeTotal > 0)
+    {
+        stats.fragmentation = 1.0f - static_cast<float>(stats.largestFreeBlock) / static_cast<float>(freeTotal);
+    }
+    return stats;
+}
+
+void FreeListAllocator::insertFreeBlock(uint64_t offset, uint64_t size)
+{
+    m_freeByOffset.emplace(offset, size);
+    m_freeBySize.emplace(size, offset);
+}
+
+void FreeListAllocator::eraseFreeBlock(OffsetMap::iterator it)
+{
+    auto [first, last] = m_freeBySize.equal_range(it->second);
+    for (auto sizeIt = first; sizeIt != last; ++sizeIt)
+    {
+        if (sizeIt->second == it->first)
+        {
+            m_freeBySize.erase(sizeIt);
+            break;
+        }
+    }
+    m_freeByOffset.erase(it);
+}
+
+} // namespace asset
@@ -0,0 +1,201 @@
+#include "GeometryPool.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace asset
+{
+
+GpuMesh::~GpuMesh()
+{
+    if (pool)
+    {
+        pool->free(poolRange);
+    }
+}
+
+GeometryPool::GeometryPool(vkcore::VkResourceAllocator &allocator, vkcore::TransferManager &transferManager,
+                           const GeometryPoolConfig &config)
+    : m_allocator(&allocator), m_transferManager(&transferManager), m_maxDrawCommands(config.maxDrawCommands),
+      m_framesInFlight(config.framesInFlight), m_multiDrawIndirect(config.multiDrawIndirect),
+      m_vertexRanges(config.vertexCapacity), m_indexRanges(config.indexCapacity)
+{
+    if (config.vertexCapacity == 0 || config.indexCapacity == 0)
+    {
+        throw std::runtime_error("GeometryPool: capacity must be non-zero");
+    }
+    if (config.maxDrawCommands == 0 || config.framesInFlight == 0)
+    {
+        throw std::runtime_error("GeometryPool: indirect buffer capacity must be non-zero");
+    }
+
+    vkcore::BufferDesc vertexDesc{};
+    vertexDesc.size = static_cast<vk::DeviceSize>(config.vertexCapacity) * sizeof(Vertex);
+    vertexDesc.usage = vkcore::BufferUsageFlags::Vertex | vkcore::BufferUsageFlags::TransferDst;
+    vertexDesc.memory = vkcore::MemoryUsage::GpuOnly;
+    vertexDesc.debugName = "GeometryPool Vertex Buffer";
+    vertexDesc.allowDirectWrite = true;
+    m_vertexBuffer = allocator.createBuffer(vertexDesc);
+
+    vkcore::BufferDesc indexDesc{};
+    indexDesc.size = static_cast<vk::DeviceSize>(config.indexCapacity) * sizeof(uint32_t);
+    indexDesc.usage = vkcore::BufferUsageFlags::Index | vkcore::BufferUsageFlags::TransferDst;
+    indexDesc.memory = vkcore::MemoryUsage::GpuOnly;
+    indexDesc.debugName = "GeometryPool Index Buffer";
+    indexDesc.allowDirectWrite = true;
+    m_indexBuffer = allocator.createBuffer(indexDesc);
+
+    // 间接命令每帧由CPU重写，放在主机可见内存中并持久映射
+    vkcore::BufferDesc indirectDesc{};
+    indirectDesc.size = static_cast<vk::DeviceSize>(config.framesInFlight) * config.maxDrawCommands *
+                        sizeof(vk::DrawIndexedIndirectCommand);
+    indirectDesc.usage = vkcore::BufferUsageFlags::Indirect;
+    indirectDesc.memory = vkcore::MemoryUsage::CpuToGpu;
+    indirectDesc.debugName = "GeometryPool Indirect Buffer";
+    m_indirectBuffer = allocator.createBuffer(indirectDesc);
+    void *mapped = nullptr;
+    if (vmaMapMemory(allocator.getAllocator(), m_indirectBuffer.getAllocation(), &mapped) != VK_SUCCESS)
+    {
+        throw std::runtime_error("GeometryPool: failed to map indirect buffer");
+    }
+    m_indirectMapped = static_cast<uint8_t *>(mapped);
+}
+
+GeometryPool::~GeometryPool()
+{
+    if (m_indirectMapped)
+    {
+        vmaUnmapMemory(m_allocator->getAllocator(), m_indirectBuffer.getAllocation());
+    }
+}
+
+std::optional<GeometryRange> GeometryPool::allocate(uint32_t vertexCount, uint32_t indexCount)
+{
+    if (vertexCount == 0)
+        return std::nullopt;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto vertexOffset = m_vertexRanges.allocate(vertexCount);
+    if (!vertexOffset)
+        return std::nullopt;
+
+    GeometryRange range;
+    range.vertexOffset = static_cast<uint32_t>(*vertexOffset);
+    range.vertexCount = vertexCount;
+    if (indexCount > 0)
+    {
+        auto firstIndex = m_indexRanges.allocate(indexCount);
+        if (!firstIndex)
+        {
+            m_vertexRanges.free(*vertexOffset);
+            return std::nullopt;
+        }
+        range.firstIndex = static_cast<uint32_t>(*firstIndex);
+        range.indexCount = indexCount;
+    }
+    return range;
+}
+
+void GeometryPool::free(const GeometryRange &range)
+{
+    if (!range.isValid())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_vertexRanges.free(range.vertexOffset);
+    if (range.indexCount > 0)
+    {
+        m_indexRanges.free(range.firstIndex);
+    }
+}
+
+std::vector<vkcore::TransferToken> GeometryPool::upload(const GeometryRange &range,
+                                                        const std::vector<Vertex> &vertices,
+                                                        const std::vector<uint32_t> &indices)
+{
+    vkcore::UploadBatch batch = m_transferManager->createUploadBatch();
+    upload(range, vertices, indices, batch);
+    return {batch.submit()};
+}
+
+void GeometryPool::upload(const GeometryRange &range, const std::vector<Vertex> &vertices,
+                          const std::vector<uint32_t> &indices, vkcore::UploadBatch &batch)
+{
+    if (vertices.size() > range.vertexCount || indices.size() > range.indexCount)
+    {
+        throw std::runtime_error("GeometryPool: upload exceeds allocated range");
+    }
+
+    if (!vertices.empty())
+    {
+        batch.uploadToBuffer(m_vertexBuffer, vertices,
+                             static_cast<vk::DeviceSize>(range.vertexOffset) * sizeof(Vertex));
+    }
+    if (!indices.empty())
+    {
+        batch.uploadToBuffer(m_indexBuffer, indices, static_cast<vk::DeviceSize>(range.firstIndex) * sizeof(uint32_t));
+    }
+}
+
+void GeometryPool::bind(vk::CommandBuffer commandBuffer) const
+{
+    vk::Buffer vertexBuffer = m_vertexBuffer.getBuffer();
+    vk::DeviceSize offset = 0;
+    commandBuffer.bindVertexBuffers(0, 1, &vertexBuffer, &offset);
+    commandBuffer.bindIndexBuffer(m_indexBuffer.getBuffer(), 0, vk::IndexType::eUint32);
+}
+
+vk::DrawIndexedIndirectCommand GeometryPool::makeDrawCommand(const GpuSubmesh &submesh, uint32_t instanceCount,
+                                                             uint32_t firstInstance)
+{
+    vk::DrawIndexedIndirectCommand command{};
+    command.indexCount = submesh.indexCount;
+    command.instanceCount = instanceCount;
+    command.firstIndex = submesh.firstIndex;
+    command.vertexOffset = submesh.vertexOffset;
+    command.firstInstance = firstInstance;
+    return command;
+}
+
+void GeometryPool::drawIndexedIndirect(vk::CommandBuffer commandBuffer, uint32_t frameIndex,
+                                       const std::vector<vk::DrawIndexedIndirectCommand> &commands)
+{
+    if (commands.empty())
+        return;
+    if (frameIndex >= m_framesInFlight)
+    {
+        throw std::runtime_error("GeometryPool: frame index out of range");
+    }
+    if (commands.size() > m_maxDrawCommands)
+    {
+        throw std::runtime_error("GeometryPool: too many indirect draw commands");
+    }
+
+    constexpr vk::DeviceSize stride = sizeof(vk::DrawIndexedIndirectCommand);
+    const vk::DeviceSize offset = static_cast<vk::DeviceSize>(frameIndex) * m_maxDrawCommands * stride;
+    const vk::DeviceSize size = commands.size() * stride;
+    std::memcpy(m_indirectMapped + offset, commands.data(), static_cast<size_t>(size));
+    vmaFlushAllocation(m_allocator->getAllocator(), m_indirectBuffer.getAllocation(), offset, size);
+
+    const auto drawCount = static_cast<uint32_t>(commands.size());
+    if (m_multiDrawIndirect)
+    {
+        commandBuffer.drawIndexedIndirect(m_indirectBuffer.getBuffer(), offset, drawCount, stride);
+        return;
+    }
+    // 未启用multiDrawIndirect时drawCount只能为0或1，逐条提交但仍从间接缓冲读取参数
+    for (uint32_t i = 0; i < drawCount; ++i)
+    {
+        commandBuffer.drawIndexedIndirect(m_indirectBuffer.getBuffer(), offset + i * stride, 1, stride);
+    }
+}
+
+GeometryPoolStats GeometryPool::getStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    GeometryPoolStats stats;
+    stats.vertices = m_vertexRanges.getStats();
+    stats.indices = m_indexRanges.getStats();
+    return stats;
+}
+
+} // namespace asset
@@ -0,0 +1,242 @@
+#include "LoadRequest.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+
+namespace asset
+{
+
+//================================================================//
+// LoadRequest
+//================================================================//
+LoadRequest LoadRequest::makeCompleted(std::string resourceId)
+{
+    auto state = std::make_shared<State>();
+    state->future = state->promise.get_future().share();
+    state->status.store(LoadStatus::Completed, std::memory_order_release);
+    state->promise.set_value(std::move(resourceId));
+    return LoadRequest(std::move(state));
+}
+
+std::shared_future<std::string> LoadRequest::getFuture() const
+{
+    if (!m_state)
+    {
+        throw std::runtime_error("LoadRequest is not valid");
+    }
+    return m_state->future;
+}
+
+LoadPriority LoadRequest::getPriority() const
+{
+    return m_state ? m_state->priority.load(std::memory_order_acquire) : LoadPriority::Normal;
+}
+
+LoadStatus LoadRequest::getStatus() const
+{
+    return m_state ? m_state->status.load(std::memory_order_acquire) : LoadStatus::Cancelled;
+}
+
+void LoadRequest::setPriority(LoadPriority priority)
+{
+    if (!m_state || m_state->status.load(std::memory_order_acquire) != LoadStatus::Pending)
+        return;
+
+    auto queue = m_state->queue.lock();
+    if (!queue)
+        return;
+
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->stopping)
+        return;
+    if (m_state->priority.exchange(priority, std::memory_order_acq_rel) == priority)
+        return;
+
+    // 重新放入新优先级队列，旧队列中的条目在出队时因优先级不匹配而被跳过
+    queue->buckets[static_cast<size_t>(priority)].push_back(m_state);
+    queue->cv.notify_one();
+}
+
+void LoadRequest::raisePriority(LoadPriority priority)
+{
+    if (getPriority() < priority)
+    {
+        setPriority(priority);
+    }
+}
+
+LoadRequest LoadRequest::share() const
+{
+    if (!m_state)
+        return {};
+
+    // 持有者已降为0说明最后一个持有者正在取消，不能再复用该请求
+    uint32_t holders = m_state->holders.load(std::memory_order_acquire);
+    do
+    {
+        if (holders == 0)
+            return {};
+    } while (!m_state->holders.compare_exchange_weak(holders, holders + 1, std::memory_order_acq_rel));
+    return LoadRequest(m_state);
+}
+
+bool LoadRequest::cancel()
+{
+    if (!m_state)
+        return false;
+
+    // 同一持有者（及其拷贝）只计一次；其他持有者仍需要结果时请求继续执行
+    if (m_holderCancelled->exchange(true, std::memory_order_acq_rel))
+        return false;
+    if (m_state->holders.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return false;
+    return cancelState(*m_state);
+}
+
+bool LoadRequest::cancelState(State &state)
+{
+    LoadStatus expected = LoadStatus::Pending;
+    if (!state.status.compare_exchange_strong(expected, LoadStatus::Cancelled, std::memory_order_acq_rel))
+    {
+        return false;
+    }
+
+    // 赢得状态切换后，工作线程不会再执行该任务，可以安全地释放加载逻辑
+    state.work = nullptr;
+    state.promise.set_exception(std::make_exception_ptr(LoadCancelledError("Load request cancelled")));
+    return true;
+}
+
+//================================================================//
+// LoadScheduler
+//================================================================//
+LoadScheduler::LoadScheduler(uint32_t workerCount) : m_queue(std::make_shared<Queue>())
+{
+    if (workerCount == 0)
+    {
+        workerCount = std::max(2u, std::thread::hardware_concurrency() / 2);
+    }
+
+    m_workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+LoadScheduler::~LoadScheduler()
+{
+    shutdown();
+}
+
+LoadRequest LoadScheduler::submit(std::function<std::string()> work, LoadPriority priority)
+{
+    auto state = std::make_shared<LoadRequest::State>();
+    state->work = std::move(work);
+    state->future = state->promise.get_future().share();
+    state->priority.store(priority, std::memory_order_release);
+    state->queue = m_queue;
+
+    LoadRequest request(state);
+    {
+        std::lock_guard<std::mutex> lock(m_queue->mutex);
+        if (!m_queue->stopping)
+        {
+            m_queue->buckets[static_cast<size_t>(priority)].push_back(std::move(state));
+            m_queue->cv.notify_one();
+            return request;
+        }
+    }
+
+    // 调度器已关闭：直接返回已取消的请求
+    LoadRequest::cancelState(*request.m_state);
+    return request;
+}
+
+void LoadScheduler::shutdown()
+{
+    std::array<std::deque<std::shared_ptr<LoadRequest::State>>, kPriorityCount> remaining;
+    {
+        std::lock_guard<std::mutex> lock(m_queue->mutex);
+        if (m_queue->stopping)
+            return;
+        m_queue->stopping = true;
+        remaining.swap(m_queue->buckets);
+    }
+    m_queue->cv.notify_all();
+
+    for (auto &bucket : remaining)
+    {
+        for (auto &state : bucket)
+        {
+            LoadRequest::cancelState(*state);
+        }
+    }
+
+    for (auto &worker : m_workers)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+}
+
+void LoadScheduler::workerLoop()
+{
+    TRACE_THREAD_NAME("Load Worker");
+    while (true)
+    {
+        std::shared_ptr<LoadRequest::State> state;
+        {
+            std::unique_lock<std::mutex> lock(m_queue->mutex);
+            m_queue->cv.wait(lock, [this]() {
+                return m_queue->stopping || std::any_of(m_queue->buckets.begin(), m_queue->buckets.end(),
+                                                        [](const auto &bucket) { return !bucket.empty(); });
+            });
+            if (m_queue->stopping)
+                return;
+
+            // 从最高优先级开始取任务
+            for (size_t i = kPriorityCount; i-- > 0;)
+            {
+                auto &bucket = m_queue->buckets[i];
+                if (!bucket.empty())
+                {
+                    state = std::move(bucket.front());
+                    bucket.pop_front();
+                    // 优先级已被调整：该条目已过期，新条目在其他队列中
+                    if (static_cast<size_t>(state->priority.load(std::memory_order_acquire)) != i)
+                    {
+                        state.reset();
+                        continue;
+                    }
+                    break;
+                }
+            }
+        }
+
+        if (!state)
+            continue;
+
+        // 只有成功从 Pending 切换到 Running 的线程才会执行任务（取消或重复条目在此被过滤）
+        LoadStatus expected = LoadStatus::Pending;
+        if (!state->status.compare_exchange_strong(expected, LoadStatus::Running, std::memory_order_acq_rel))
+            continue;
+
+        auto work = std::move(state->work);
+        try
+        {
+            std::string result = work();
+            state->status.store(LoadStatus::Completed, std::memory_order_release);
+            state->promise.set_value(std::move(result));
+        }
+        catch (...)
+        {
+            state->status.store(LoadStatus::Failed, std::memory_order_release);
+            state->promise.set_exception(std::current_exception());
+        }
+    }
+}
+
+} // namespace asset
@@ -1,21 +1,92 @@
 #include "ResourceManager.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
 #include "vkcore.hpp"
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <iterator>
+#include <optional>
 #include <thread>
+#include <type_traits>
 
 namespace asset
 {
-ResourceManager::ResourceManager(vkcore::VkContext &context) : m_context(&context)
+namespace
+{
+/**
+ * @brief 计算网格数据占用的字节数
+ */
+size_t computeMeshBytes(const std::vector<MeshData> &meshes)
+{
+    size_t bytes = 0;
+    for (const auto &mesh : meshes)
+    {
+        bytes += mesh.getVertexDataSize() + mesh.getIndexDataSize();
+    }
+    return bytes;
+}
+
+/**
+ * @brief 按通道数与像素类型选择GPU格式，RGB三通道不保证可采样，返回eUndefined
+ */
+vk::Format textureFormat(const TextureData &texture)
+{
+    switch (texture.channels)
+    {
+    case 1:
+        return texture.isFloat ? vk::Format::eR32Sfloat : vk::Format::eR8Unorm;
+    case 2:
+        return texture.isFloat ? vk::Format::eR32G32Sfloat : vk::Format::eR8G8Unorm;
+    case 4:
+        return texture.isFloat ? vk::Format::eR32G32B32A32Sfloat : vk::Format::eR8G8B8A8Unorm;
+    default:
+        return vk::Format::eUndefined;
+    }
+}
+
+/**
+ * @brief 创建在释放时同时释放像素数据的纹理指针
+ */
+std::shared_ptr<TextureData> makeTexturePtr(TextureData &&textureData)
+{
+    return std::shared_ptr<TextureData>(new TextureData(std::move(textureData)), [](TextureData *texture) {
+        texture->free();
+        delete texture;
+    });
+}
+} // namespace
+
+ResourceManager::ResourceManager(vkcore::VkContext &context, const ResourceManagerConfig &config)
+    : m_context(&context), m_reflectionCache(config.reflectionCacheDir), m_shaderCompiler(config.shaderCacheDir)
 {
     m_layoutCache = new vkcore::DescriptorSetLayoutCache(context.getDevice());
     m_poolAllocator = new vkcore::DescriptorPoolAllocator(context.getDevice(), *m_layoutCache);
 
-    std::vector<MeshData> cubeMesh = getDefaultCubeMesh();
-    m_meshCache.loadedMeshes.try_emplace("default_cube", std::make_shared<std::vector<MeshData>>(std::move(cubeMesh)));
-    TextureData whiteTexture = getDefaultWhiteTexture();
-    m_textureCache.loadedTextures.try_emplace("default_white", std::make_shared<TextureData>(std::move(whiteTexture)));
+    m_meshCache.budget = config.meshCacheBudget;
+    m_textureCache.budget = config.textureCacheBudget;
+
+    // 帧时间线：延迟释放的GPU资源按帧的实际完成释放，而不是按trimCaches的调用次数
+    vk::SemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.semaphoreType = vk::SemaphoreType::eTimeline;
+    typeInfo.initialValue = 0;
+    vk::SemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.pNext = &typeInfo;
+    m_gpuResidency.frameTimeline = context.getDevice().createSemaphore(semaphoreInfo);
+
+    // 默认资源常驻，不参与淘汰
+    auto cubePtr = std::make_shared<std::vector<MeshData>>(getDefaultCubeMesh());
+    auto cubeEntry = makeEntry<MeshEntry>(cubePtr, computeMeshBytes(*cubePtr), true);
+    m_meshCache.handles.try_emplace("default_cube", m_meshSlots.allocate(cubeEntry));
+    m_meshCache.counters.bytes += cubeEntry->bytes;
+    m_meshCache.loadedMeshes.tryEmplace("default_cube", std::move(cubeEntry));
+
+    auto whitePtr = makeTexturePtr(getDefaultWhiteTexture());
+    auto whiteEntry = makeEntry<TextureEntry>(whitePtr, whitePtr->dataSize, true);
+    m_textureCache.handles.try_emplace("default_white", m_textureSlots.allocate(whiteEntry));
+    m_textureCache.counters.bytes += whiteEntry->bytes;
+    m_textureCache.loadedTextures.tryEmplace("default_white", std::move(whiteEntry));
 }
 
 ResourceManager::~ResourceManager()
@@ -25,6 +96,19 @@ ResourceManager::~ResourceManager()
 
 void ResourceManager::cleanup()
 {
+    // 先停止加载调度器：取消排队中的请求并等待正在执行的请求结束
+    m_loadScheduler.shutdown();
+
+    // 等待飞行中的上传完成后再释放GPU资源；仍在流式队列中积压的请求不再执行
+    if (isGpuResidencyEnabled())
+    {
+        std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+        m_gpuResidency.alive->store(false, std::memory_order_release);
+        m_gpuResidency.alive = std::make_shared<std::atomic<bool>>(true);
+        m_gpuResidency.publishSubmission.reset();
+        publishCompletedUploads(true);
+    }
+
     // 释放描述符集布局和池
     if (m_poolAllocator)
     {
@@ -42,47 +126,81 @@ void ResourceManager::cleanup()
     // 清理其他资源（网格、纹理等）
     {
         std::lock_guard<std::mutex> lock(m_meshCache.mutex);
+        m_meshSlots.clear();
+        m_meshCache.handles.clear();
         m_meshCache.loadedMeshes.clear();
         m_meshCache.loadingMeshes.clear();
+        m_meshCache.counters.bytes = 0;
     }
     {
         std::lock_guard<std::mutex> lock(m_textureCache.mutex);
+        m_textureSlots.clear();
+        m_textureCache.handles.clear();
         m_textureCache.loadedTextures.clear();
         m_textureCache.loadingTextures.clear();
+        m_textureCache.counters.bytes = 0;
     }
     {
         std::lock_guard<std::mutex> lock(m_shaderCache.mutex);
+        m_shaderSlots.clear();
+        m_shaderCache.handles.clear();
         m_shaderCache.loadedShaders.clear();
         m_shaderCache.loadingShaders.clear();
     }
+
+    // 缓存条目已释放，其持有的GPU资源随之释放；这里释放剩余的延迟释放资源
+    {
+        std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+        m_gpuResidency.pendingMeshes.clear();
+        m_gpuResidency.pendingTextures.clear();
+        m_gpuResidency.inFlightMeshes.clear();
+        m_gpuResidency.inFlightTextures.clear();
+        m_gpuResidency.retired.clear();
+        if (m_gpuResidency.frameTimeline)
+        {
+            m_context->getDevice().destroySemaphore(m_gpuResidency.frameTimeline);
+            m_gpuResidency.frameTimeline = nullptr;
+        }
+    }
+    m_gpuResidency.enabled.store(false, std::memory_order_release);
 }
 std::string ResourceManager::loadMesh(const std::filesystem::path &filepath)
 {
-    if (!std::filesystem::exists(filepath))
+    TRACE_SCOPE_NAMED(traceZone, "ResourceManager::loadMesh");
+    TRACE_SET_DETAIL(traceZone, filepath.string());
+    if (!m_fileSystem.exists(filepath))
     {
         throw std::runtime_error("Mesh file does not exist: " + filepath.string());
     }
 
     const std::string resourceId = normalizeResourcePath(filepath);
 
+    if (auto entry = m_meshCache.loadedMeshes.find(resourceId))
     {
-        std::lock_guard<std::mutex> lock(m_meshCache.mutex);
-        if (m_meshCache.loadedMeshes.find(resourceId) != m_meshCache.loadedMeshes.end())
-        {
-            return resourceId;
-        }
+        touch(*entry);
+        m_meshCache.counters.hits.fetch_add(1, std::memory_order_relaxed);
+        return resourceId;
     }
+    m_meshCache.counters.misses.fetch_add(1, std::memory_order_relaxed);
 
-    auto meshData = ModelLoader::loadFromFile(filepath);
+    const FileBlob file = m_fileSystem.readFile(filepath);
+    auto meshData = ModelLoader::loadFromMemory(file.data(), file.size(), filepath);
     if (meshData.empty())
     {
         throw std::runtime_error("Mesh file contains no mesh data: " + filepath.string());
     }
 
     auto meshPtr = std::make_shared<std::vector<MeshData>>(std::move(meshData));
+    auto entry = makeEntry<MeshEntry>(meshPtr, computeMeshBytes(*meshPtr));
     {
         std::lock_guard<std::mutex> lock(m_meshCache.mutex);
-        m_meshCache.loadedMeshes.try_emplace(resourceId, std::move(meshPtr));
+        auto [stored, inserted] = m_meshCache.loadedMeshes.tryEmplace(resourceId, entry);
+        if (inserted)
+        {
+            m_meshCache.handles[resourceId] = m_meshSlots.allocate(stored);
+            m_meshCache.counters.bytes += stored->bytes;
+            queueMeshUpload(resourceId);
+        }
     }
 
     return resourceId;
@@ -90,29 +208,40 @@ std::string ResourceManager::loadMesh(const std::filesystem::path &filepath)
 
 std::string ResourceManager::loadTexture(const std::filesystem::path &filepath)
 {
-    if (!std::filesystem::exists(filepath))
+    TRACE_SCOPE_NAMED(traceZone, "ResourceManager::loadTexture");
+    TRACE_SET_DETAIL(traceZone, filepath.string());
+    if (!m_fileSystem.exists(filepath))
     {
         throw std::runtime_error("Texture file does not exist: " + filepath.string());
     }
     const std::string resourceId = normalizeResourcePath(filepath);
 
+    if (auto entry = m_textureCache.loadedTextures.find(resourceId))
     {
-        std::lock_guard<std::mutex> lock(m_textureCache.mutex);
-        if (m_textureCache.loadedTextures.find(resourceId) != m_textureCache.loadedTextures.end())
-        {
-            return resourceId;
-        }
+        touch(*entry);
+        m_textureCache.counters.hits.fetch_add(1, std::memory_order_relaxed);
+        return resourceId;
     }
-    TextureData textureData = TextureLoader::loadFromFile(filepath, 4, false);
+    m_textureCache.counters.misses.fetch_add(1, std::memory_order_relaxed);
+
+    const FileBlob file = m_fileSystem.readFile(filepath);
+    TextureData textureData = TextureLoader::loadFromMemory(file.data(), file.size(), 4, false);
 
     if (!textureData.isValid())
     {
         throw std::runtime_error("Failed to load texture: " + filepath.string());
     }
-    auto texturePtr = std::make_shared<TextureData>(std::move(textureData));
+    auto texturePtr = makeTexturePtr(std::move(textureData));
+    auto entry = makeEntry<TextureEntry>(texturePtr, texturePtr->dataSize);
     {
         std::lock_guard<std::mutex> lock(m_textureCache.mutex);
-        m_textureCache.loadedTextures.try_emplace(resourceId, std::move(texturePtr));
+        auto [stored, inserted] = m_textureCache.loadedTextures.tryEmplace(resourceId, entry);
+        if (inserted)
+        {
+            m_textureCache.handles[resourceId] = m_textureSlots.allocate(stored);
+            m_textureCache.counters.bytes += stored->bytes;
+            queueTextureUpload(resourceId);
+        }
     }
     return resourceId;
 }
@@ -120,53 +249,168 @@ std::string ResourceManager::loadTexture(const std::filesystem::path &filepath)
 std::string ResourceManager::loadShader(const std::filesystem::path &filepath, std::string shaderName,
                                         bool enableComputeShader)
 {
-    if (!std::filesystem::exists(filepath))
+    TRACE_SCOPE_NAMED(traceZone, "ResourceManager::loadShader");
+    TRACE_SET_DETAIL(traceZone, shaderName);
+    if (!m_fileSystem.exists(filepath))
     {
         throw std::runtime_error("Shader file does not exist: " + filepath.string());
     }
     std::string resourceId = normalizeResourcePath(filepath / shaderName);
 
+    if (m_shaderCache.loadedShaders.contains(resourceId))
     {
-        std::lock_guard<std::mutex> lock(m_shaderCache.mutex);
-        if (m_shaderCache.loadedShaders.find(resourceId) != m_shaderCache.loadedShaders.end())
+        return resourceId;
+    }
+
+    std::vector<std::vector<uint32_t>> spirvCodes;
+    shaderProgram program = createShaderProgram(filepath, shaderName, enableComputeShader, spirvCodes);
+    reflectDescriptorSetLayouts(spirvCodes, shaderName);
+    registerShaderProgram(resourceId, shaderName, std::move(program));
+    return resourceId;
+}
+
+std::string ResourceManager::loadShaderFromSource(const std::filesystem::path &sourceDir,
+                                                  const std::string &shaderName, const ShaderDefines &defines,
+                                                  bool enableComputeShader)
+{
+    const std::string variantName = ShaderCompiler::permutationName(shaderName, defines);
+    TRACE_SCOPE_NAMED(traceZone, "ResourceManager::loadShaderFromSource");
+    TRACE_SET_DETAIL(traceZone, variantName);
+    const std::string resourceId = normalizeResourcePath(sourceDir / variantName);
+    if (m_shaderCache.loadedShaders.contains(resourceId))
+    {
+        return resourceId;
+    }
+
+    ShaderSource source{sourceDir, shaderName, defines, enableComputeShader};
+    std::vector<std::vector<uint32_t>> spirvCodes;
+    shaderProgram program = compileShaderProgram(source, spirvCodes);
+    reflectDescriptorSetLayouts(spirvCodes, variantName);
+    registerShaderProgram(resourceId, variantName, std::move(program));
+
+    // 记录编译参数，源码变化时热重载按相同的宏定义重新编译
+    std::lock_guard<std::mutex> lock(m_shaderCache.mutex);
+    m_shaderCache.sources.try_emplace(resourceId, std::move(source));
+    return resourceId;
+}
+
+shaderProgram ResourceManager::compileShaderProgram(const ShaderSource &source,
+                                                    std::vector<std::vector<uint32_t>> &spirvCodes)
+{
+    std::vector<std::pair<std::filesystem::path, vk::ShaderStageFlagBits>> stages = {
+        {source.sourceDir / (source.shaderName + ".vert"), vk::ShaderStageFlagBits::eVertex},
+        {source.sourceDir / (source.shaderName + ".frag"), vk::ShaderStageFlagBits::eFragment},
+    };
+    if (source.enableComputeShader)
+    {
+        stages.emplace_back(source.sourceDir / (source.shaderName + ".comp"), vk::ShaderStageFlagBits::eCompute);
+    }
+
+    for (const auto &[sourceFile, stage] : stages)
+    {
+        if (!m_fileSystem.exists(sourceFile))
         {
-            return resourceId;
+            throw std::runtime_error("Shader source does not exist: " + sourceFile.string());
         }
+        const FileBlob file = m_fileSystem.readFile(sourceFile);
+        spirvCodes.push_back(
+            m_shaderCompiler.compile(std::string(file.asString()), sourceFile, stage, source.defines));
     }
+    return buildShaderProgram(spirvCodes, source.enableComputeShader);
+}
+
+std::shared_future<std::vector<std::string>> ResourceManager::loadShaderPermutationsAsync(
+    const std::filesystem::path &sourceDir, const std::string &shaderName,
+    const std::vector<ShaderDefines> &permutations, bool enableComputeShader, LoadPriority priority)
+{
+    // 每个变体作为一个独立任务，由加载工作线程并行编译
+    std::vector<LoadRequest> requests;
+    requests.reserve(permutations.size());
+    for (const auto &defines : permutations)
+    {
+        requests.push_back(m_loadScheduler.submit(
+            [this, sourceDir, shaderName, defines, enableComputeShader]() {
+                return loadShaderFromSource(sourceDir, shaderName, defines, enableComputeShader);
+            },
+            priority));
+    }
+
+    // 等待在独立线程中进行，避免占用工作线程
+    std::packaged_task<std::vector<std::string>()> task([requests = std::move(requests)]() {
+        std::vector<std::string> ids;
+        ids.reserve(requests.size());
+        for (const auto &request : requests)
+        {
+            ids.push_back(request.getFuture().get());
+        }
+        return ids;
+    });
+
+    auto sfut = task.get_future().share();
+    std::thread(std::move(task)).detach();
+    return sfut;
+}
 
+ShaderCompilerStats ResourceManager::getShaderCompilerStats() const
+{
+    return m_shaderCompiler.getStats();
+}
+
+void ResourceManager::registerShaderProgram(const std::string &resourceId, const std::string &shaderName,
+                                            shaderProgram program)
+{
+    std::lock_guard<std::mutex> lock(m_shaderCache.mutex);
+    // 同时使用资源绝对路径与 shader 前缀作为键，便于 RenderPass 通过前缀查找程序
+    auto [stored, inserted] =
+        m_shaderCache.loadedShaders.tryEmplace(resourceId, std::make_shared<shaderProgram>(std::move(program)));
+    m_shaderCache.loadedShaders.tryEmplace(shaderName, stored);
+    if (inserted)
+    {
+        // 两个键共享同一个程序与句柄
+        const ShaderHandle handle = m_shaderSlots.allocate(stored);
+        m_shaderCache.handles[resourceId] = handle;
+        m_shaderCache.handles.try_emplace(shaderName, handle);
+    }
+}
+
+shaderProgram ResourceManager::createShaderProgram(const std::filesystem::path &directory,
+                                                  const std::string &shaderName, bool enableComputeShader,
+                                                  std::vector<std::vector<uint32_t>> &spirvCodes)
+{
+    TRACE_SCOPE("ResourceManager::createShaderProgram");
     std::vector<std::filesystem::path> shaderFiles;
-    shaderFiles.push_back(filepath / (shaderName + ".vert.spv"));
-    shaderFiles.push_back(filepath / (shaderName + ".frag.spv"));
+    shaderFiles.push_back(directory / (shaderName + ".vert.spv"));
+    shaderFiles.push_back(directory / (shaderName + ".frag.spv"));
     if (enableComputeShader)
     {
-        shaderFiles.push_back(filepath / (shaderName + ".comp.spv"));
+        shaderFiles.push_back(directory / (shaderName + ".comp.spv"));
     }
 
-    shaderProgram program;
-    std::vector<std::vector<uint32_t>> spirvCodes;
-    for (int i = 0; i < shaderFiles.size(); ++i)
+    spirvCodes.clear();
+    for (const auto &shaderFile : shaderFiles)
     {
-        if (!std::filesystem::exists(shaderFiles[i]))
-        {
-            throw std::runtime_error("Shader file does not exist: " + shaderFiles[i].string());
-        }
-        std::ifstream file(shaderFiles[i], std::ios::binary | std::ios::ate);
-        if (!file.is_open())
+        if (!m_fileSystem.exists(shaderFile))
         {
-            throw std::runtime_error("Failed to open shader file: " + shaderFiles[i].string());
+            throw std::runtime_error("Shader file does not exist: " + shaderFile.string());
         }
-        size_t fileSize = static_cast<size_t>(file.tellg());
-        if (fileSize % 4 != 0)
+        const FileBlob file = m_fileSystem.readFile(shaderFile);
+        if (file.size() % 4 != 0)
         {
-            throw std::runtime_error("Invalid SPIR-V file size: " + shaderFiles[i].string());
+            throw std::runtime_error("Invalid SPIR-V file size: " + shaderFile.string());
         }
 
-        std::vector<uint32_t> spirvCode(fileSize / 4);
-        file.seekg(0);
-        file.read(reinterpret_cast<char *>(spirvCode.data()), fileSize);
-        file.close();
-        spirvCodes.push_back(spirvCode);
+        std::vector<uint32_t> spirvCode(file.size() / 4);
+        std::memcpy(spirvCode.data(), file.data(), file.size());
+        spirvCodes.push_back(std::move(spirvCode));
     }
+
+    return buildShaderProgram(spirvCodes, enableComputeShader);
+}
+
+shaderProgram ResourceManager::buildShaderProgram(const std::vector<std::vector<uint32_t>> &spirvCodes,
+                                                  bool enableComputeShader)
+{
+    shaderProgram program;
     program.vertexShader =
         std::make_shared<ShaderModule>(m_context->getDevice(), spirvCodes[0], vk::ShaderStageFlagBits::eVertex);
     program.fragmentShader =
@@ -176,120 +420,279 @@ std::string ResourceManager::loadShader(const std::filesystem::path &filepath, s
         program.computeShader =
             std::make_shared<ShaderModule>(m_context->getDevice(), spirvCodes[2], vk::ShaderStageFlagBits::eCompute);
     }
-    reflectDescriptorSetLayouts(spirvCodes, shaderName);
-    {
-        std::lock_guard<std::mutex> lock(m_shaderCache.mutex);
-        // 同时使用资源绝对路径与 shader 前缀作为键，便于 RenderPass 通过前缀查找程序
-        m_shaderCache.loadedShaders.try_emplace(resourceId, program);
-        m_shaderCache.loadedShaders.try_emplace(shaderName, std::move(program));
-    }
-    return resourceId;
+    return program;
+}
+
+void ResourceManager::mountPackage(const std::filesystem::path &packageFile, const std::filesystem::path &mountRoot)
+{
+    m_fileSystem.mount(packageFile, mountRoot);
 }
 
 std::shared_future<std::string> ResourceManager::loadMeshAsync(const std::filesystem::path &filepath)
+{
+    return requestMeshLoad(filepath).getFuture();
+}
+
+std::shared_future<std::string> ResourceManager::loadTextureAsync(const std::filesystem::path &filepath)
+{
+    return requestTextureLoad(filepath).getFuture();
+}
+
+LoadRequest ResourceManager::requestMeshLoad(const std::filesystem::path &filepath, LoadPriority priority)
 {
     // 统一规范资源 ID，避免同一文件用不同写法重复加载
     const std::string resourceId = normalizeResourcePath(filepath);
 
+    // 1. 已经加载完成：返回一个已完成的请求（无锁快速路径）
+    if (m_meshCache.loadedMeshes.contains(resourceId))
     {
-        std::lock_guard<std::mutex> lock(m_meshCache.mutex);
+        return LoadRequest::makeCompleted(resourceId);
+    }
 
-        // 1. 已经加载完成：返回一个已完成的 shared_future
-        auto itLoaded = m_meshCache.loadedMeshes.find(resourceId);
-        if (itLoaded != m_meshCache.loadedMeshes.end())
-        {
-            std::promise<std::string> p;
-            p.set_value(resourceId);
-            return p.get_future().share();
-        }
+    // 提交过程全程持有缓存锁：任务结束时的擦除也需要该锁，保证登记先于擦除
+    std::lock_guard<std::mutex> lock(m_meshCache.mutex);
+    if (m_meshCache.loadedMeshes.contains(resourceId))
+    {
+        return LoadRequest::makeCompleted(resourceId);
+    }
 
-        // 2. 正在加载：复用已有的 shared_future
-        auto itLoading = m_meshCache.loadingMeshes.find(resourceId);
-        if (itLoading != m_meshCache.loadingMeshes.end())
+    // 2. 正在加载且未被取消：登记为已有请求的新持有者，必要时提升优先级
+    auto itLoading = m_meshCache.loadingMeshes.find(resourceId);
+    if (itLoading != m_meshCache.loadingMeshes.end() && !itLoading->second.isCancelled())
+    {
+        if (LoadRequest shared = itLoading->second.share(); shared.isValid())
         {
-            return itLoading->second;
+            shared.raisePriority(priority);
+            return shared;
         }
     }
 
-    // 3. 第一次请求这个资源 → 创建异步任务
-    std::packaged_task<std::string()> task([this, filepath, resourceId]() {
-        // 在任务结束时，从 loadingMeshes 中自动擦除自己
-        struct LoadingEraser
-        {
-            MeshCache &cache;
-            std::string id;
-
-            ~LoadingEraser()
+    // 3. 第一次请求（或之前的请求已取消）→ 提交到调度器
+    LoadRequest request = m_loadScheduler.submit(
+        [this, filepath, resourceId]() {
+            // 在任务结束时，从 loadingMeshes 中擦除自己
+            struct LoadingEraser
             {
-                std::lock_guard<std::mutex> lock(cache.mutex);
-                cache.loadingMeshes.erase(id);
-            }
-        } eraser{m_meshCache, resourceId};
+                MeshCache &cache;
+                std::string id;
 
-        // 加载逻辑
-        return this->loadMesh(filepath);
-    });
+                ~LoadingEraser()
+                {
+                    std::lock_guard<std::mutex> lock(cache.mutex);
+                    // 登记的请求若已被取消并替换为新的排队请求，则保留新的登记
+                    auto it = cache.loadingMeshes.find(id);
+                    if (it != cache.loadingMeshes.end() && it->second.getStatus() == LoadStatus::Running)
+                    {
+                        cache.loadingMeshes.erase(it);
+                    }
+                }
+            } eraser{m_meshCache, resourceId};
 
-    // 从 packaged_task 拿到 future，再转成 shared_future
-    std::future<std::string> fut = task.get_future();
-    std::shared_future<std::string> sfut = fut.share();
+            // 加载逻辑
+            return this->loadMesh(filepath);
+        },
+        priority);
 
+    m_meshCache.loadingMeshes.insert_or_assign(resourceId, request);
+    return request;
+}
+
+LoadRequest ResourceManager::requestTextureLoad(const std::filesystem::path &filepath, LoadPriority priority)
+{
+    const std::string resourceId = normalizeResourcePath(filepath);
+
+    if (m_textureCache.loadedTextures.contains(resourceId))
     {
-        std::lock_guard<std::mutex> lock(m_meshCache.mutex);
-        m_meshCache.loadingMeshes.emplace(resourceId, sfut);
+        return LoadRequest::makeCompleted(resourceId);
     }
 
-    // 启动后台线程执行任务
-    std::thread(std::move(task)).detach();
+    std::lock_guard<std::mutex> lock(m_textureCache.mutex);
+    if (m_textureCache.loadedTextures.contains(resourceId))
+    {
+        return LoadRequest::makeCompleted(resourceId);
+    }
 
-    // 返回 shared_future（拷贝一份句柄，共享同一状态）
-    return sfut;
+    auto itLoading = m_textureCache.loadingTextures.find(resourceId);
+    if (itLoading != m_textureCache.loadingTextures.end() && !itLoading->second.isCancelled())
+    {
+        if (LoadRequest shared = itLoading->second.share(); shared.isValid())
+        {
+            shared.raisePriority(priority);
+            return shared;
+        }
+    }
+
+    LoadRequest request = m_loadScheduler.submit(
+        [this, filepath, resourceId]() {
+            struct LoadingEraser
+            {
+                TextureCache &cache;
+                std::string id;
+
+                ~LoadingEraser()
+                {
+                    std::lock_guard<std::mutex> lock(cache.mutex);
+                    // 登记的请求若已被取消并替换为新的排队请求，则保留新的登记
+                    auto it = cache.loadingTextures.find(id);
+                    if (it != cache.loadingTextures.end() && it->second.getStatus() == LoadStatus::Running)
+                    {
+                        cache.loadingTextures.erase(it);
+                    }
+                }
+            } eraser{m_textureCache, resourceId};
+
+            return this->loadTexture(filepath);
+        },
+        priority);
+
+    m_textureCache.loadingTextures.insert_or_assign(resourceId, request);
+    return request;
 }
 
-std::shared_future<std::string> ResourceManager::loadTextureAsync(const std::filesystem::path &filepath)
+LoadRequest ResourceManager::submitLoadTask(std::function<std::string()> work, LoadPriority priority)
 {
-    const std::string resourceId = normalizeResourcePath(filepath);
+    return m_loadScheduler.submit(std::move(work), priority);
+}
 
+template <typename Entry, typename Tag>
+bool ResourceManager::replaceEntry(std::mutex &mutex, SnapshotMap<Entry> &loaded,
+                                   std::unordered_map<std::string, Handle<Tag>> &handles,
+                                   SlotRegistry<Entry, Tag> &slots, CacheCounters &counters,
+                                   const std::string &resourceId, std::shared_ptr<Entry> entry)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto previous = loaded.find(resourceId);
+    if (!previous)
+        return false;
+
+    // 新条目继承固定状态与访问时间；先发布新快照再切换句柄，读者看到的总是完整条目
+    entry->pinned = previous->pinned;
+    entry->lastAccess.store(previous->lastAccess.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    // 旧GPU数据在新条目上传完成前继续发布，重新加载期间资源不会消失；旧条目不再上传
+    bool superseded = false;
     {
-        std::lock_guard<std::mutex> lock(m_textureCache.mutex);
-        auto itLoaded = m_textureCache.loadedTextures.find(resourceId);
-        if (itLoaded != m_textureCache.loadedTextures.end())
+        std::lock_guard<std::mutex> gpuLock(m_gpuResidency.mutex);
+        if (const auto *view = previous->gpuView.load(std::memory_order_acquire))
         {
-            std::promise<std::string> p;
-            p.set_value(resourceId);
-            return p.get_future().share();
+            previous->retired.store(true, std::memory_order_release);
+            entry->gpuView.store(view, std::memory_order_release);
+            entry->superseded = previous;
+            superseded = true;
         }
+    }
 
-        auto itLoading = m_textureCache.loadingTextures.find(resourceId);
-        if (itLoading != m_textureCache.loadingTextures.end())
-        {
-            return itLoading->second;
-        }
+    loaded.insertOrAssign(resourceId, entry);
+    if (auto it = handles.find(resourceId); it != handles.end())
+    {
+        slots.update(it->second, entry);
+    }
+    counters.bytes += entry->bytes;
+    if (!previous->cpuReleased)
+        counters.bytes -= previous->bytes;
+    if (!superseded)
+    {
+        retireEntry(previous);
     }
+    return true;
+}
 
-    std::packaged_task<std::string()> task([this, filepath, resourceId]() {
-        struct LoadingEraser
-        {
-            TextureCache &cache;
-            std::string id;
-            ~LoadingEraser()
+LoadRequest ResourceManager::requestMeshReload(const std::string &resourceId, LoadPriority priority)
+{
+    return m_loadScheduler.submit(
+        [this, resourceId, priority]() {
+            auto meshData = ModelLoader::loadFromFile(resourceId);
+            if (meshData.empty())
             {
-                std::lock_guard<std::mutex> lock(cache.mutex);
-                cache.loadingTextures.erase(id);
+                throw std::runtime_error("Mesh file contains no mesh data: " + resourceId);
             }
-        } eraser{m_textureCache, resourceId};
 
-        return this->loadTexture(filepath);
-    });
+            auto meshPtr = std::make_shared<std::vector<MeshData>>(std::move(meshData));
+            auto entry = makeEntry<MeshEntry>(meshPtr, computeMeshBytes(*meshPtr));
+            if (!replaceEntry(m_meshCache.mutex, m_meshCache.loadedMeshes, m_meshCache.handles, m_meshSlots,
+                              m_meshCache.counters, resourceId, std::move(entry)))
+            {
+                throw std::runtime_error("Mesh is not loaded: " + resourceId);
+            }
+            queueMeshUpload(resourceId, priority);
+            return resourceId;
+        },
+        priority);
+}
 
-    auto sfut = task.get_future().share();
-    {
-        std::lock_guard<std::mutex> lock(m_textureCache.mutex);
-        m_textureCache.loadingTextures.emplace(resourceId, sfut);
-    }
+LoadRequest ResourceManager::requestTextureReload(const std::string &resourceId, LoadPriority priority)
+{
+    return m_loadScheduler.submit(
+        [this, resourceId, priority]() {
+            TextureData textureData = TextureLoader::loadFromFile(resourceId, 4, false);
+            if (!textureData.isValid())
+            {
+                throw std::runtime_error("Failed to load texture: " + resourceId);
+            }
 
-    std::thread(std::move(task)).detach();
-    return sfut;
+            auto texturePtr = makeTexturePtr(std::move(textureData));
+            auto entry = makeEntry<TextureEntry>(texturePtr, texturePtr->dataSize);
+            if (!replaceEntry(m_textureCache.mutex, m_textureCache.loadedTextures, m_textureCache.handles,
+                              m_textureSlots, m_textureCache.counters, resourceId, std::move(entry)))
+            {
+                throw std::runtime_error("Texture is not loaded: " + resourceId);
+            }
+            queueTextureUpload(resourceId, priority);
+            return resourceId;
+        },
+        priority);
+}
+
+LoadRequest ResourceManager::requestShaderReload(const std::string &resourceId, LoadPriority priority)
+{
+    return m_loadScheduler.submit(
+        [this, resourceId]() {
+            auto previous = m_shaderCache.loadedShaders.find(resourceId);
+            if (!previous)
+            {
+                throw std::runtime_error("Shader is not loaded: " + resourceId);
+            }
+
+            std::optional<ShaderSource> source;
+            {
+                std::lock_guard<std::mutex> lock(m_shaderCache.mutex);
+                if (auto it = m_shaderCache.sources.find(resourceId); it != m_shaderCache.sources.end())
+                {
+                    source = it->second;
+                }
+            }
+
+            // 资源标识符为 目录/着色器名（源码程序为 目录/变体名），与加载时的参数一一对应
+            const std::filesystem::path shaderPath(resourceId);
+            const std::string shaderName = shaderPath.filename().string();
+            std::vector<std::vector<uint32_t>> spirvCodes;
+            auto program = std::make_shared<shaderProgram>(
+                source ? compileShaderProgram(*source, spirvCodes)
+                       : createShaderProgram(shaderPath.parent_path(), shaderName, previous->hasComputeShader(),
+                                             spirvCodes));
+
+            // 布局缓存会拒绝与已注册结构不一致的描述符集，此时保留旧程序
+            reflectDescriptorSetLayouts(spirvCodes, shaderName);
+
+            std::lock_guard<std::mutex> lock(m_shaderCache.mutex);
+            previous = m_shaderCache.loadedShaders.find(resourceId);
+            if (!previous)
+            {
+                throw std::runtime_error("Shader is not loaded: " + resourceId);
+            }
+            m_shaderCache.loadedShaders.insertOrAssign(resourceId, program);
+            if (m_shaderCache.loadedShaders.find(shaderName) == previous)
+            {
+                m_shaderCache.loadedShaders.insertOrAssign(shaderName, program);
+            }
+            if (auto it = m_shaderCache.handles.find(resourceId); it != m_shaderCache.handles.end())
+            {
+                m_shaderSlots.update(it->second, program);
+            }
+            retireObject(std::move(previous));
+            return resourceId;
+        },
+        priority);
 }
 
 std::shared_future<std::string> ResourceManager::loadShaderAsync(const std::filesystem::path &filepath,
@@ -299,8 +702,7 @@ std::shared_future<std::string> ResourceManager::loadShaderAsync(const std::file
 
     {
         std::lock_guard<std::mutex> lock(m_shaderCache.mutex);
-        auto itLoaded = m_shaderCache.loadedShaders.find(resourceId);
-        if (itLoaded != m_shaderCache.loadedShaders.end())
+        if (m_shaderCache.loadedShaders.contains(resourceId))
         {
             std::promise<std::string> p;
             p.set_value(resourceId);
@@ -403,12 +805,17 @@ std::shared_ptr<std::vector<MeshData>> ResourceManager::registerMesh(const std::
     mesh.indices = indices;
     meshVec->push_back(std::move(mesh));
 
+    // 程序化网格无法从磁盘重新加载，因此固定在缓存中不参与淘汰
     std::lock_guard<std::mutex> lock(m_meshCache.mutex);
-    auto [it, inserted] = m_meshCache.loadedMeshes.try_emplace(name, meshVec);
+    auto [stored, inserted] =
+        m_meshCache.loadedMeshes.tryEmplace(name, makeEntry<MeshEntry>(meshVec, computeMeshBytes(*meshVec), true));
     if (!inserted)
     {
-        return it->second;
+        return stored->value.load(std::memory_order_acquire);
     }
+    m_meshCache.handles[name] = m_meshSlots.allocate(stored);
+    m_meshCache.counters.bytes += stored->bytes;
+    queueMeshUpload(name);
     return meshVec;
 }
 
@@ -416,14 +823,593 @@ bool ResourceManager::unloadMesh(const std::string &name)
 {
     std::lock_guard<std::mutex> lock(m_meshCache.mutex);
     m_meshCache.loadingMeshes.erase(name);
-    return m_meshCache.loadedMeshes.erase(name) > 0;
+    if (auto it = m_meshCache.handles.find(name); it != m_meshCache.handles.end())
+    {
+        m_meshSlots.release(it->second);
+        m_meshCache.handles.erase(it);
+    }
+    if (auto entry = m_meshCache.loadedMeshes.find(name))
+    {
+        if (!entry->cpuReleased)
+            m_meshCache.counters.bytes -= entry->bytes;
+        retireEntry(entry);
+        return m_meshCache.loadedMeshes.erase(name);
+    }
+    return false;
 }
 
 bool ResourceManager::unloadTexture(const std::string &name)
 {
     std::lock_guard<std::mutex> lock(m_textureCache.mutex);
     m_textureCache.loadingTextures.erase(name);
-    return m_textureCache.loadedTextures.erase(name) > 0;
+    if (auto it = m_textureCache.handles.find(name); it != m_textureCache.handles.end())
+    {
+        m_textureSlots.release(it->second);
+        m_textureCache.handles.erase(it);
+    }
+    if (auto entry = m_textureCache.loadedTextures.find(name))
+    {
+        if (!entry->cpuReleased)
+            m_textureCache.counters.bytes -= entry->bytes;
+        retireEntry(entry);
+        return m_textureCache.loadedTextures.erase(name);
+    }
+    return false;
+}
+
+template <typename Entry, typename Tag>
+size_t ResourceManager::evictToBudget(SnapshotMap<Entry> &loaded, std::unordered_map<std::string, Handle<Tag>> &handles,
+                                      SlotRegistry<Entry, Tag> &slots, CacheCounters &counters, size_t budget,
+                                      uint64_t epoch)
+{
+    size_t residentBytes = counters.bytes.load(std::memory_order_relaxed);
+    if (budget == 0 || residentBytes <= budget)
+        return 0;
+
+    // 候选条目：未固定、CPU数据仍在且无外部引用、自上次淘汰以来未被访问。
+    // 已发布GPU数据的条目只释放CPU数据：GPU数据可能已写入描述符集，仅凭CPU侧的LRU无法判断何时不再被绑定；
+    // 上传尚未完成（包括重新加载期间沿用旧GPU数据）的条目仍需CPU数据录制上传，不处理
+    struct Candidate
+    {
+        uint64_t lastAccess;
+        const std::shared_ptr<Entry> *entry;
+        const std::string *id;
+        bool releaseCpuOnly;
+    };
+    auto snapshot = loaded.snapshot();
+    std::vector<Candidate> candidates;
+    {
+        std::lock_guard<std::mutex> gpuLock(m_gpuResidency.mutex);
+        for (const auto &[id, entry] : snapshot)
+        {
+            const uint64_t lastAccess = entry->lastAccess.load(std::memory_order_relaxed);
+            if (entry->pinned || entry->cpuReleased || lastAccess >= epoch)
+                continue;
+            // 原子共享指针本身与这里的拷贝各占一个引用，超出说明有读者仍持有CPU数据
+            if (entry->value.load(std::memory_order_acquire).use_count() > 2)
+                continue;
+
+            if (entry->gpu)
+                candidates.push_back({lastAccess, &entry, &id, true});
+            else if (!entry->uploadScheduled.load(std::memory_order_acquire) &&
+                     !entry->gpuView.load(std::memory_order_acquire))
+                candidates.push_back({lastAccess, &entry, &id, false});
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate &a, const Candidate &b) { return a.lastAccess < b.lastAccess; });
+
+    std::vector<std::string> evicted;
+    size_t released = 0;
+    for (const auto &candidate : candidates)
+    {
+        if (residentBytes <= budget)
+            break;
+        const auto &entry = *candidate.entry;
+        residentBytes -= entry->bytes;
+        if (candidate.releaseCpuOnly)
+        {
+            // 条目、句柄与GPU数据保留，仍在使用CPU数据的读者持有的拷贝不受影响
+            entry->value.store(nullptr, std::memory_order_release);
+            entry->cpuReleased = true;
+            ++released;
+            continue;
+        }
+        if (auto it = handles.find(*candidate.id); it != handles.end())
+        {
+            slots.release(it->second);
+            handles.erase(it);
+        }
+        retireEntry(entry);
+        evicted.push_back(*candidate.id);
+    }
+
+    loaded.erase(evicted);
+    counters.bytes.store(residentBytes, std::memory_order_relaxed);
+    counters.evictions.fetch_add(evicted.size(), std::memory_order_relaxed);
+    counters.cpuReleases.fetch_add(released, std::memory_order_relaxed);
+    return evicted.size();
+}
+
+size_t ResourceManager::trimCaches()
+{
+    // 递增纪元：本次调用之前被访问过的条目在下一次调用前都不会被淘汰
+    const uint64_t epoch = m_accessEpoch.fetch_add(1, std::memory_order_relaxed);
+
+    size_t evicted = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_meshCache.mutex);
+        evicted += evictToBudget(m_meshCache.loadedMeshes, m_meshCache.handles, m_meshSlots, m_meshCache.counters,
+                                 m_meshCache.budget, epoch);
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_textureCache.mutex);
+        evicted += evictToBudget(m_textureCache.loadedTextures, m_textureCache.handles, m_textureSlots,
+                                 m_textureCache.counters, m_textureCache.budget, epoch);
+    }
+
+    // 释放帧时间线已越过其退役值的条目与GPU资源，此时引用它们的命令缓冲都已执行完毕
+    {
+        std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+        auto &retired = m_gpuResidency.retired;
+        if (!retired.empty() && m_gpuResidency.frameTimeline)
+        {
+            const uint64_t completed = m_context->getDevice().getSemaphoreCounterValue(m_gpuResidency.frameTimeline);
+            retired.erase(
+                std::remove_if(retired.begin(), retired.end(),
+                               [&](const GpuResidency::Retired &item) { return item.frameValue <= completed; }),
+                retired.end());
+        }
+    }
+    return evicted;
+}
+
+FrameSignal ResourceManager::nextFrameSignal()
+{
+    FrameSignal signal;
+    signal.semaphore = m_gpuResidency.frameTimeline;
+    signal.value = m_gpuResidency.frameValue.fetch_add(1, std::memory_order_acq_rel) + 1;
+    return signal;
+}
+
+CacheStats ResourceManager::getMeshCacheStats() const
+{
+    CacheStats stats;
+    stats.hits = m_meshCache.counters.hits.load(std::memory_order_relaxed);
+    stats.misses = m_meshCache.counters.misses.load(std::memory_order_relaxed);
+    stats.evictions = m_meshCache.counters.evictions.load(std::memory_order_relaxed);
+    stats.cpuReleases = m_meshCache.counters.cpuReleases.load(std::memory_order_relaxed);
+    stats.residentBytes = m_meshCache.counters.bytes.load(std::memory_order_relaxed);
+    for (const auto &[id, entry] : m_meshCache.loadedMeshes.snapshot())
+    {
+        ++stats.entryCount;
+        if (entry->gpuView.load(std::memory_order_acquire))
+            stats.gpuResidentBytes += entry->bytes;
+    }
+    stats.budgetBytes = m_meshCache.budget;
+    stats.snapshots = m_meshCache.loadedMeshes.getStats();
+    return stats;
+}
+
+ReflectionCacheStats ResourceManager::getReflectionCacheStats() const
+{
+    return m_reflectionCache.getStats();
+}
+
+CacheStats ResourceManager::getTextureCacheStats() const
+{
+    CacheStats stats;
+    stats.hits = m_textureCache.counters.hits.load(std::memory_order_relaxed);
+    stats.misses = m_textureCache.counters.misses.load(std::memory_order_relaxed);
+    stats.evictions = m_textureCache.counters.evictions.load(std::memory_order_relaxed);
+    stats.cpuReleases = m_textureCache.counters.cpuReleases.load(std::memory_order_relaxed);
+    stats.residentBytes = m_textureCache.counters.bytes.load(std::memory_order_relaxed);
+    for (const auto &[id, entry] : m_textureCache.loadedTextures.snapshot())
+    {
+        ++stats.entryCount;
+        if (entry->gpuView.load(std::memory_order_acquire))
+            stats.gpuResidentBytes += entry->bytes;
+    }
+    stats.budgetBytes = m_textureCache.budget;
+    stats.snapshots = m_textureCache.loadedTextures.getStats();
+    return stats;
+}
+
+//================================================================//
+// GPU常驻
+//================================================================//
+void ResourceManager::enableGpuResidency(vkcore::VkResourceAllocator &allocator,
+                                         vkcore::TransferManager &transferManager, GeometryPool *geometryPool)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+        if (m_gpuResidency.enabled.load(std::memory_order_relaxed))
+            return;
+        m_gpuResidency.allocator = &allocator;
+        m_gpuResidency.transferManager = &transferManager;
+        m_gpuResidency.geometryPool = geometryPool;
+        m_gpuResidency.enabled.store(true, std::memory_order_release);
+    }
+
+    // 已在缓存中的资源同样需要上传；与并发插入重复排队的条目在提交时被过滤
+    for (const auto &[id, entry] : m_meshCache.loadedMeshes.snapshot())
+    {
+        queueMeshUpload(id);
+    }
+    for (const auto &[id, entry] : m_textureCache.loadedTextures.snapshot())
+    {
+        queueTextureUpload(id);
+    }
+}
+
+void ResourceManager::queueMeshUpload(const std::string &resourceId, LoadPriority priority)
+{
+    if (!isGpuResidencyEnabled())
+        return;
+    std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+    m_gpuResidency.pendingMeshes.push_back({resourceId, priority});
+}
+
+void ResourceManager::queueTextureUpload(const std::string &resourceId, LoadPriority priority)
+{
+    if (!isGpuResidencyEnabled())
+        return;
+    std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+    m_gpuResidency.pendingTextures.push_back({resourceId, priority});
+}
+
+void ResourceManager::retireEntry(const std::shared_ptr<const MeshEntry> &entry)
+{
+    // 在互斥锁内置位：完成回调的发布同样持锁，不会在此之后重新发布gpuView
+    GpuResidency::Retired retired;
+    retired.frameValue = retireFrameValue();
+    retired.entry = entry;
+    std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+    entry->retired.store(true, std::memory_order_release);
+    entry->gpuView.store(nullptr, std::memory_order_release);
+    retired.mesh = std::move(entry->gpu);
+    m_gpuResidency.retired.push_back(std::move(retired));
+    retireSuperseded(*entry, [](GpuResidency::Retired &item, std::unique_ptr<GpuMesh> gpu) {
+        item.mesh = std::move(gpu);
+    });
+}
+
+void ResourceManager::retireEntry(const std::shared_ptr<const TextureEntry> &entry)
+{
+    GpuResidency::Retired retired;
+    retired.frameValue = retireFrameValue();
+    retired.entry = entry;
+    std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+    entry->retired.store(true, std::memory_order_release);
+    entry->gpuView.store(nullptr, std::memory_order_release);
+    retired.texture = std::move(entry->gpu);
+    m_gpuResidency.retired.push_back(std::move(retired));
+    retireSuperseded(*entry, [](GpuResidency::Retired &item, std::unique_ptr<GpuTexture> gpu) {
+        item.texture = std::move(gpu);
+    });
+}
+
+template <typename Entry, typename RetireFn>
+void ResourceManager::retireSuperseded(const Entry &entry, RetireFn retire)
+{
+    for (auto superseded = std::move(entry.superseded); superseded; superseded = std::move(superseded->superseded))
+    {
+        GpuResidency::Retired retired;
+        retired.frameValue = retireFrameValue();
+        retired.entry = superseded;
+        retire(retired, std::move(superseded->gpu));
+        m_gpuResidency.retired.push_back(std::move(retired));
+    }
+}
+
+void ResourceManager::retireObject(std::shared_ptr<const void> object)
+{
+    GpuResidency::Retired retired;
+    retired.frameValue = retireFrameValue();
+    retired.entry = std::move(object);
+    std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+    m_gpuResidency.retired.push_back(std::move(retired));
+}
+
+void ResourceManager::publishCompletedUploads(bool wait)
+{
+    TRACE_SCOPE(wait ? "ResourceManager::waitUploads" : "ResourceManager::publishUploads");
+    auto publish = [&](auto &inFlight, auto retire) {
+        for (auto it = inFlight.begin(); it != inFlight.end();)
+        {
+            bool complete = true;
+            std::string error;
+            for (const auto &token : it->tokens)
+            {
+                if (wait)
+                {
+                    // 失败的令牌在wait中抛出，与轮询路径一样按isFailed处理；等待信号量本身失败则向上传递
+                    try
+                    {
+                        token.wait();
+                    }
+                    catch (const std::runtime_error &)
+                    {
+                        if (!token.isFailed())
+                            throw;
+                    }
+                }
+                else if (!token.isComplete())
+                {
+                    complete = false;
+                    break;
+                }
+                if (token.isFailed())
+                    error = token.getError();
+            }
+            if (!complete)
+            {
+                ++it;
+                continue;
+            }
+
+            // 上传失败：GPU数据未写入，复位上传标记，条目可在重新排队时再次上传
+            if (!error.empty())
+            {
+                std::cerr << "GPU upload failed, data is not published: " << error << std::endl;
+                it->entry->uploadScheduled.store(false, std::memory_order_release);
+            }
+
+            // 上传期间条目已被卸载或淘汰：GPU数据从未发布，仍走延迟释放以保持释放路径一致
+            if (!error.empty() || it->entry->retired.load(std::memory_order_acquire))
+            {
+                GpuResidency::Retired retired;
+                retired.frameValue = retireFrameValue();
+                retired.entry = it->entry;
+                retire(retired, std::move(it->gpu));
+                m_gpuResidency.retired.push_back(std::move(retired));
+            }
+            else
+            {
+                // 替换条目上传完成：先切换到新数据，再释放此前沿用的旧GPU数据
+                it->entry->gpu = std::move(it->gpu);
+                it->entry->gpuView.store(it->entry->gpu.get(), std::memory_order_release);
+                retireSuperseded(*it->entry, retire);
+            }
+            it = inFlight.erase(it);
+        }
+    };
+
+    publish(m_gpuResidency.inFlightMeshes,
+            [](GpuResidency::Retired &retired, std::unique_ptr<GpuMesh> gpu) { retired.mesh = std::move(gpu); });
+    publish(m_gpuResidency.inFlightTextures, [](GpuResidency::Retired &retired, std::unique_ptr<GpuTexture> gpu) {
+        retired.texture = std::move(gpu);
+    });
+}
+
+ResourceManager::GpuResidency::InFlight<ResourceManager::MeshEntry> ResourceManager::uploadMesh(
+    const std::string &resourceId, const std::shared_ptr<const MeshEntry> &entry, vkcore::UploadBatch &batch)
+{
+    TRACE_SCOPE_NAMED(traceZone, "ResourceManager::uploadMesh");
+    TRACE_SET_DETAIL(traceZone, resourceId);
+    TRACE_SET_BYTES(traceZone, entry->bytes);
+    // 所有子网格合并到一个顶点缓冲和一个索引缓冲，每个网格只需两次复制
+    auto gpu = std::make_unique<GpuMesh>();
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    vertices.reserve(entry->bytes / sizeof(Vertex));
+    const auto meshes = entry->value.load(std::memory_order_acquire);
+    if (!meshes)
+    {
+        throw std::runtime_error("Mesh CPU data has been released: " + resourceId);
+    }
+    for (const auto &mesh : *meshes)
+    {
+        GpuSubmesh submesh;
+        submesh.firstIndex = static_cast<uint32_t>(indices.size());
+        submesh.indexCount = static_cast<uint32_t>(mesh.indices.size());
+        submesh.vertexOffset = static_cast<int32_t>(vertices.size());
+        submesh.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        gpu->submeshes.push_back(submesh);
+
+        vertices.insert(vertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+        indices.insert(indices.end(), mesh.indices.begin(), mesh.indices.end());
+    }
+    gpu->totalVertexCount = static_cast<uint32_t>(vertices.size());
+    gpu->totalIndexCount = static_cast<uint32_t>(indices.size());
+    if (vertices.empty())
+    {
+        throw std::runtime_error("Mesh has no vertex data: " + resourceId);
+    }
+
+    GpuResidency::InFlight<MeshEntry> inFlight;
+    inFlight.entry = entry;
+
+    // 优先放入几何池：子网格偏移换算为池中的绝对位置，所有网格共享一次绑定
+    if (auto *pool = m_gpuResidency.geometryPool)
+    {
+        if (auto range = pool->allocate(gpu->totalVertexCount, gpu->totalIndexCount))
+        {
+            gpu->pool = pool;
+            gpu->poolRange = *range;
+            for (auto &submesh : gpu->submeshes)
+            {
+                submesh.firstIndex += range->firstIndex;
+                submesh.vertexOffset += static_cast<int32_t>(range->vertexOffset);
+            }
+            pool->upload(*range, vertices, indices, batch);
+            inFlight.gpu = std::move(gpu);
+            return inFlight;
+        }
+        std::cerr << "Geometry pool is full, using dedicated buffers for mesh: " << resourceId << std::endl;
+    }
+
+    vkcore::BufferDesc vertexDesc{};
+    vertexDesc.size = vertices.size() * sizeof(Vertex);
+    vertexDesc.usage = vkcore::BufferUsageFlags::Vertex | vkcore::BufferUsageFlags::TransferDst;
+    vertexDesc.memory = vkcore::MemoryUsage::GpuOnly;
+    vertexDesc.debugName = resourceId + "_VB";
+    vertexDesc.allowDirectWrite = true;
+    gpu->vertexBuffer = m_gpuResidency.allocator->createBuffer(vertexDesc);
+
+    // 先创建全部缓冲再录制复制，避免录制后创建失败导致批次引用已销毁的缓冲
+    if (!indices.empty())
+    {
+        vkcore::BufferDesc indexDesc{};
+        indexDesc.size = indices.size() * sizeof(uint32_t);
+        indexDesc.usage = vkcore::BufferUsageFlags::Index | vkcore::BufferUsageFlags::TransferDst;
+        indexDesc.memory = vkcore::MemoryUsage::GpuOnly;
+        indexDesc.debugName = resourceId + "_IB";
+        indexDesc.allowDirectWrite = true;
+        gpu->indexBuffer = m_gpuResidency.allocator->createBuffer(indexDesc);
+    }
+
+    batch.uploadToBuffer(gpu->vertexBuffer, vertices);
+    if (!indices.empty())
+    {
+        batch.uploadToBuffer(gpu->indexBuffer, indices);
+    }
+
+    inFlight.gpu = std::move(gpu);
+    return inFlight;
+}
+
+ResourceManager::GpuResidency::InFlight<ResourceManager::TextureEntry> ResourceManager::uploadTexture(
+    const std::string &resourceId, const std::shared_ptr<const TextureEntry> &entry, vkcore::UploadBatch &batch)
+{
+    TRACE_SCOPE_NAMED(traceZone, "ResourceManager::uploadTexture");
+    TRACE_SET_DETAIL(traceZone, resourceId);
+    TRACE_SET_BYTES(traceZone, entry->bytes);
+    const auto texturePtr = entry->value.load(std::memory_order_acquire);
+    if (!texturePtr)
+    {
+        throw std::runtime_error("Texture CPU data has been released: " + resourceId);
+    }
+    const TextureData &texture = *texturePtr;
+    const vk::Format format = textureFormat(texture);
+    if (format == vk::Format::eUndefined)
+    {
+        throw std::runtime_error("Unsupported texture layout for GPU residency (" + std::to_string(texture.channels) +
+                                 " channels): " + resourceId);
+    }
+    const size_t texelBytes = static_cast<size_t>(texture.channels) * (texture.isFloat ? sizeof(float) : 1);
+    if (texture.dataSize != static_cast<size_t>(texture.width) * texture.height * texelBytes)
+    {
+        throw std::runtime_error("Texture data size does not match its dimensions: " + resourceId);
+    }
+
+    auto gpu = std::make_unique<GpuTexture>();
+    gpu->width = static_cast<uint32_t>(texture.width);
+    gpu->height = static_cast<uint32_t>(texture.height);
+    gpu->mipLevels = 1;
+
+    vkcore::ImageDesc desc{};
+    desc.width = gpu->width;
+    desc.height = gpu->height;
+    desc.format = format;
+    desc.usage = vkcore::ImageUsageFlags::Sampled | vkcore::ImageUsageFlags::TransferDst;
+    desc.memory = vkcore::MemoryUsage::GpuOnly;
+    desc.debugName = resourceId;
+    gpu->image = m_gpuResidency.allocator->createImage(desc, vk::ImageAspectFlagBits::eColor);
+
+    GpuResidency::InFlight<TextureEntry> inFlight;
+    inFlight.entry = entry;
+    batch.uploadToImage(gpu->image, texture.pixels, texture.dataSize, gpu->width, gpu->height);
+    inFlight.gpu = std::move(gpu);
+    return inFlight;
+}
+
+size_t ResourceManager::flushGpuUploads()
+{
+    if (!isGpuResidencyEnabled())
+        return 0;
+
+    scheduleGpuUploads();
+    const vkcore::StreamingStats stats = m_gpuResidency.transferManager->processStreamingUploads();
+    m_gpuResidency.transferManager->processCompletions();
+    return stats.frameRequests;
+}
+
+void ResourceManager::waitForGpuUploads()
+{
+    if (!isGpuResidencyEnabled())
+        return;
+
+    scheduleGpuUploads();
+    m_gpuResidency.transferManager->processStreamingUploads(true);
+    std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+    publishCompletedUploads(true);
+}
+
+void ResourceManager::scheduleGpuUploads()
+{
+    std::vector<GpuResidency::PendingUpload> pendingMeshes;
+    std::vector<GpuResidency::PendingUpload> pendingTextures;
+    std::shared_ptr<std::atomic<bool>> alive;
+    {
+        std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+        publishCompletedUploads(false);
+        pendingMeshes.swap(m_gpuResidency.pendingMeshes);
+        pendingTextures.swap(m_gpuResidency.pendingTextures);
+        alive = m_gpuResidency.alive;
+    }
+
+    // 资源在录制时才创建，积压在流式队列中的上传不占用GPU内存；
+    // 同一帧录制的网格与纹理共享批次，提交后才移入飞行列表
+    auto schedule = [&](const GpuResidency::PendingUpload &pending, auto entry, auto uploadFn, auto &inFlightList,
+                        const char *kind) {
+        using InFlightType = typename std::remove_reference_t<decltype(inFlightList)>::value_type;
+        if (!entry || entry->retired.load(std::memory_order_acquire) ||
+            entry->uploadScheduled.exchange(true, std::memory_order_acq_rel))
+            return;
+
+        auto upload = std::make_shared<InFlightType>();
+        vkcore::StreamingUpload request;
+        request.bytes = entry->bytes;
+        request.priority = static_cast<uint32_t>(pending.priority);
+        request.record = [this, alive, upload, entry, uploadFn, kind,
+                          id = pending.resourceId](vkcore::UploadBatch &batch) {
+            // 积压期间条目可能已被卸载或淘汰，此时不再上传
+            if (!alive->load(std::memory_order_acquire) || entry->retired.load(std::memory_order_acquire))
+                return;
+            try
+            {
+                *upload = (this->*uploadFn)(id, entry, batch);
+            }
+            catch (const std::exception &e)
+            {
+                // 未进入飞行列表，复位上传标记使条目可以重新排队
+                std::cerr << "Failed to upload " << kind << " " << id << ": " << e.what() << std::endl;
+                entry->uploadScheduled.store(false, std::memory_order_release);
+            }
+        };
+        request.onSubmitted = [this, alive, upload, &inFlightList](const vkcore::TransferToken &token) {
+            if (!alive->load(std::memory_order_acquire) || !upload->gpu)
+                return;
+            upload->tokens.push_back(token);
+            {
+                std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+                inFlightList.push_back(std::move(*upload));
+                if (m_gpuResidency.publishSubmission == token.state)
+                    return;
+                m_gpuResidency.publishSubmission = token.state;
+            }
+            // 批次完成即发布，不必等到下一次flushGpuUploads轮询
+            m_gpuResidency.transferManager->then(token, [this, alive](const vkcore::TransferToken &) {
+                if (!alive->load(std::memory_order_acquire))
+                    return;
+                std::lock_guard<std::mutex> lock(m_gpuResidency.mutex);
+                publishCompletedUploads(false);
+            });
+        };
+        m_gpuResidency.transferManager->scheduleUpload(std::move(request));
+    };
+
+    for (const auto &pending : pendingMeshes)
+    {
+        schedule(pending, m_meshCache.loadedMeshes.find(pending.resourceId), &ResourceManager::uploadMesh,
+                 m_gpuResidency.inFlightMeshes, "mesh");
+    }
+    for (const auto &pending : pendingTextures)
+    {
+        schedule(pending, m_textureCache.loadedTextures.find(pending.resourceId), &ResourceManager::uploadTexture,
+                 m_gpuResidency.inFlightTextures, "texture");
+    }
 }
 
 //================================================================//
@@ -573,9 +1559,19 @@ void ResourceManager::registerDescriptorLayouts(
 void ResourceManager::reflectDescriptorSetLayouts(const std::vector<std::vector<uint32_t>> &spirvCodes,
                                                   const std::string &shaderPrefix)
 {
+    TRACE_SCOPE_NAMED(traceZone, "ResourceManager::reflectDescriptorSetLayouts");
+    TRACE_SET_DETAIL(traceZone, shaderPrefix);
     if (spirvCodes.empty())
         return;
 
+    // 相同SPIR-V的程序直接复用合并后的结果，跳过spirv-reflect解析
+    const uint64_t cacheKey = ShaderReflectionCache::computeKey(spirvCodes);
+    if (auto cachedSets = m_reflectionCache.find(cacheKey))
+    {
+        registerDescriptorLayouts(*cachedSets, shaderPrefix);
+        return;
+    }
+
     std::vector<std::unordered_map<uint32_t, std::vector<vkcore::DescriptorBindingInfo>>> perModuleData;
     // 反射每个模块
 
@@ -601,45 +1597,90 @@ void ResourceManager::reflectDescriptorSetLayouts(const std::vector<std::vector<
         return;
 
     auto finalSets = mergeReflectionResults(perModuleData);
+    m_reflectionCache.store(cacheKey, finalSets);
     registerDescriptorLayouts(finalSets, shaderPrefix);
 }
 
 std::shared_ptr<std::vector<MeshData>> ResourceManager::getMesh(const std::string &name)
 {
-    std::lock_guard<std::mutex> lock(m_meshCache.mutex);
-    auto it = m_meshCache.loadedMeshes.find(name);
-    if (it != m_meshCache.loadedMeshes.end())
+    auto entry = m_meshCache.loadedMeshes.find(name);
+    if (!entry)
     {
-        return it->second;
+        m_meshCache.counters.misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
     }
-    return nullptr;
+    m_meshCache.counters.hits.fetch_add(1, std::memory_order_relaxed);
+    return touch(*entry).value.load(std::memory_order_acquire);
 }
 
 std::shared_ptr<TextureData> ResourceManager::getTexture(const std::string &name)
 {
-    std::lock_guard<std::mutex> lock(m_textureCache.mutex);
-    auto it = m_textureCache.loadedTextures.find(name);
-    if (it != m_textureCache.loadedTextures.end())
+    auto entry = m_textureCache.loadedTextures.find(name);
+    if (!entry)
     {
-        return it->second;
+        m_textureCache.counters.misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
     }
-    return nullptr;
+    m_textureCache.counters.hits.fetch_add(1, std::memory_order_relaxed);
+    return touch(*entry).value.load(std::memory_order_acquire);
 }
 
 shaderProgram ResourceManager::getShaderprogram(const std::string &name)
 {
-    std::lock_guard<std::mutex> lock(m_shaderCache.mutex);
     // 优先按传入的前缀查找，其次尝试归一化路径键以兼容旧调用
-    if (auto it = m_shaderCache.loadedShaders.find(name); it != m_shaderCache.loadedShaders.end())
+    if (auto program = m_shaderCache.loadedShaders.find(name))
+    {
+        return *program;
+    }
+    if (auto program = m_shaderCache.loadedShaders.find(normalizeResourcePath(name)))
+    {
+        return *program;
+    }
+    return shaderProgram{};
+}
+
+MeshHandle ResourceManager::getMeshHandle(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(m_meshCache.mutex);
+    auto it = m_meshCache.handles.find(name);
+    return it != m_meshCache.handles.end() ? it->second : MeshHandle{};
+}
+
+TextureHandle ResourceManager::getTextureHandle(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(m_textureCache.mutex);
+    auto it = m_textureCache.handles.find(name);
+    return it != m_textureCache.handles.end() ? it->second : TextureHandle{};
+}
+
+ShaderHandle ResourceManager::getShaderHandle(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(m_shaderCache.mutex);
+    if (auto it = m_shaderCache.handles.find(name); it != m_shaderCache.handles.end())
     {
         return it->second;
     }
     const std::string normalized = normalizeResourcePath(name);
-    if (auto it = m_shaderCache.loadedShaders.find(normalized); it != m_shaderCache.loadedShaders.end())
+    if (auto it = m_shaderCache.handles.find(normalized); it != m_shaderCache.handles.end())
     {
         return it->second;
     }
-    return shaderProgram{};
+    return ShaderHandle{};
+}
+
+std::vector<std::string> ResourceManager::findShaderProgramsBySource(const std::string &sourceId)
+{
+    const std::string normalized = normalizeResourcePath(sourceId);
+    std::vector<std::string> programs;
+    std::lock_guard<std::mutex> lock(m_shaderCache.mutex);
+    for (const auto &[resourceId, source] : m_shaderCache.sources)
+    {
+        if (normalizeResourcePath(source.sourceDir / source.shaderName) == normalized)
+        {
+            programs.push_back(resourceId);
+        }
+    }
+    return programs;
 }
 
 std::vector<vk::DescriptorSet> ResourceManager::getOrAllocateDescriptorSet(
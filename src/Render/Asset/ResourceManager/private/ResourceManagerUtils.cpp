@@ -1,4 +1,5 @@
 #include "ResourceManagerUtils.hpp"
+#include "Trace.hpp"
 
 #include "Descriptor.hpp"
 #define STB_IMAGE_IMPLEMENTATION
@@ -17,6 +18,45 @@
 
 namespace asset
 {
+namespace
+{
+/**
+ * @brief 只读内存流缓冲区，使基于流的解析器可以直接读取资源包中的数据
+ */
+class MemoryStreamBuf : public std::streambuf
+{
+  public:
+    MemoryStreamBuf(const uint8_t *data, size_t size)
+    {
+        char *begin = const_cast<char *>(reinterpret_cast<const char *>(data));
+        setg(begin, begin, begin + size);
+    }
+
+  protected:
+    pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+    {
+        if (!(which & std::ios_base::in))
+            return pos_type(off_type(-1));
+
+        off_type base = 0;
+        if (dir == std::ios_base::cur)
+            base = gptr() - eback();
+        else if (dir == std::ios_base::end)
+            base = egptr() - eback();
+
+        const off_type target = base + offset;
+        if (target < 0 || target > egptr() - eback())
+            return pos_type(off_type(-1));
+        setg(eback(), eback() + target, egptr());
+        return pos_type(target);
+    }
+
+    pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+    {
+        return seekoff(off_type(position), std::ios_base::beg, which);
+    }
+};
+} // namespace
 
 // ============================================================================
 // ModelLoader 实现
@@ -58,8 +98,40 @@ std::vector<MeshData> ModelLoader::loadFromFile(const std::filesystem::path &fil
     }
 }
 
+std::vector<MeshData> ModelLoader::loadFromMemory(const uint8_t *data, size_t dataSize,
+                                                  const std::filesystem::path &filePath, bool flipUVs)
+{
+    MemoryStreamBuf buffer(data, dataSize);
+    std::istream stream(&buffer);
+
+    switch (detectFormat(filePath))
+    {
+    case ModelFormat::OBJ:
+        return parseOBJ(stream, filePath.string(), flipUVs);
+    case ModelFormat::STL: {
+        MeshData mesh = parseSTL(stream);
+        mesh.debugname = filePath.stem().string();
+        return {mesh};
+    }
+    default:
+        throw std::runtime_error("Unsupported or unknown model format: " + filePath.string());
+    }
+}
+
 std::vector<MeshData> ModelLoader::loadOBJ(const std::filesystem::path &filePath, bool flipUVs)
 {
+    std::ifstream file(filePath);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open OBJ file: " + filePath.string());
+    }
+    return parseOBJ(file, filePath.string(), flipUVs);
+}
+
+std::vector<MeshData> ModelLoader::parseOBJ(std::istream &file, const std::string &sourceName, bool flipUVs)
+{
+    TRACE_SCOPE_NAMED(traceZone, "ModelLoader::parseOBJ");
+    TRACE_SET_DETAIL(traceZone, sourceName);
     std::vector<MeshData> meshes;
     std::vector<Vertex> vertices;
     std::vector<uint32_t> indices;
@@ -69,12 +141,6 @@ std::vector<MeshData> ModelLoader::loadOBJ(const std::filesystem::path &filePath
     std::vector<glm::vec3> normals;
     std::vector<glm::vec2> texCoords;
 
-    std::ifstream file(filePath);
-    if (!file.is_open())
-    {
-        throw std::runtime_error("Failed to open OBJ file: " + filePath.string());
-    }
-
     std::string line;
     std::string currentMeshName = "default";
     bool hasData = false;
@@ -189,7 +255,7 @@ std::vector<MeshData> ModelLoader::loadOBJ(const std::filesystem::path &filePath
 
     if (meshes.empty())
     {
-        throw std::runtime_error("No geometry found in OBJ file: " + filePath.string());
+        throw std::runtime_error("No geometry found in OBJ file: " + sourceName);
     }
 
     return meshes;
@@ -204,30 +270,24 @@ MeshData ModelLoader::loadSTL(const std::filesystem::path &filePath)
         throw std::runtime_error("Failed to open STL file: " + filePath.string());
     }
 
+    MeshData meshData = parseSTL(file);
+    meshData.debugname = filePath.stem().string();
+    return meshData;
+}
+
+MeshData ModelLoader::parseSTL(std::istream &file)
+{
+    TRACE_SCOPE("ModelLoader::parseSTL");
     // 检测是二进制还是 ASCII
     char header[5];
     file.read(header, 5);
     file.seekg(0);
 
     bool isBinary = (std::string(header, 5) != "solid");
-
-    MeshData meshData;
-    meshData.debugname = filePath.stem().string();
-
-    if (isBinary)
-    {
-        meshData = loadSTLBinary(file);
-    }
-    else
-    {
-        meshData = loadSTLAscii(file);
-    }
-
-    file.close();
-    return meshData;
+    return isBinary ? loadSTLBinary(file) : loadSTLAscii(file);
 }
 
-MeshData ModelLoader::loadSTLBinary(std::ifstream &file)
+MeshData ModelLoader::loadSTLBinary(std::istream &file)
 {
     MeshData meshData;
     std::vector<Vertex> vertices;
@@ -273,7 +333,7 @@ MeshData ModelLoader::loadSTLBinary(std::ifstream &file)
     return meshData;
 }
 
-MeshData ModelLoader::loadSTLAscii(std::ifstream &file)
+MeshData ModelLoader::loadSTLAscii(std::istream &file)
 {
     MeshData meshData;
     std::vector<Vertex> vertices;
@@ -614,6 +674,7 @@ TextureData TextureLoader::createCheckerboard(int width, int height, int squareS
 
 TextureData TextureLoader::loadStandard(const std::filesystem::path &filePath, int desiredChannels, bool flipVertically)
 {
+    TRACE_SCOPE_NAMED(traceZone, "TextureLoader::loadStandard");
     // 设置垂直翻转
     stbi_set_flip_vertically_on_load(static_cast<int>(flipVertically));
 
@@ -641,11 +702,13 @@ TextureData TextureLoader::loadStandard(const std::filesystem::path &filePath, i
 
     data.dataSize = data.width * data.height * data.channels;
 
+    TRACE_SET_BYTES(traceZone, data.dataSize);
     return data;
 }
 
 TextureData TextureLoader::loadHDR(const std::filesystem::path &filePath, int desiredChannels, bool flipVertically)
 {
+    TRACE_SCOPE_NAMED(traceZone, "TextureLoader::loadHDR");
     // 设置垂直翻转
     stbi_set_flip_vertically_on_load(flipVertically ? 1 : 0);
 
@@ -676,18 +739,47 @@ TextureData TextureLoader::loadHDR(const std::filesystem::path &filePath, int de
     // 注意：这里只是类型转换，实际数据仍然是 float
     data.pixels = reinterpret_cast<unsigned char *>(hdrPixels);
     data.dataSize = data.width * data.height * data.channels * sizeof(float);
+    data.isFloat = true;
 
+    TRACE_SET_BYTES(traceZone, data.dataSize);
     return data;
 }
 
 TextureData TextureLoader::loadFromMemory(const unsigned char *data, size_t dataSize, int desiredChannels,
                                           bool flipVertically)
 {
+    TRACE_SCOPE_NAMED(traceZone, "TextureLoader::loadFromMemory");
     // 设置垂直翻转
     stbi_set_flip_vertically_on_load(flipVertically ? 1 : 0);
 
     TextureData result;
 
+    // HDR 与 loadFromFile 保持一致，返回浮点像素
+    if (stbi_is_hdr_from_memory(data, static_cast<int>(dataSize)))
+    {
+        float *hdrPixels = stbi_loadf_from_memory(data, static_cast<int>(dataSize), &result.width, &result.height,
+                                                  &result.channels, desiredChannels);
+        if (!hdrPixels)
+        {
+            std::string errorMsg = "Failed to load HDR texture from memory";
+            const char *stbiError = stbi_failure_reason();
+            if (stbiError)
+            {
+                errorMsg += " (Reason: " + std::string(stbiError) + ")";
+            }
+            throw std::runtime_error(errorMsg);
+        }
+        if (desiredChannels > 0)
+        {
+            result.channels = desiredChannels;
+        }
+        result.pixels = reinterpret_cast<unsigned char *>(hdrPixels);
+        result.dataSize = result.width * result.height * result.channels * sizeof(float);
+        result.isFloat = true;
+        TRACE_SET_BYTES(traceZone, result.dataSize);
+        return result;
+    }
+
     // 从内存加载图像
     result.pixels = stbi_load_from_memory(data, static_cast<int>(dataSize), &result.width, &result.height,
                                           &result.channels, desiredChannels);
@@ -711,6 +803,7 @@ TextureData TextureLoader::loadFromMemory(const unsigned char *data, size_t data
 
     result.dataSize = result.width * result.height * result.channels;
 
+    TRACE_SET_BYTES(traceZone, result.dataSize);
     return result;
 }
 
@@ -0,0 +1,132 @@
+#include "ShaderCompiler.hpp"
+#include "AssetPackage.hpp"
+#include "Trace.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace asset
+{
+namespace
+{
+constexpr uint32_t kSpirvMagic = 0x07230203;
+
+ShaderDefines sortedDefines(const ShaderDefines &defines)
+{
+    ShaderDefines sorted = defines;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+} // namespace
+
+ShaderCompiler::ShaderCompiler(std::filesystem::path cacheDirectory)
+    : m_cacheDirectory(std::move(cacheDirectory)), m_compilerVersion(vkcore::VkUtils::getGLSLCompilerVersion())
+{
+}
+
+std::vector<uint32_t> ShaderCompiler::compile(const std::string &source, const std::filesystem::path &sourceFile,
+                                              vk::ShaderStageFlagBits stage, const ShaderDefines &defines)
+{
+    TRACE_SCOPE_NAMED(traceZone, "ShaderCompiler::compile");
+    TRACE_SET_DETAIL(traceZone, sourceFile.string());
+    const std::string filename = sourceFile.generic_string();
+    if (m_cacheDirectory.empty())
+    {
+        std::vector<uint32_t> spirv = vkcore::VkUtils::compileGLSLToSPIRV(source, stage, filename, defines);
+        m_compiled.fetch_add(1, std::memory_order_relaxed);
+        return spirv;
+    }
+
+    // 预处理开销远小于编译，用展开后的源码计算键，使 #include 的文件也参与缓存失效
+    std::string keyText = m_compilerVersion;
+    keyText += '\n';
+    keyText += std::to_string(static_cast<uint32_t>(stage));
+    for (const auto &[name, value] : sortedDefines(defines))
+    {
+        keyText += '\n' + name + '=' + value;
+    }
+    keyText += '\n';
+    keyText += vkcore::VkUtils::preprocessGLSL(source, stage, filename, defines);
+
+    char entryName[32];
+    std::snprintf(entryName, sizeof(entryName), "%016llx.spv", static_cast<unsigned long long>(fnv1a64(keyText)));
+    const std::filesystem::path entryPath = m_cacheDirectory / entryName;
+
+    {
+        std::ifstream file(entryPath, std::ios::binary | std::ios::ate);
+        if (file.is_open())
+        {
+            const auto size = static_cast<size_t>(file.tellg());
+            if (size >= sizeof(uint32_t) && size % sizeof(uint32_t) == 0)
+            {
+                std::vector<uint32_t> spirv(size / sizeof(uint32_t));
+                file.seekg(0);
+                if (file.read(reinterpret_cast<char *>(spirv.data()), static_cast<std::streamsize>(size)) &&
+                    spirv[0] == kSpirvMagic)
+                {
+                    m_cacheHits.fetch_add(1, std::memory_order_relaxed);
+                    return spirv;
+                }
+            }
+        }
+    }
+
+    std::vector<uint32_t> spirv = vkcore::VkUtils::compileGLSLToSPIRV(source, stage, filename, defines);
+    m_compiled.fetch_add(1, std::memory_order_relaxed);
+
+    // 缓存写入失败不影响本次编译结果
+    std::error_code ec;
+    std::filesystem::create_directories(m_cacheDirectory, ec);
+    std::filesystem::path tempPath = entryPath;
+    tempPath += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return spirv;
+        file.write(reinterpret_cast<const char *>(spirv.data()),
+                   static_cast<std::streamsize>(spirv.size() * sizeof(uint32_t)));
+        if (!file)
+        {
+            file.close();
+            std::filesystem::remove(tempPath, ec);
+            return spirv;
+        }
+    }
+    std::filesystem::rename(tempPath, entryPath, ec);
+    if (ec)
+        std::filesystem::remove(tempPath, ec);
+    return spirv;
+}
+
+std::string ShaderCompiler::permutationName(const std::string &shaderName, const ShaderDefines &defines)
+{
+    if (defines.empty())
+        return shaderName;
+
+    std::string name = shaderName + '[';
+    bool first = true;
+    for (const auto &[define, value] : sortedDefines(defines))
+    {
+        if (!first)
+            name += ',';
+        first = false;
+        name += define;
+        if (!value.empty())
+            name += '=' + value;
+    }
+    name += ']';
+    return name;
+}
+
+ShaderCompilerStats ShaderCompiler::getStats() const
+{
+    ShaderCompilerStats stats;
+    stats.cacheHits = m_cacheHits.load(std::memory_order_relaxed);
+    stats.compiled = m_compiled.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace asset
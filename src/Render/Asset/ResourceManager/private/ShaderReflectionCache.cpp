@@ -0,0 +1,221 @@
+#include "ShaderReflectionCache.hpp"
+#include "AssetPackage.hpp"
+#include "Trace.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace asset
+{
+namespace
+{
+constexpr uint32_t kReflectionMagic = 0x4C464552; // "REFL"
+constexpr uint32_t kReflectionVersion = 1;
+
+void writeU32(std::vector<uint8_t> &out, uint32_t value)
+{
+    const size_t offset = out.size();
+    out.resize(offset + sizeof(value));
+    std::memcpy(out.data() + offset, &value, sizeof(value));
+}
+
+/**
+ * @brief 顺序读取缓冲区，越界时置为失败状态
+ */
+struct Reader
+{
+    const std::vector<uint8_t> &bytes;
+    size_t offset = 0;
+    bool ok = true;
+
+    uint32_t readU32()
+    {
+        uint32_t value = 0;
+        if (!ok || bytes.size() - offset < sizeof(value))
+        {
+            ok = false;
+            return 0;
+        }
+        std::memcpy(&value, bytes.data() + offset, sizeof(value));
+        offset += sizeof(value);
+        return value;
+    }
+
+    std::string readString(uint32_t length)
+    {
+        if (!ok || bytes.size() - offset < length)
+        {
+            ok = false;
+            return {};
+        }
+        std::string value(reinterpret_cast<const char *>(bytes.data() + offset), length);
+        offset += length;
+        return value;
+    }
+};
+} // namespace
+
+ShaderReflectionCache::ShaderReflectionCache(std::filesystem::path cacheDirectory)
+    : m_cacheDirectory(std::move(cacheDirectory))
+{
+}
+
+uint64_t ShaderReflectionCache::computeKey(const std::vector<std::vector<uint32_t>> &spirvCodes)
+{
+    uint64_t hash = fnv1a64(&kReflectionVersion, sizeof(kReflectionVersion));
+    for (const auto &spv : spirvCodes)
+    {
+        // 写入每个阶段的长度，保证阶段边界不同的程序不会得到相同的键
+        const uint64_t wordCount = spv.size();
+        hash = fnv1a64(&wordCount, sizeof(wordCount), hash);
+        hash = fnv1a64(spv.data(), spv.size() * sizeof(uint32_t), hash);
+    }
+    return hash;
+}
+
+std::optional<DescriptorSetBindings> ShaderReflectionCache::find(uint64_t key)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end())
+        {
+            m_memoryHits.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+    }
+
+    if (!m_cacheDirectory.empty())
+    {
+        TRACE_SCOPE("ShaderReflectionCache::readEntry");
+        std::ifstream file(entryPath(key), std::ios::binary | std::ios::ate);
+        if (file.is_open())
+        {
+            std::vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            if (file.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size())))
+            {
+                if (auto sets = deserialize(bytes))
+                {
+                    m_diskHits.fetch_add(1, std::memory_order_relaxed);
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_entries.try_emplace(key, *sets);
+                    return sets;
+                }
+            }
+        }
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+}
+
+void ShaderReflectionCache::store(uint64_t key, const DescriptorSetBindings &sets)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.insert_or_assign(key, sets);
+    }
+
+    if (m_cacheDirectory.empty())
+        return;
+
+    // 磁盘缓存写入失败不影响加载，下次启动时重新反射即可
+    std::error_code ec;
+    std::filesystem::create_directories(m_cacheDirectory, ec);
+    const std::filesystem::path path = entryPath(key);
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    const std::vector<uint8_t> bytes = serialize(sets);
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+            return;
+        file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file)
+        {
+            file.close();
+            std::filesystem::remove(tempPath, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec)
+        std::filesystem::remove(tempPath, ec);
+}
+
+ReflectionCacheStats ShaderReflectionCache::getStats() const
+{
+    ReflectionCacheStats stats;
+    stats.memoryHits = m_memoryHits.load(std::memory_order_relaxed);
+    stats.diskHits = m_diskHits.load(std::memory_order_relaxed);
+    stats.misses = m_misses.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    stats.entryCount = m_entries.size();
+    return stats;
+}
+
+std::filesystem::path ShaderReflectionCache::entryPath(uint64_t key) const
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.refl", static_cast<unsigned long long>(key));
+    return m_cacheDirectory / name;
+}
+
+std::vector<uint8_t> ShaderReflectionCache::serialize(const DescriptorSetBindings &sets)
+{
+    std::vector<uint8_t> out;
+    writeU32(out, kReflectionMagic);
+    writeU32(out, kReflectionVersion);
+    writeU32(out, static_cast<uint32_t>(sets.size()));
+    for (const auto &[setIndex, bindings] : sets)
+    {
+        writeU32(out, setIndex);
+        writeU32(out, static_cast<uint32_t>(bindings.size()));
+        for (const auto &binding : bindings)
+        {
+            writeU32(out, static_cast<uint32_t>(binding.name.size()));
+            out.insert(out.end(), binding.name.begin(), binding.name.end());
+            writeU32(out, binding.binding);
+            writeU32(out, static_cast<uint32_t>(binding.descriptorType));
+            writeU32(out, binding.descriptorCount);
+            writeU32(out, static_cast<uint32_t>(binding.stageFlags));
+        }
+    }
+    return out;
+}
+
+std::optional<DescriptorSetBindings> ShaderReflectionCache::deserialize(const std::vector<uint8_t> &bytes)
+{
+    Reader reader{bytes};
+    if (reader.readU32() != kReflectionMagic || reader.readU32() != kReflectionVersion)
+        return std::nullopt;
+
+    DescriptorSetBindings sets;
+    const uint32_t setCount = reader.readU32();
+    for (uint32_t s = 0; s < setCount && reader.ok; ++s)
+    {
+        const uint32_t setIndex = reader.readU32();
+        const uint32_t bindingCount = reader.readU32();
+        auto &bindings = sets[setIndex];
+        for (uint32_t b = 0; b < bindingCount && reader.ok; ++b)
+        {
+            vkcore::DescriptorBindingInfo binding{};
+            binding.name = reader.readString(reader.readU32());
+            binding.binding = reader.readU32();
+            binding.descriptorType = static_cast<vk::DescriptorType>(reader.readU32());
+            binding.descriptorCount = reader.readU32();
+            binding.stageFlags = static_cast<vk::ShaderStageFlags>(reader.readU32());
+            bindings.push_back(std::move(binding));
+        }
+    }
+
+    if (!reader.ok || reader.offset != bytes.size())
+        return std::nullopt;
+    return sets;
+}
+
+} // namespace asset
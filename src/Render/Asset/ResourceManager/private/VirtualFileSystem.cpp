@@ -0,0 +1,125 @@
+#include "VirtualFileSystem.hpp"
+#include "Trace.hpp"
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+namespace asset
+{
+
+void VirtualFileSystem::mount(const std::filesystem::path &packageFile, const std::filesystem::path &mountRoot)
+{
+    auto package = std::make_shared<const AssetPackage>(packageFile);
+    std::unique_lock lock(m_mutex);
+    m_mounts.push_back({normalize(mountRoot), std::move(package)});
+}
+
+void VirtualFileSystem::unmountAll()
+{
+    std::unique_lock lock(m_mutex);
+    m_mounts.clear();
+}
+
+bool VirtualFileSystem::hasMounts() const
+{
+    std::shared_lock lock(m_mutex);
+    return !m_mounts.empty();
+}
+
+bool VirtualFileSystem::exists(const std::filesystem::path &path) const
+{
+    {
+        std::shared_lock lock(m_mutex);
+        if (!m_mounts.empty())
+        {
+            const std::string normalized = normalize(path);
+            for (auto it = m_mounts.rbegin(); it != m_mounts.rend(); ++it)
+            {
+                if (normalized == it->root)
+                    return true;
+                const std::string packagePath = toPackagePath(*it, normalized);
+                if (!packagePath.empty() &&
+                    (it->package->find(packagePath) || it->package->containsDirectory(packagePath)))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    std::error_code ec;
+    return std::filesystem::exists(path, ec);
+}
+
+FileBlob VirtualFileSystem::readFile(const std::filesystem::path &path) const
+{
+    TRACE_SCOPE_NAMED(traceZone, "VFS::readFile");
+    TRACE_SET_DETAIL(traceZone, path.string());
+    {
+        std::shared_lock lock(m_mutex);
+        if (!m_mounts.empty())
+        {
+            const std::string normalized = normalize(path);
+            for (auto it = m_mounts.rbegin(); it != m_mounts.rend(); ++it)
+            {
+                const std::string packagePath = toPackagePath(*it, normalized);
+                if (packagePath.empty())
+                    continue;
+                if (const PackageEntry *entry = it->package->find(packagePath))
+                {
+                    TRACE_SET_BYTES(traceZone, entry->storedSize);
+                    if (auto view = it->package->view(*entry))
+                    {
+                        return FileBlob(*view, it->package);
+                    }
+                    return FileBlob(it->package->read(*entry));
+                }
+            }
+        }
+    }
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open file: " + path.string());
+    }
+    std::vector<uint8_t> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file)
+    {
+        throw std::runtime_error("Failed to read file: " + path.string());
+    }
+    TRACE_SET_BYTES(traceZone, bytes.size());
+    return FileBlob(std::move(bytes));
+}
+
+std::string VirtualFileSystem::toPackagePath(const Mount &mount, const std::string &path)
+{
+    if (path.size() <= mount.root.size() || path.compare(0, mount.root.size(), mount.root) != 0)
+    {
+        return {};
+    }
+    // 根目录本身以 '/' 结尾（如 "/" 或 "C:/"）时不再额外跳过分隔符
+    if (mount.root.back() == '/')
+    {
+        return path.substr(mount.root.size());
+    }
+    if (path[mount.root.size()] != '/')
+    {
+        return {};
+    }
+    return path.substr(mount.root.size() + 1);
+}
+
+std::string VirtualFileSystem::normalize(const std::filesystem::path &path)
+{
+    std::string normalized = std::filesystem::absolute(path).lexically_normal().generic_string();
+    // 目录路径可能带有结尾分隔符
+    while (normalized.size() > 1 && normalized.back() == '/' && normalized[normalized.size() - 2] != ':')
+    {
+        normalized.pop_back();
+    }
+    return normalized;
+}
+
+} // namespace asset
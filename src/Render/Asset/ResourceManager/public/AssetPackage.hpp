@@ -0,0 +1,204 @@
+/**
+ * @file AssetPackage.hpp
+ * @author Summer
+ * @brief 单文件资源包（.rpak）的格式定义、构建器与只读映射
+ *
+ * 文件布局（小端序）：
+ * - PackageHeader：位于文件开头
+ * - 条目数据：每个条目按 4KB 对齐，可单独使用 LZ4 压缩
+ * - 目录表（TOC）：PackageEntry 数组，按路径哈希（FNV-1a）排序，位于数据之后
+ * - 字符串表：条目的包内相对路径（'/' 分隔），用于哈希冲突时比对
+ *
+ * 读取时整个文件只映射一次，未压缩条目可直接引用映射内存，无需额外的打开文件与读取调用。
+ *
+ * @version 1.0
+ * @date 2025-11-28
+ */
+
+#pragma once
+
+#include "VkUtils.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace asset
+{
+
+/// 包内路径哈希与其他缓存键共用VkUtils中的 64 位 FNV-1a 实现
+using vkcore::VkUtils::fnv1a64;
+
+/**
+ * @enum PackageCompression
+ * @brief 条目的压缩方式
+ */
+enum class PackageCompression : uint32_t
+{
+    None = 0, ///< 未压缩，可直接引用映射内存
+    LZ4 = 1   ///< LZ4 块压缩，读取时解压
+};
+
+/**
+ * @struct PackageHeader
+ * @brief 资源包文件头
+ */
+struct PackageHeader
+{
+    static constexpr uint32_t kMagic = 0x4B415052; ///< "RPAK"
+    static constexpr uint32_t kVersion = 1;
+
+    uint32_t magic = kMagic;        ///< 魔数
+    uint32_t version = kVersion;    ///< 格式版本
+    uint32_t entryCount = 0;        ///< 条目数量
+    uint32_t alignment = 4096;      ///< 条目数据对齐
+    uint64_t tocOffset = 0;         ///< 目录表偏移
+    uint64_t stringTableOffset = 0; ///< 字符串表偏移
+    uint64_t stringTableSize = 0;   ///< 字符串表大小
+};
+
+/**
+ * @struct PackageEntry
+ * @brief 目录表中的一个条目
+ */
+struct PackageEntry
+{
+    uint64_t pathHash = 0;                                     ///< 包内相对路径的 FNV-1a 哈希
+    uint64_t offset = 0;                                       ///< 数据在文件中的偏移
+    uint64_t storedSize = 0;                                   ///< 文件中存储的字节数（压缩后）
+    uint64_t size = 0;                                         ///< 原始字节数
+    uint32_t pathOffset = 0;                                   ///< 路径在字符串表中的偏移
+    uint32_t pathLength = 0;                                   ///< 路径长度
+    PackageCompression compression = PackageCompression::None; ///< 压缩方式
+    uint32_t reserved = 0;                                     ///< 保留
+};
+
+static_assert(sizeof(PackageHeader) == 40, "PackageHeader layout must be stable");
+static_assert(sizeof(PackageEntry) == 48, "PackageEntry layout must be stable");
+
+/**
+ * @class AssetPackageBuilder
+ * @brief 资源包构建器（离线打包使用）
+ *
+ * @details
+ * - 条目以包内相对路径（'/' 分隔）标识，挂载时相对于挂载根目录解析
+ * - 启用压缩时只有压缩后更小的条目才会以 LZ4 存储；未启用 ENABLE_LZ4_PACKAGES 时始终不压缩
+ */
+class AssetPackageBuilder
+{
+  public:
+    /**
+     * @brief 添加单个文件
+     * @param packagePath 包内相对路径
+     * @param sourceFile 磁盘上的源文件
+     * @param compress 是否尝试压缩
+     */
+    void addFile(const std::string &packagePath, const std::filesystem::path &sourceFile, bool compress = false);
+
+    /**
+     * @brief 递归添加目录中的所有文件，包内路径为相对于该目录的路径
+     * @param directory 源目录
+     * @param compress 是否尝试压缩
+     * @return 添加的文件数量
+     */
+    size_t addDirectory(const std::filesystem::path &directory, bool compress = false);
+
+    /**
+     * @brief 写出资源包
+     * @param outputFile 输出文件路径
+     */
+    void write(const std::filesystem::path &outputFile) const;
+
+  private:
+    struct Source
+    {
+        std::string packagePath;
+        std::filesystem::path file;
+        bool compress = false;
+    };
+
+    std::vector<Source> m_sources;
+};
+
+/**
+ * @class AssetPackage
+ * @brief 以内存映射方式打开的只读资源包
+ *
+ * @details 打开后不可修改，可被多个线程并发读取
+ */
+class AssetPackage
+{
+  public:
+    /**
+     * @brief 映射并校验资源包
+     * @param packageFile 资源包文件路径
+     * @throws std::runtime_error 文件无法映射或格式无效
+     */
+    explicit AssetPackage(const std::filesystem::path &packageFile);
+    ~AssetPackage();
+
+    AssetPackage(const AssetPackage &) = delete;
+    AssetPackage &operator=(const AssetPackage &) = delete;
+
+    /**
+     * @brief 查找条目
+     * @param packagePath 包内相对路径
+     * @return 条目指针，不存在时返回 nullptr
+     */
+    const PackageEntry *find(std::string_view packagePath) const;
+
+    /**
+     * @brief 包内是否存在该目录（即存在以其为前缀的条目）
+     */
+    bool containsDirectory(std::string_view packagePath) const;
+
+    /**
+     * @brief 直接引用未压缩条目的映射内存
+     * @return 数据视图，条目被压缩时返回 std::nullopt
+     */
+    std::optional<std::span<const uint8_t>> view(const PackageEntry &entry) const;
+
+    /**
+     * @brief 读取条目内容（必要时解压）
+     */
+    std::vector<uint8_t> read(const PackageEntry &entry) const;
+
+    /**
+     * @brief 条目的包内相对路径
+     */
+    std::string_view getPath(const PackageEntry &entry) const;
+
+    /**
+     * @brief 所有条目（按路径哈希排序）
+     */
+    std::span<const PackageEntry> getEntries() const
+    {
+        return {m_entries, m_header.entryCount};
+    }
+
+    const std::filesystem::path &getFilePath() const
+    {
+        return m_filePath;
+    }
+
+  private:
+    void map(const std::filesystem::path &packageFile);
+    void unmap();
+    void validate();
+
+    std::filesystem::path m_filePath;
+    const uint8_t *m_data = nullptr;               ///< 映射的文件内容
+    size_t m_size = 0;                             ///< 映射大小
+    void *m_mappingHandle = nullptr;               ///< Windows 下的文件映射句柄
+    PackageHeader m_header{};                      ///< 文件头
+    const PackageEntry *m_entries = nullptr;       ///< 映射中的目录表
+    const char *m_strings = nullptr;               ///< 映射中的字符串表
+    std::unordered_set<std::string> m_directories; ///< 包内包含的目录
+};
+
+} // namespace asset
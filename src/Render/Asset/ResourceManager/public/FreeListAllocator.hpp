@@ -0,0 +1,106 @@
+/**
+ * @file FreeListAllocator.hpp
+ * @author Summer
+ * @brief 基于空闲链表的区间子分配器
+ *
+ * 在一段固定容量的线性空间中分配与回收区间，不涉及任何GPU资源，
+ * 用于在大缓冲中划分子范围（如几何池的顶点/索引空间）。
+ *
+ * @version 1.0
+ * @date 2025-11-27
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <unordered_map>
+
+namespace asset
+{
+
+/**
+ * @struct FreeListStats
+ * @brief 子分配器的占用与碎片统计
+ */
+struct FreeListStats
+{
+    uint64_t capacity = 0;         ///< 总容量
+    uint64_t used = 0;             ///< 已分配的容量
+    uint64_t allocationCount = 0;  ///< 已分配的区间数量
+    uint64_t freeBlockCount = 0;   ///< 空闲块数量
+    uint64_t largestFreeBlock = 0; ///< 最大空闲块
+    float fragmentation = 0.0f;    ///< 碎片率：1 - 最大空闲块 / 空闲总量，0表示空闲空间完全连续
+};
+
+/**
+ * @class FreeListAllocator
+ * @brief 最佳适配的区间分配器
+ *
+ * @details
+ * - 空闲块同时按偏移和按大小索引：分配时取能容纳请求的最小空闲块，释放时与相邻空闲块合并
+ * - 分配与释放均为 O(log n)
+ * - 非线程安全，由调用者加锁
+ */
+class FreeListAllocator
+{
+  public:
+    /**
+     * @brief 创建分配器
+     * @param capacity 可分配的总容量（单位由调用者决定，如字节或元素个数）
+     */
+    explicit FreeListAllocator(uint64_t capacity = 0);
+
+    /**
+     * @brief 分配区间
+     * @param size 区间大小，必须大于0
+     * @param alignment 起始偏移的对齐要求，必须大于0
+     * @return 区间起始偏移，空间不足时返回 std::nullopt
+     */
+    std::optional<uint64_t> allocate(uint64_t size, uint64_t alignment = 1);
+
+    /**
+     * @brief 释放区间
+     * @param offset allocate() 返回的偏移
+     * @return true 如果偏移对应一个已分配的区间
+     */
+    bool free(uint64_t offset);
+
+    /**
+     * @brief 释放所有区间
+     */
+    void reset();
+
+    /**
+     * @brief 获取统计信息
+     */
+    FreeListStats getStats() const;
+
+    uint64_t getCapacity() const
+    {
+        return m_capacity;
+    }
+
+  private:
+    using OffsetMap = std::map<uint64_t, uint64_t>;    ///< 偏移 -> 大小
+    using SizeMap = std::multimap<uint64_t, uint64_t>; ///< 大小 -> 偏移
+
+    /// 已分配区间在空闲链表中占用的块（含对齐填充）
+    struct Block
+    {
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    void insertFreeBlock(uint64_t offset, uint64_t size);
+    void eraseFreeBlock(OffsetMap::iterator it);
+
+    uint64_t m_capacity = 0;
+    uint64_t m_used = 0;
+    OffsetMap m_freeByOffset;                        ///< 空闲块（按偏移排序，用于合并）
+    SizeMap m_freeBySize;                            ///< 空闲块（按大小排序，用于最佳适配）
+    std::unordered_map<uint64_t, Block> m_allocated; ///< 对齐后的起始偏移 -> 占用块
+};
+
+} // namespace asset
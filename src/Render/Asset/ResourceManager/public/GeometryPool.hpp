@@ -0,0 +1,175 @@
+/**
+ * @file GeometryPool.hpp
+ * @author Summer
+ * @brief 全局几何池：所有网格共享一个顶点缓冲和一个索引缓冲
+ *
+ * 该文件提供了网格几何数据的统一存放方式，包括：
+ * - GeometryPoolStats：池的占用与碎片统计
+ * - GeometryPool：在两个大缓冲中子分配网格范围并负责上传，并提供间接绘制缓冲
+ *
+ * 所有从池中分配的网格只需绑定一次顶点/索引缓冲，
+ * 绘制参数合并为间接命令后由一次 drawIndexedIndirect 提交。
+ *
+ * @version 1.0
+ * @date 2025-11-27
+ */
+
+#pragma once
+
+#include "FreeListAllocator.hpp"
+#include "GpuResource.hpp"
+#include "ResourceType.hpp"
+#include "TransferManager.hpp"
+#include "VkResource.hpp"
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace asset
+{
+
+/**
+ * @struct GeometryPoolConfig
+ * @brief 几何池容量配置
+ */
+struct GeometryPoolConfig
+{
+    uint32_t vertexCapacity = 2u * 1024 * 1024; ///< 顶点容量（个）
+    uint32_t indexCapacity = 8u * 1024 * 1024;  ///< 索引容量（个，uint32）
+    uint32_t maxDrawCommands = 4096;            ///< 每帧间接绘制命令的容量
+    uint32_t framesInFlight = 3;                ///< 飞行中帧数，每帧独占一段间接缓冲
+    bool multiDrawIndirect = false;             ///< 设备已启用multiDrawIndirect时一次调用提交全部命令
+};
+
+/**
+ * @struct GeometryPoolStats
+ * @brief 几何池的占用与碎片统计
+ */
+struct GeometryPoolStats
+{
+    FreeListStats vertices; ///< 顶点空间统计（单位：顶点）
+    FreeListStats indices;  ///< 索引空间统计（单位：索引）
+};
+
+/**
+ * @class GeometryPool
+ * @brief 顶点/索引大缓冲的子分配器
+ *
+ * @details
+ * - 顶点与索引空间分别由最佳适配的空闲链表管理，释放的范围会与相邻空闲范围合并
+ * - 索引值保持网格内的局部编号，绘制时通过 vertexOffset 偏移到池中的位置
+ * - allocate/free 线程安全；释放范围前需确保没有飞行中的命令缓冲仍在引用它
+ * - 间接缓冲持久映射，按帧分段写入，只应在录制渲染命令的线程上使用
+ */
+class GeometryPool
+{
+  public:
+    /**
+     * @brief 创建几何池并分配顶点/索引缓冲
+     * @param allocator 资源分配器
+     * @param transferManager 传输管理器，用于上传几何数据
+     * @param config 容量配置
+     */
+    GeometryPool(vkcore::VkResourceAllocator &allocator, vkcore::TransferManager &transferManager,
+                 const GeometryPoolConfig &config = {});
+
+    ~GeometryPool();
+
+    GeometryPool(const GeometryPool &) = delete;
+    GeometryPool &operator=(const GeometryPool &) = delete;
+
+    /**
+     * @brief 分配顶点与索引范围
+     * @param vertexCount 顶点数量
+     * @param indexCount 索引数量
+     * @return 分配到的范围，任一空间不足时返回 std::nullopt
+     */
+    std::optional<GeometryRange> allocate(uint32_t vertexCount, uint32_t indexCount);
+
+    /**
+     * @brief 释放范围
+     * @param range allocate() 返回的范围
+     */
+    void free(const GeometryRange &range);
+
+    /**
+     * @brief 上传几何数据到已分配的范围
+     * @param range 目标范围，数据量不得超过范围大小
+     * @param vertices 顶点数据
+     * @param indices 索引数据（网格内局部编号）
+     * @return 上传令牌
+     */
+    std::vector<vkcore::TransferToken> upload(const GeometryRange &range, const std::vector<Vertex> &vertices,
+                                              const std::vector<uint32_t> &indices);
+
+    /**
+     * @brief 将几何数据的上传录制到批次中，随批次一起提交
+     * @param range 目标范围，数据量不得超过范围大小
+     * @param vertices 顶点数据
+     * @param indices 索引数据（网格内局部编号）
+     * @param batch 上传批次
+     */
+    void upload(const GeometryRange &range, const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices,
+                vkcore::UploadBatch &batch);
+
+    /**
+     * @brief 绑定池的顶点与索引缓冲
+     * @param commandBuffer 命令缓冲
+     */
+    void bind(vk::CommandBuffer commandBuffer) const;
+
+    /**
+     * @brief 生成子网格的间接绘制命令
+     * @param submesh 子网格（偏移为池中的绝对位置）
+     * @param instanceCount 实例数量
+     * @param firstInstance 起始实例
+     */
+    static vk::DrawIndexedIndirectCommand makeDrawCommand(const GpuSubmesh &submesh, uint32_t instanceCount = 1,
+                                                          uint32_t firstInstance = 0);
+
+    /**
+     * @brief 将间接命令写入当前帧的间接缓冲区域并录制绘制
+     * @param commandBuffer 命令缓冲（需已调用 bind() 绑定池的顶点/索引缓冲）
+     * @param frameIndex 飞行中帧的索引，各帧区域互不重叠，不会覆盖GPU仍在读取的命令
+     * @param commands 间接绘制命令（子网格偏移为池中的绝对位置），数量超出每帧容量时抛出异常
+     */
+    void drawIndexedIndirect(vk::CommandBuffer commandBuffer, uint32_t frameIndex,
+                             const std::vector<vk::DrawIndexedIndirectCommand> &commands);
+
+    /**
+     * @brief 获取统计信息
+     */
+    GeometryPoolStats getStats() const;
+
+    const vkcore::ManagedBuffer &getVertexBuffer() const
+    {
+        return m_vertexBuffer;
+    }
+    const vkcore::ManagedBuffer &getIndexBuffer() const
+    {
+        return m_indexBuffer;
+    }
+    const vkcore::ManagedBuffer &getIndirectBuffer() const
+    {
+        return m_indirectBuffer;
+    }
+
+  private:
+    vkcore::VkResourceAllocator *m_allocator = nullptr;
+    vkcore::TransferManager *m_transferManager = nullptr;
+    vkcore::ManagedBuffer m_vertexBuffer;   ///< 共享顶点缓冲
+    vkcore::ManagedBuffer m_indexBuffer;    ///< 共享索引缓冲
+    vkcore::ManagedBuffer m_indirectBuffer; ///< 间接命令缓冲，framesInFlight段，每段maxDrawCommands条
+    uint8_t *m_indirectMapped = nullptr;    ///< 间接缓冲的持久映射地址
+    uint32_t m_maxDrawCommands = 0;
+    uint32_t m_framesInFlight = 0;
+    bool m_multiDrawIndirect = false;
+
+    mutable std::mutex m_mutex;       ///< 保护两个子分配器
+    FreeListAllocator m_vertexRanges; ///< 顶点空间（单位：顶点）
+    FreeListAllocator m_indexRanges;  ///< 索引空间（单位：索引）
+};
+
+} // namespace asset
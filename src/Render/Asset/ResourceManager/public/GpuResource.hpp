@@ -0,0 +1,102 @@
+/**
+ * @file GpuResource.hpp
+ * @author Summer
+ * @brief 资源管理器持有的GPU常驻资源
+ *
+ * 该文件定义了网格与纹理上传到GPU后的表示，包括：
+ * - GpuSubmesh：合并顶点/索引缓冲中某个子网格的范围
+ * - GeometryRange：网格在几何池中占用的顶点/索引范围
+ * - GpuMesh：一个网格资源的顶点/索引缓冲（独立缓冲或几何池中的范围）
+ * - GpuTexture：一个纹理资源的图像
+ *
+ * @version 1.0
+ * @date 2025-11-26
+ */
+
+#pragma once
+
+#include "VkResource.hpp"
+#include <cstdint>
+#include <vector>
+#include <vulkan/vulkan.hpp>
+
+namespace asset
+{
+
+/**
+ * @struct GpuSubmesh
+ * @brief 子网格在合并缓冲中的范围，可直接用于 drawIndexed
+ */
+struct GpuSubmesh
+{
+    uint32_t firstIndex = 0;  ///< 起始索引
+    uint32_t indexCount = 0;  ///< 索引数量
+    int32_t vertexOffset = 0; ///< 顶点偏移（加到索引值上）
+    uint32_t vertexCount = 0; ///< 顶点数量
+};
+
+/**
+ * @struct GeometryRange
+ * @brief 网格在几何池中占用的范围（单位均为元素个数）
+ */
+struct GeometryRange
+{
+    uint32_t vertexOffset = 0; ///< 起始顶点
+    uint32_t vertexCount = 0;  ///< 顶点数量
+    uint32_t firstIndex = 0;   ///< 起始索引
+    uint32_t indexCount = 0;   ///< 索引数量
+
+    bool isValid() const
+    {
+        return vertexCount > 0;
+    }
+};
+
+class GeometryPool;
+
+/**
+ * @struct GpuMesh
+ * @brief 网格资源的GPU表示：所有子网格共享一个顶点缓冲和一个索引缓冲
+ *
+ * @details
+ * 从几何池分配时 vertexBuffer/indexBuffer 为空，子网格的偏移是池中的绝对位置，
+ * 绘制前绑定池的缓冲即可；析构时自动把范围归还给几何池。
+ */
+struct GpuMesh
+{
+    vkcore::ManagedBuffer vertexBuffer; ///< 独立顶点缓冲（使用几何池时为空）
+    vkcore::ManagedBuffer indexBuffer;  ///< 独立索引缓冲（uint32，使用几何池时为空）
+    std::vector<GpuSubmesh> submeshes;  ///< 子网格范围，与 MeshData 顺序一致
+    uint32_t totalIndexCount = 0;       ///< 索引总数
+    uint32_t totalVertexCount = 0;      ///< 顶点总数
+
+    GeometryPool *pool = nullptr; ///< 所属几何池
+    GeometryRange poolRange;      ///< 在几何池中占用的范围
+
+    GpuMesh() = default;
+    GpuMesh(const GpuMesh &) = delete;
+    GpuMesh &operator=(const GpuMesh &) = delete;
+    ~GpuMesh();
+
+    /**
+     * @brief 是否存放在几何池中
+     */
+    bool isPooled() const
+    {
+        return pool != nullptr;
+    }
+};
+
+/**
+ * @struct GpuTexture
+ * @brief 纹理资源的GPU表示，上传完成后处于 ShaderReadOnlyOptimal 布局
+ */
+struct GpuTexture
+{
+    vkcore::ManagedImage image; ///< 图像及默认视图
+    uint32_t width = 0;         ///< 宽度
+    uint32_t height = 0;        ///< 高度
+    uint32_t mipLevels = 1;     ///< Mip层级数量
+};
+
+} // namespace asset
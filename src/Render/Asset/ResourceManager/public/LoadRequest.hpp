@@ -0,0 +1,246 @@
+/**
+ * @file LoadRequest.hpp
+ * @author Summer
+ * @brief 带优先级、可取消的异步资源加载请求与调度器
+ *
+ * 该文件提供了异步加载的基础设施，包括：
+ * - LoadPriority：加载优先级（可见资源优先于预取资源）
+ * - LoadRequest：加载请求句柄，可查询状态、调整优先级或取消
+ * - LoadScheduler：固定数量工作线程的优先级调度器
+ *
+ * @version 1.0
+ * @date 2025-11-26
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace asset
+{
+
+/**
+ * @enum LoadPriority
+ * @brief 加载请求优先级，数值越大越先被调度
+ */
+enum class LoadPriority : uint8_t
+{
+    Prefetch = 0, ///< 预取：当前不需要，空闲时再加载
+    Normal = 1,   ///< 普通优先级（默认）
+    Visible = 2   ///< 当前帧可见，需要尽快加载
+};
+
+/**
+ * @enum LoadStatus
+ * @brief 加载请求的生命周期状态
+ */
+enum class LoadStatus : uint8_t
+{
+    Pending,   ///< 已排队，尚未开始
+    Running,   ///< 正在工作线程中执行
+    Completed, ///< 已成功完成
+    Failed,    ///< 执行过程中抛出异常
+    Cancelled  ///< 在开始执行前被取消
+};
+
+/**
+ * @class LoadCancelledError
+ * @brief 请求被取消时，通过 future 抛出的异常类型
+ */
+class LoadCancelledError : public std::runtime_error
+{
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+class LoadScheduler;
+
+/**
+ * @class LoadRequest
+ * @brief 异步加载请求句柄
+ *
+ * @details
+ * 句柄之间共享同一个请求状态（可拷贝）。同一资源的重复请求通过 share() 登记为新的持有者，
+ * 拷贝句柄则与原句柄属于同一个持有者。
+ * - 取消按持有者计数：只有全部持有者都调用 cancel() 后请求才真正被取消，
+ *   低优先级调用者的取消不会影响仍需要该资源的其他调用者
+ * - 取消只对尚未开始的请求生效，被取消的请求不会访问磁盘，
+ *   其 future 会抛出 LoadCancelledError
+ * - setPriority() 只对尚未开始的请求生效
+ */
+class LoadRequest
+{
+  public:
+    LoadRequest() = default;
+
+    /**
+     * @brief 创建一个已完成的请求（用于资源已在缓存中的情况）
+     * @param resourceId 资源标识符
+     */
+    static LoadRequest makeCompleted(std::string resourceId);
+
+    /**
+     * @brief 句柄是否关联了请求
+     */
+    bool isValid() const
+    {
+        return m_state != nullptr;
+    }
+
+    /**
+     * @brief 获取结果 future，可通过 get() 获取资源标识符
+     */
+    std::shared_future<std::string> getFuture() const;
+
+    /**
+     * @brief 获取当前优先级
+     */
+    LoadPriority getPriority() const;
+
+    /**
+     * @brief 获取当前状态
+     */
+    LoadStatus getStatus() const;
+
+    /**
+     * @brief 调整优先级（仅对尚未开始的请求生效）
+     * @param priority 新的优先级
+     */
+    void setPriority(LoadPriority priority);
+
+    /**
+     * @brief 仅在新优先级更高时调整优先级
+     * @param priority 期望的最低优先级
+     */
+    void raisePriority(LoadPriority priority);
+
+    /**
+     * @brief 为同一请求登记一个新的持有者（用于重复请求的去重）
+     * @return LoadRequest 新持有者的句柄；全部持有者都已取消时返回无效句柄，调用方应重新提交
+     */
+    LoadRequest share() const;
+
+    /**
+     * @brief 撤销本持有者对请求的需要，最后一个持有者撤销时取消请求
+     * @return true 如果请求在开始前被成功取消；false 如果仍有其他持有者、已开始、已完成或本持有者已取消过
+     */
+    bool cancel();
+
+    /**
+     * @brief 请求是否已被取消
+     */
+    bool isCancelled() const
+    {
+        return getStatus() == LoadStatus::Cancelled;
+    }
+
+    bool operator==(const LoadRequest &other) const
+    {
+        return m_state == other.m_state;
+    }
+
+  private:
+    friend class LoadScheduler;
+
+    struct State;
+    explicit LoadRequest(std::shared_ptr<State> state)
+        : m_state(std::move(state)), m_holderCancelled(std::make_shared<std::atomic<bool>>(false))
+    {
+    }
+
+    /**
+     * @brief 无视持有者计数直接取消（调度器关闭时使用）
+     */
+    static bool cancelState(State &state);
+
+    std::shared_ptr<State> m_state;
+    std::shared_ptr<std::atomic<bool>> m_holderCancelled; ///< 本持有者是否已撤销（拷贝之间共享）
+};
+
+/**
+ * @class LoadScheduler
+ * @brief 按优先级调度加载任务的工作线程池
+ *
+ * @details
+ * 每个优先级对应一个FIFO队列，工作线程总是先取最高优先级的任务。
+ * 调整优先级时请求会被重新放入新的队列，旧队列中的条目在出队时被跳过。
+ *
+ * @note 任务中不应阻塞等待同一调度器中的其他任务，否则可能耗尽工作线程
+ */
+class LoadScheduler
+{
+  public:
+    /**
+     * @brief 创建调度器并启动工作线程
+     * @param workerCount 工作线程数量，0表示根据硬件并发数自动选择
+     */
+    explicit LoadScheduler(uint32_t workerCount = 0);
+
+    /**
+     * @brief 析构函数，自动调用shutdown()
+     */
+    ~LoadScheduler();
+
+    LoadScheduler(const LoadScheduler &) = delete;
+    LoadScheduler &operator=(const LoadScheduler &) = delete;
+
+    /**
+     * @brief 提交加载任务
+     * @param work 加载逻辑，返回资源标识符
+     * @param priority 优先级
+     * @return LoadRequest 请求句柄；调度器已关闭时返回一个已取消的请求
+     */
+    LoadRequest submit(std::function<std::string()> work, LoadPriority priority = LoadPriority::Normal);
+
+    /**
+     * @brief 停止调度器：取消所有未开始的请求，并等待正在执行的请求结束
+     */
+    void shutdown();
+
+  private:
+    friend class LoadRequest;
+
+    static constexpr size_t kPriorityCount = 3;
+
+    /// 工作线程与请求句柄共享的队列状态
+    struct Queue
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::array<std::deque<std::shared_ptr<LoadRequest::State>>, kPriorityCount> buckets;
+        bool stopping = false;
+    };
+
+    void workerLoop();
+
+    std::shared_ptr<Queue> m_queue;
+    std::vector<std::thread> m_workers;
+};
+
+/**
+ * @brief 请求的共享状态
+ */
+struct LoadRequest::State
+{
+    std::function<std::string()> work;            ///< 加载逻辑（仅由赢得状态切换的一方访问）
+    std::promise<std::string> promise;            ///< 结果承诺
+    std::shared_future<std::string> future;       ///< 结果 future
+    std::atomic<LoadPriority> priority{LoadPriority::Normal};
+    std::atomic<LoadStatus> status{LoadStatus::Pending};
+    std::atomic<uint32_t> holders{1};             ///< 尚未撤销的持有者数量，降为0时取消请求
+    std::weak_ptr<LoadScheduler::Queue> queue;    ///< 所属调度队列，用于调整优先级
+};
+
+} // namespace asset
@@ -0,0 +1,295 @@
+/**
+ * @file ResourceHandle.hpp
+ * @author Summer
+ * @brief 带代数校验的资源句柄与槽位注册表
+ *
+ * 该文件提供了渲染循环中使用的资源句柄，包括：
+ * - Handle：32位类型化句柄（20位槽位索引 + 12位代数）
+ * - SlotRegistry：按块分配的槽位数组，支持 O(1) 查找，返回的资源由调用者共同持有
+ *
+ * 字符串到句柄的解析只应在加载阶段进行，渲染循环中直接使用句柄。
+ *
+ * @version 1.0
+ * @date 2025-11-26
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace asset
+{
+
+/**
+ * @class Handle
+ * @brief 类型化的32位资源句柄
+ *
+ * @details
+ * 低20位为槽位索引，高12位为代数。槽位被释放后代数递增，
+ * 旧句柄因代数不匹配而失效。数值0保留为无效句柄。
+ *
+ * @tparam Tag 用于区分资源类型的标签类型
+ */
+template <typename Tag> class Handle
+{
+  public:
+    static constexpr uint32_t kIndexBits = 20;
+    static constexpr uint32_t kGenerationBits = 12;
+    static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+    static constexpr uint32_t kGenerationMask = (1u << kGenerationBits) - 1;
+    static constexpr uint32_t kMaxSlots = 1u << kIndexBits;
+
+    constexpr Handle() = default;
+    constexpr Handle(uint32_t index, uint32_t generation)
+        : m_value((index & kIndexMask) | ((generation & kGenerationMask) << kIndexBits))
+    {
+    }
+
+    constexpr uint32_t index() const
+    {
+        return m_value & kIndexMask;
+    }
+    constexpr uint32_t generation() const
+    {
+        return (m_value >> kIndexBits) & kGenerationMask;
+    }
+    constexpr uint32_t value() const
+    {
+        return m_value;
+    }
+    constexpr bool isValid() const
+    {
+        return m_value != 0;
+    }
+    constexpr explicit operator bool() const
+    {
+        return isValid();
+    }
+    constexpr bool operator==(const Handle &other) const
+    {
+        return m_value == other.m_value;
+    }
+    constexpr bool operator!=(const Handle &other) const
+    {
+        return m_value != other.m_value;
+    }
+
+  private:
+    uint32_t m_value = 0;
+};
+
+struct MeshTag;
+struct TextureTag;
+struct ShaderTag;
+
+using MeshHandle = Handle<MeshTag>;       ///< 网格句柄
+using TextureHandle = Handle<TextureTag>; ///< 纹理句柄
+using ShaderHandle = Handle<ShaderTag>;   ///< 着色器程序句柄
+
+/**
+ * @class SlotRegistry
+ * @brief 句柄到资源的槽位注册表
+ *
+ * @details
+ * - 槽位按块分配，块一旦分配不会移动或释放，读取无需加锁
+ * - allocate/release/update 由写锁保护，只应在加载/卸载/重新加载时调用
+ * - 槽位与资源缓存共享资源的所有权；get() 返回共享指针，
+ *   其他线程卸载、淘汰或重新加载该资源时，调用者持有的对象仍然有效
+ *
+ * @tparam T 资源类型
+ * @tparam Tag 句柄标签类型
+ */
+template <typename T, typename Tag> class SlotRegistry
+{
+  public:
+    using HandleType = Handle<Tag>;
+
+    SlotRegistry() = default;
+    ~SlotRegistry()
+    {
+        for (auto &chunk : m_chunks)
+        {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    SlotRegistry(const SlotRegistry &) = delete;
+    SlotRegistry &operator=(const SlotRegistry &) = delete;
+
+    /**
+     * @brief 为资源分配槽位
+     * @param object 资源（与资源缓存共享所有权）
+     * @return HandleType 新句柄
+     * @throws std::runtime_error 如果槽位已耗尽
+     */
+    HandleType allocate(std::shared_ptr<const T> object)
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+
+        uint32_t index = 0;
+        if (!m_freeList.empty())
+        {
+            index = m_freeList.back();
+            m_freeList.pop_back();
+        }
+        else
+        {
+            if (m_slotCount >= HandleType::kMaxSlots)
+            {
+                throw std::runtime_error("SlotRegistry: out of handle slots");
+            }
+            index = m_slotCount++;
+            auto &chunk = m_chunks[index / kChunkSize];
+            if (!chunk.load(std::memory_order_relaxed))
+            {
+                chunk.store(new Slot[kChunkSize], std::memory_order_release);
+            }
+        }
+
+        Slot &slot = slotAt(index);
+        slot.object.store(std::move(object), std::memory_order_release);
+        return HandleType(index, slot.generation.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief 释放句柄对应的槽位，旧句柄随即失效
+     * @param handle 要释放的句柄
+     * @return true 如果句柄有效并被释放
+     */
+    bool release(HandleType handle)
+    {
+        if (!handle.isValid())
+            return false;
+
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        if (handle.index() >= m_slotCount)
+            return false;
+
+        Slot &slot = slotAt(handle.index());
+        if (slot.generation.load(std::memory_order_relaxed) != handle.generation())
+            return false;
+
+        slot.object.store(nullptr, std::memory_order_release);
+        slot.generation.store(nextGeneration(handle.generation()), std::memory_order_release);
+        m_freeList.push_back(handle.index());
+        return true;
+    }
+
+    /**
+     * @brief 替换句柄对应的资源，句柄保持有效（用于重新加载）
+     * @param handle 资源句柄
+     * @param object 新的资源（与资源缓存共享所有权）
+     * @return true 如果句柄有效并被更新
+     */
+    bool update(HandleType handle, std::shared_ptr<const T> object)
+    {
+        if (!handle.isValid())
+            return false;
+
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        if (handle.index() >= m_slotCount)
+            return false;
+
+        Slot &slot = slotAt(handle.index());
+        if (slot.generation.load(std::memory_order_relaxed) != handle.generation())
+            return false;
+
+        slot.object.store(std::move(object), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief 查找句柄对应的资源（不获取写锁）
+     * @param handle 资源句柄
+     * @return 资源的共享指针，句柄无效或已失效时返回nullptr；持有期间资源不会被释放
+     */
+    std::shared_ptr<const T> get(HandleType handle) const
+    {
+        if (!handle.isValid())
+            return nullptr;
+
+        const Slot *chunk = m_chunks[handle.index() / kChunkSize].load(std::memory_order_acquire);
+        if (!chunk)
+            return nullptr;
+
+        // 读取前后代数一致，说明取到的指针属于该句柄（释放时先清指针再递增代数）
+        const Slot &slot = chunk[handle.index() % kChunkSize];
+        if (slot.generation.load(std::memory_order_acquire) != handle.generation())
+            return nullptr;
+        std::shared_ptr<const T> object = slot.object.load(std::memory_order_acquire);
+        if (slot.generation.load(std::memory_order_acquire) != handle.generation())
+            return nullptr;
+        return object;
+    }
+
+    /**
+     * @brief 句柄是否仍然有效
+     */
+    bool isAlive(HandleType handle) const
+    {
+        return get(handle) != nullptr;
+    }
+
+    /**
+     * @brief 释放所有槽位，所有已发放的句柄失效
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+        m_freeList.clear();
+        for (uint32_t i = m_slotCount; i-- > 0;)
+        {
+            Slot &slot = slotAt(i);
+            if (slot.object.load(std::memory_order_relaxed))
+            {
+                slot.object.store(nullptr, std::memory_order_release);
+                slot.generation.store(nextGeneration(slot.generation.load(std::memory_order_relaxed)),
+                                      std::memory_order_release);
+            }
+            m_freeList.push_back(i);
+        }
+    }
+
+  private:
+    static constexpr uint32_t kChunkSize = 1024;
+    static constexpr uint32_t kChunkCount = HandleType::kMaxSlots / kChunkSize;
+
+    struct Slot
+    {
+        std::atomic<uint32_t> generation{1};          ///< 代数从1开始，保证句柄值不为0
+        std::atomic<std::shared_ptr<const T>> object; ///< 资源，释放槽位时清空
+    };
+
+    static uint32_t nextGeneration(uint32_t generation)
+    {
+        const uint32_t next = (generation + 1) & HandleType::kGenerationMask;
+        return next == 0 ? 1 : next;
+    }
+
+    Slot &slotAt(uint32_t index)
+    {
+        return m_chunks[index / kChunkSize].load(std::memory_order_relaxed)[index % kChunkSize];
+    }
+
+    std::array<std::atomic<Slot *>, kChunkCount> m_chunks{}; ///< 槽位块，按需分配
+    std::mutex m_writeMutex;                                 ///< 写锁，保护分配与释放
+    std::vector<uint32_t> m_freeList;                        ///< 空闲槽位索引
+    uint32_t m_slotCount = 0;                                ///< 已使用过的槽位数量
+};
+
+} // namespace asset
+
+template <typename Tag> struct std::hash<asset::Handle<Tag>>
+{
+    size_t operator()(const asset::Handle<Tag> &handle) const noexcept
+    {
+        return std::hash<uint32_t>{}(handle.value());
+    }
+};
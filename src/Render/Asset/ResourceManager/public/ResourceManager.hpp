@@ -16,10 +16,21 @@
 
 #pragma once
 
+#include "GeometryPool.hpp"
+#include "GpuResource.hpp"
+#include "LoadRequest.hpp"
+#include "ResourceHandle.hpp"
 #include "ResourceManagerUtils.hpp"
 #include "ResourceType.hpp"
+#include "ShaderReflectionCache.hpp"
+#include "ShaderCompiler.hpp"
+#include "SnapshotMap.hpp"
+#include "TransferManager.hpp"
+#include "VirtualFileSystem.hpp"
 #include <array>
+#include <atomic>
 #include <filesystem>
+#include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
@@ -43,6 +54,45 @@ class VkContext;
 namespace asset
 {
 
+/**
+ * @struct ResourceManagerConfig
+ * @brief 资源管理器配置
+ */
+struct ResourceManagerConfig
+{
+    size_t meshCacheBudget = 256ull * 1024 * 1024;    ///< 网格缓存预算（字节），0表示不限制
+    size_t textureCacheBudget = 512ull * 1024 * 1024; ///< 纹理缓存预算（字节），0表示不限制
+    std::filesystem::path reflectionCacheDir; ///< SPIR-V反射结果的磁盘缓存目录，为空时仅缓存在内存中
+    std::filesystem::path shaderCacheDir;     ///< 运行时编译的SPIR-V缓存目录，为空时每次重新编译
+};
+
+/**
+ * @struct CacheStats
+ * @brief 资源缓存统计信息
+ */
+struct CacheStats
+{
+    uint64_t hits = 0;           ///< 命中次数
+    uint64_t misses = 0;         ///< 未命中次数
+    uint64_t evictions = 0;      ///< 淘汰次数
+    uint64_t cpuReleases = 0;    ///< GPU常驻条目因预算释放CPU数据的次数
+    size_t entryCount = 0;       ///< 当前条目数量
+    size_t residentBytes = 0;    ///< 当前CPU侧占用字节数（预算按此计算）
+    size_t gpuResidentBytes = 0; ///< 已发布GPU数据的条目的源数据字节数
+    size_t budgetBytes = 0;      ///< CPU侧预算字节数，0表示不限制
+    SnapshotMapStats snapshots;  ///< 缓存快照表的写入与竞争统计
+};
+
+/**
+ * @struct FrameSignal
+ * @brief 图形帧提交时需要额外发出的帧时间线信号
+ */
+struct FrameSignal
+{
+    vk::Semaphore semaphore; ///< 帧时间线信号量
+    uint64_t value = 0;      ///< 本帧发出的值
+};
+
 /**
  * @class ResourceManager
  * @brief 资源管理器核心类，提供资源加载、缓存和管理功能
@@ -68,12 +118,11 @@ class ResourceManager
     /**
      * @brief 构造资源管理器
      * @param context Vulkan上下文引用
-     * @param allocator Vulkan资源分配器引用
-     * @param transferManager 传输管理器引用，用于数据上传和Mipmap生成
+     * @param config 资源管理器配置（缓存预算等）
      *
      * @note 资源管理器依赖这些组件的生命周期，调用者需确保它们在ResourceManager之前销毁
      */
-    ResourceManager(vkcore::VkContext &context);
+    ResourceManager(vkcore::VkContext &context, const ResourceManagerConfig &config = {});
 
     /**
      * @brief 析构函数，自动清理所有资源
@@ -124,6 +173,62 @@ class ResourceManager
      */
     std::string loadShader(const std::filesystem::path &filepath, std::string shaderName,
                            bool enableComputeShader = false);
+
+    /**
+     * @brief 从GLSL源码编译并加载着色器程序（一个宏定义组合即一个变体）
+     * @param sourceDir GLSL源码目录（如 assets/shaders/code）
+     * @param shaderName 着色器名称，会编译 shaderName.vert 与 shaderName.frag
+     * @param defines 宏定义，为空时即默认变体
+     * @param enableComputeShader 是否同时编译 shaderName.comp
+     * @return std::string 资源标识符（源码目录/变体名称 的归一化路径）
+     * @throws std::runtime_error 源文件不存在、编译失败或未启用shaderc
+     *
+     * @details 变体名称由ShaderCompiler::permutationName生成，同时作为描述符集布局的前缀；
+     * 编译结果按内容缓存到ResourceManagerConfig::shaderCacheDir，命中时跳过编译。
+     * 编译参数随程序记录，源码变化时requestShaderReload按相同的宏定义重新编译
+     */
+    std::string loadShaderFromSource(const std::filesystem::path &sourceDir, const std::string &shaderName,
+                                     const ShaderDefines &defines = {}, bool enableComputeShader = false);
+
+    /**
+     * @brief 在加载工作线程中并行编译同一着色器的多个变体
+     * @param sourceDir GLSL源码目录
+     * @param shaderName 着色器名称
+     * @param permutations 各变体的宏定义
+     * @param enableComputeShader 是否同时编译计算着色器
+     * @param priority 加载优先级
+     * @return std::shared_future<std::vector<std::string>> 按permutations顺序返回各变体的资源标识符
+     */
+    std::shared_future<std::vector<std::string>> loadShaderPermutationsAsync(
+        const std::filesystem::path &sourceDir, const std::string &shaderName,
+        const std::vector<ShaderDefines> &permutations, bool enableComputeShader = false,
+        LoadPriority priority = LoadPriority::Normal);
+
+    /**
+     * @brief 获取运行时着色器编译统计信息
+     */
+    ShaderCompilerStats getShaderCompilerStats() const;
+
+    // ==================== 资源包 ====================
+
+    /**
+     * @brief 挂载资源包（.rpak），之后 mountRoot 下的资源优先从包中读取
+     * @param packageFile 资源包文件
+     * @param mountRoot 包内路径对应的磁盘目录
+     * @throws std::runtime_error 资源包无法打开或格式无效
+     *
+     * @note 资源标识符仍由磁盘路径决定，与资源是否来自资源包无关
+     */
+    void mountPackage(const std::filesystem::path &packageFile, const std::filesystem::path &mountRoot);
+
+    /**
+     * @brief 获取资源文件访问层（供 MaterialManager 等读取资源文件）
+     */
+    VirtualFileSystem &getFileSystem()
+    {
+        return m_fileSystem;
+    }
+
     // ==================== 异步资源加载 ====================
 
     /**
@@ -131,7 +236,7 @@ class ResourceManager
      * @param filepath 网格文件路径
      * @return std::shared_future<std::string> 异步任务，可通过future获取资源标识符
      *
-     * @note 加载在后台线程执行，不会阻塞调用线程
+     * @note 加载在后台线程执行，不会阻塞调用线程，等价于 requestMeshLoad(filepath).getFuture()
      */
     std::shared_future<std::string> loadMeshAsync(const std::filesystem::path &filepath);
 
@@ -140,7 +245,7 @@ class ResourceManager
      * @param filepath 纹理文件路径
      * @return std::shared_future<std::string> 异步任务，可通过future获取资源标识符
      *
-     * @note 加载在后台线程执行，包括GPU上传和Mipmap生成
+     * @note 加载在后台线程执行，等价于 requestTextureLoad(filepath).getFuture()
      */
     std::shared_future<std::string> loadTextureAsync(const std::filesystem::path &filepath);
 
@@ -175,6 +280,71 @@ class ResourceManager
      */
     std::shared_future<std::vector<std::string>> loadTexturesAsync(const std::vector<std::filesystem::path> &filepaths);
 
+    // ==================== 带优先级的加载请求 ====================
+
+    /**
+     * @brief 提交网格加载请求
+     * @param filepath 网格文件路径
+     * @param priority 加载优先级
+     * @return LoadRequest 请求句柄，可调整优先级或取消
+     *
+     * @note 同一资源正在加载时返回已有的请求，且只会提升其优先级；
+     * 资源已在缓存中时返回一个已完成的请求
+     */
+    LoadRequest requestMeshLoad(const std::filesystem::path &filepath, LoadPriority priority = LoadPriority::Normal);
+
+    /**
+     * @brief 提交纹理加载请求
+     * @param filepath 纹理文件路径
+     * @param priority 加载优先级
+     * @return LoadRequest 请求句柄，可调整优先级或取消
+     *
+     * @note 同一资源正在加载时返回已有的请求，且只会提升其优先级；
+     * 资源已在缓存中时返回一个已完成的请求
+     */
+    LoadRequest requestTextureLoad(const std::filesystem::path &filepath,
+                                   LoadPriority priority = LoadPriority::Normal);
+
+    /**
+     * @brief 在加载线程池中执行自定义加载任务
+     * @param work 加载逻辑，返回资源标识符
+     * @param priority 优先级
+     * @return LoadRequest 请求句柄
+     *
+     * @note 任务中不应阻塞等待同一线程池中的其他请求
+     */
+    LoadRequest submitLoadTask(std::function<std::string()> work, LoadPriority priority = LoadPriority::Normal);
+
+    // ==================== 资源重新加载 ====================
+
+    /**
+     * @brief 从磁盘重新加载已缓存的网格，并原子替换缓存条目
+     * @param resourceId 网格标识符（归一化路径）
+     * @param priority 优先级
+     * @return LoadRequest 请求句柄；资源未加载或重新加载失败时 future 抛出异常
+     *
+     * @details 句柄保持不变，旧数据（含GPU资源）延迟若干帧释放；
+     * 启用GPU常驻时新数据会重新上传，上传完成前 getGpuMesh() 返回nullptr
+     */
+    LoadRequest requestMeshReload(const std::string &resourceId, LoadPriority priority = LoadPriority::Visible);
+
+    /**
+     * @brief 从磁盘重新加载已缓存的纹理，并原子替换缓存条目
+     * @see requestMeshReload
+     */
+    LoadRequest requestTextureReload(const std::string &resourceId, LoadPriority priority = LoadPriority::Visible);
+
+    /**
+     * @brief 重新加载着色器程序的所有阶段，并原子替换缓存条目
+     * @param resourceId 着色器程序标识符（目录/着色器名 的归一化路径）
+     * @param priority 优先级
+     * @return LoadRequest 请求句柄
+     *
+     * @details 由loadShaderFromSource加载的程序按记录的宏定义重新编译GLSL源码，其余程序重新读取SPIR-V
+     * @note 描述符集布局不能改变，否则重新加载失败；使用该程序的管线需由调用者重建
+     */
+    LoadRequest requestShaderReload(const std::string &resourceId, LoadPriority priority = LoadPriority::Visible);
+
     // ==================== 资源注册与获取 ====================
 
     /**
@@ -210,6 +380,70 @@ class ResourceManager
      */
     shaderProgram getShaderprogram(const std::string &name);
 
+    // ==================== 句柄访问 ====================
+
+    /**
+     * @brief 将网格标识符解析为句柄（仅在加载阶段调用）
+     * @param name 网格标识符
+     * @return MeshHandle 网格句柄，资源不存在时返回无效句柄
+     */
+    MeshHandle getMeshHandle(const std::string &name);
+
+    /**
+     * @brief 将纹理标识符解析为句柄（仅在加载阶段调用）
+     * @param name 纹理标识符
+     * @return TextureHandle 纹理句柄，资源不存在时返回无效句柄
+     */
+    TextureHandle getTextureHandle(const std::string &name);
+
+    /**
+     * @brief 将着色器标识符或前缀解析为句柄（仅在加载阶段调用）
+     * @param name 着色器标识符或着色器前缀
+     * @return ShaderHandle 着色器句柄，资源不存在时返回无效句柄
+     */
+    ShaderHandle getShaderHandle(const std::string &name);
+
+    /**
+     * @brief 查找由同一GLSL源码编译的所有着色器程序变体
+     * @param sourceId 源码目录/着色器名（不含阶段后缀）
+     * @return 各变体的资源标识符，没有从该源码编译的程序时为空
+     */
+    std::vector<std::string> findShaderProgramsBySource(const std::string &sourceId);
+
+    /**
+     * @brief 通过句柄获取网格数据（不获取缓存锁）
+     * @param handle 网格句柄
+     * @return 网格数据，句柄失效或CPU数据已在GPU上传后被释放时返回nullptr；
+     *         持有期间其他线程卸载、淘汰或重新加载不会使其失效
+     */
+    std::shared_ptr<const std::vector<MeshData>> getMesh(MeshHandle handle) const
+    {
+        const auto entry = m_meshSlots.get(handle);
+        return entry ? touch(*entry).value.load(std::memory_order_acquire) : nullptr;
+    }
+
+    /**
+     * @brief 通过句柄获取纹理数据（不获取缓存锁）
+     * @param handle 纹理句柄
+     * @return 纹理数据，句柄失效或CPU数据已在GPU上传后被释放时返回nullptr；
+     *         持有期间其他线程卸载、淘汰或重新加载不会使其失效
+     */
+    std::shared_ptr<const TextureData> getTexture(TextureHandle handle) const
+    {
+        const auto entry = m_textureSlots.get(handle);
+        return entry ? touch(*entry).value.load(std::memory_order_acquire) : nullptr;
+    }
+
+    /**
+     * @brief 通过句柄获取着色器程序（不获取缓存锁）
+     * @param handle 着色器句柄
+     * @return 着色器程序，句柄失效时返回nullptr；着色器模块在重新加载后仍保留若干帧
+     */
+    std::shared_ptr<const shaderProgram> getShaderprogram(ShaderHandle handle) const
+    {
+        return m_shaderSlots.get(handle);
+    }
+
     // ==================== 资源卸载 ====================
 
     /**
@@ -230,6 +464,108 @@ class ResourceManager
      */
     bool unloadTexture(const std::string &name);
 
+    // ==================== 缓存预算 ====================
+
+    /**
+     * @brief 按LRU淘汰超出预算的网格与纹理
+     * @return 被淘汰的条目数量
+     *
+     * @details 预算按CPU侧字节数计算。只处理CPU数据没有外部引用且自上次调用以来未被访问的条目，
+     * 默认资源和通过registerMesh注册的网格不会被淘汰，建议每帧在渲染开始前调用一次。
+     * - 没有GPU数据的条目整体淘汰
+     * - 已发布GPU数据的条目只释放CPU数据，条目与GPU数据保留：GPU数据可能已写入描述符集，
+     *   只能通过卸载或重新加载释放；此后getMesh/getTexture返回nullptr，重新加载可恢复CPU数据
+     * - 上传尚未完成的条目不处理
+     * 被卸载、淘汰或重新加载替换的条目也在这里延迟释放：帧时间线越过其退役值后才释放（见nextFrameSignal）。
+     */
+    size_t trimCaches();
+
+    /**
+     * @brief 获取网格缓存统计信息
+     */
+    CacheStats getMeshCacheStats() const;
+
+    /**
+     * @brief 获取纹理缓存统计信息
+     */
+    CacheStats getTextureCacheStats() const;
+
+    /**
+     * @brief 获取SPIR-V反射缓存统计信息
+     */
+    ReflectionCacheStats getReflectionCacheStats() const;
+
+    // ==================== GPU常驻 ====================
+
+    /**
+     * @brief 启用GPU常驻：此后加载的网格与纹理会自动排队上传到GPU
+     * @param allocator 资源分配器，用于创建顶点/索引缓冲与图像
+     * @param transferManager 传输管理器，用于上传数据
+     * @param geometryPool 几何池（可选），提供时网格从池中子分配，池空间不足时退回独立缓冲
+     *
+     * @note 启用时已在缓存中的资源也会排队上传；分配器、传输管理器与几何池需比ResourceManager存活更久
+     */
+    void enableGpuResidency(vkcore::VkResourceAllocator &allocator, vkcore::TransferManager &transferManager,
+                            GeometryPool *geometryPool = nullptr);
+
+    /**
+     * @brief 是否已启用GPU常驻
+     */
+    bool isGpuResidencyEnabled() const
+    {
+        return m_gpuResidency.enabled.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 将排队中的上传交给传输管理器的流式队列并处理一帧，同时发布已完成的上传
+     *
+     * 每个上传批次提交时登记TransferManager::then回调，批次完成后立即发布其中的资源；
+     * 此处调用processCompletions驱动这些回调（启用完成线程时无需等待下一帧）。
+     * @return 本帧在预算内提交的流式上传请求数量
+     *
+     * @note 不会阻塞等待GPU，应每帧调用一次；超出TransferManager每帧预算的上传按优先级顺延到后续帧。
+     *       同一传输管理器的流式队列由此处理，其他模块不应在同一帧再次调用processStreamingUploads
+     */
+    size_t flushGpuUploads();
+
+    /**
+     * @brief 忽略每帧预算提交全部排队中的上传，并阻塞等待所有上传完成
+     */
+    void waitForGpuUploads();
+
+    /**
+     * @brief 为即将提交的图形帧分配帧时间线信号
+     * @return FrameSignal 该帧的图形提交需要在信号量上发出的值
+     *
+     * @details 被卸载、淘汰或替换的GPU数据记录退役时尚未提交的帧值，
+     * trimCaches在帧时间线越过该值（即可能引用它的命令缓冲都已执行完毕）后才释放。
+     * @note 每帧调用一次，并将返回的信号加入该帧的图形提交；从不调用时延迟释放的资源保留到cleanup
+     */
+    FrameSignal nextFrameSignal();
+
+    /**
+     * @brief 通过句柄获取网格的GPU数据
+     * @param handle 网格句柄
+     * @return GPU网格指针，上传尚未完成或句柄失效时返回nullptr；卸载或替换后的GPU数据延迟到GPU不再使用时释放
+     */
+    const GpuMesh *getGpuMesh(MeshHandle handle) const
+    {
+        // GPU访问不刷新访问时间：访问时间只用于决定CPU数据何时可以释放
+        const auto entry = m_meshSlots.get(handle);
+        return entry ? entry->gpuView.load(std::memory_order_acquire) : nullptr;
+    }
+
+    /**
+     * @brief 通过句柄获取纹理的GPU数据
+     * @param handle 纹理句柄
+     * @return GPU纹理指针，上传尚未完成或句柄失效时返回nullptr；卸载或替换后的GPU数据延迟到GPU不再使用时释放
+     */
+    const GpuTexture *getGpuTexture(TextureHandle handle) const
+    {
+        const auto entry = m_textureSlots.get(handle);
+        return entry ? entry->gpuView.load(std::memory_order_acquire) : nullptr;
+    }
+
     // ==================== 描述符管理 ====================
 
     /**
@@ -262,40 +598,152 @@ class ResourceManager
                                               const std::array<unsigned char, 4> &color2 = {0, 0, 0, 255});
 
   private:
+    /**
+     * @struct CacheEntry
+     * @brief 带字节数、访问时间与GPU数据的缓存条目
+     * @details 条目在各个快照之间共享，因此访问时间与GPU数据对所有读者可见
+     */
+    template <typename T, typename G> struct CacheEntry
+    {
+        using ValueType = T;
+        using GpuType = G;
+
+        mutable std::atomic<std::shared_ptr<T>> value; ///< 资源数据，GPU数据发布后可在预算压力下释放
+        size_t bytes = 0;                              ///< 资源数据字节数
+        bool pinned = false;                           ///< 是否禁止淘汰
+        mutable bool cpuReleased = false;              ///< CPU数据是否已释放（由缓存锁保护）
+        mutable std::atomic<uint64_t> lastAccess{0};   ///< 最近访问CPU数据的纪元
+
+        mutable std::unique_ptr<G> gpu;                  ///< GPU数据所有权（由GPU常驻互斥锁保护）
+        mutable std::atomic<const G *> gpuView{nullptr}; ///< 上传完成后发布的GPU数据
+        mutable std::atomic<bool> uploadScheduled{false}; ///< 是否已提交上传（上传失败时复位，可重新排队）
+        mutable std::atomic<bool> retired{false};         ///< 是否已被卸载或淘汰
+
+        /// 被重新加载替换的旧条目：本条目上传完成前继续发布其GPU数据（由GPU常驻互斥锁保护）
+        mutable std::shared_ptr<const CacheEntry> superseded;
+    };
+
+    using MeshEntry = CacheEntry<std::vector<MeshData>, GpuMesh>;
+    using TextureEntry = CacheEntry<TextureData, GpuTexture>;
+
+    /**
+     * @struct CacheCounters
+     * @brief 缓存统计计数器
+     */
+    struct CacheCounters
+    {
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> evictions{0};
+        std::atomic<uint64_t> cpuReleases{0};
+        std::atomic<size_t> bytes{0};
+    };
+
     /**
      * @struct MeshCache
      * @brief 网格资源缓存结构
-     * @details 包含已加载的网格和正在加载的网格，提供线程安全的访问
+     * @details 已加载的网格以快照形式发布，读取无需加锁；互斥锁只保护加载中的请求与句柄映射
      */
     struct MeshCache
     {
-        std::mutex mutex; ///< 互斥锁，保护缓存访问
-        std::unordered_map<std::string, std::shared_ptr<std::vector<MeshData>>> loadedMeshes; ///< 已加载的网格缓存
-        std::unordered_map<std::string, std::shared_future<std::string>> loadingMeshes; ///< 正在加载的网格任务
+        std::mutex mutex; ///< 互斥锁，保护加载请求与句柄映射，并串行化写入
+        SnapshotMap<MeshEntry> loadedMeshes;                        ///< 已加载的网格缓存
+        std::unordered_map<std::string, LoadRequest> loadingMeshes; ///< 正在加载的网格请求
+        std::unordered_map<std::string, MeshHandle> handles;        ///< 标识符到句柄的映射
+        CacheCounters counters;                                     ///< 统计计数器
+        size_t budget = 0;                                          ///< 字节预算
     };
 
     /**
      * @struct TextureCache
      * @brief 纹理资源缓存结构
-     * @details 包含已加载的纹理和正在加载的纹理，提供线程安全的访问
+     * @details 已加载的纹理以快照形式发布，读取无需加锁；互斥锁只保护加载中的请求与句柄映射
      */
     struct TextureCache
     {
-        std::mutex mutex; ///< 互斥锁，保护缓存访问
-        std::unordered_map<std::string, std::shared_ptr<TextureData>> loadedTextures;     ///< 已加载的纹理缓存
-        std::unordered_map<std::string, std::shared_future<std::string>> loadingTextures; ///< 正在加载的纹理任务
+        std::mutex mutex; ///< 互斥锁，保护加载请求与句柄映射，并串行化写入
+        SnapshotMap<TextureEntry> loadedTextures;                     ///< 已加载的纹理缓存
+        std::unordered_map<std::string, LoadRequest> loadingTextures; ///< 正在加载的纹理请求
+        std::unordered_map<std::string, TextureHandle> handles;       ///< 标识符到句柄的映射
+        CacheCounters counters;                                       ///< 统计计数器
+        size_t budget = 0;                                            ///< 字节预算
+    };
+
+    /**
+     * @struct ShaderSource
+     * @brief 从GLSL源码编译的着色器程序的编译参数
+     */
+    struct ShaderSource
+    {
+        std::filesystem::path sourceDir;  ///< GLSL源码目录
+        std::string shaderName;           ///< 着色器名称（文件名前缀）
+        ShaderDefines defines;            ///< 宏定义
+        bool enableComputeShader = false; ///< 是否包含计算着色器
     };
 
     /**
      * @struct ShaderCache
      * @brief 着色器资源缓存结构
-     * @details 包含已加载的着色器和正在加载的着色器，提供线程安全的访问
+     * @details 已加载的着色器以快照形式发布，读取无需加锁；互斥锁只保护加载中的任务与句柄映射
      */
     struct ShaderCache
     {
-        std::mutex mutex;                                             ///< 互斥锁，保护缓存访问
-        std::unordered_map<std::string, shaderProgram> loadedShaders; ///< 已加载的着色器缓存
+        std::mutex mutex;                         ///< 互斥锁，保护加载任务与句柄映射，并串行化写入
+        SnapshotMap<shaderProgram> loadedShaders; ///< 已加载的着色器缓存
         std::unordered_map<std::string, std::shared_future<std::string>> loadingShaders; ///< 正在加载的着色器任务
+        std::unordered_map<std::string, ShaderHandle> handles;                          ///< 标识符到句柄的映射
+
+        /// 从GLSL源码编译的程序的编译参数（按资源标识符），热重载据此重新编译
+        std::unordered_map<std::string, ShaderSource> sources;
+    };
+
+    /**
+     * @struct GpuResidency
+     * @brief GPU常驻状态：待上传队列、飞行中的上传与延迟释放的GPU资源
+     */
+    struct GpuResidency
+    {
+        template <typename Entry> struct InFlight
+        {
+            std::shared_ptr<const Entry> entry;           ///< 目标缓存条目
+            std::unique_ptr<typename Entry::GpuType> gpu; ///< 上传中的GPU数据
+            std::vector<vkcore::TransferToken> tokens;    ///< 上传令牌
+        };
+
+        struct PendingUpload
+        {
+            std::string resourceId;                       ///< 资源标识符
+            LoadPriority priority = LoadPriority::Normal; ///< 上传优先级
+        };
+
+        struct Retired
+        {
+            uint64_t frameValue = 0;             ///< 帧时间线达到该值后才可释放
+            std::shared_ptr<const void> entry;   ///< 被替换或卸载的缓存条目，保证已发放的裸指针在退役期内有效
+            std::unique_ptr<GpuMesh> mesh;       ///< 待释放的网格
+            std::unique_ptr<GpuTexture> texture; ///< 待释放的纹理
+        };
+
+        std::atomic<bool> enabled{false};
+        vkcore::VkResourceAllocator *allocator = nullptr;
+        vkcore::TransferManager *transferManager = nullptr;
+        GeometryPool *geometryPool = nullptr;
+
+        std::mutex mutex; ///< 保护以下所有成员以及条目中的gpu所有权
+        std::vector<PendingUpload> pendingMeshes;   ///< 待上传的网格
+        std::vector<PendingUpload> pendingTextures; ///< 待上传的纹理
+        std::vector<InFlight<MeshEntry>> inFlightMeshes;
+        std::vector<InFlight<TextureEntry>> inFlightTextures;
+        std::vector<Retired> retired; ///< 延迟释放的GPU资源
+
+        vk::Semaphore frameTimeline;         ///< 帧时间线，每帧图形提交发出递增的值
+        std::atomic<uint64_t> frameValue{0}; ///< 最近分配给图形帧的时间线值
+
+        /// 最近登记了发布回调的提交，同一批次的上传共享令牌，只登记一次
+        std::shared_ptr<vkcore::TransferToken::State> publishSubmission;
+
+        /// 流式上传回调的存活标记：请求可能在传输管理器中积压到cleanup之后，回调据此跳过
+        std::shared_ptr<std::atomic<bool>> alive = std::make_shared<std::atomic<bool>>(true);
     };
 
     /**
@@ -316,19 +764,161 @@ class ResourceManager
     };
 
   private:
-    vkcore::VkContext *m_context = nullptr; ///< Vulkan上下文指针
+    vkcore::VkContext *m_context = nullptr;  ///< Vulkan上下文指针
+    VirtualFileSystem m_fileSystem;          ///< 资源文件访问层（资源包优先，回退到磁盘）
+    ShaderReflectionCache m_reflectionCache; ///< 着色器程序反射结果缓存（按SPIR-V内容哈希）
+    ShaderCompiler m_shaderCompiler;         ///< 运行时GLSL编译器与SPIR-V缓存
 
     MeshCache m_meshCache;       ///< 网格资源缓存
     TextureCache m_textureCache; ///< 纹理资源缓存
     ShaderCache m_shaderCache;   ///< 着色器资源缓存
 
+    SlotRegistry<MeshEntry, MeshTag> m_meshSlots;          ///< 网格句柄槽位
+    SlotRegistry<TextureEntry, TextureTag> m_textureSlots; ///< 纹理句柄槽位
+    SlotRegistry<shaderProgram, ShaderTag> m_shaderSlots;  ///< 着色器句柄槽位
+
+    GpuResidency m_gpuResidency; ///< GPU常驻状态
+
+    std::atomic<uint64_t> m_accessEpoch{1}; ///< LRU访问纪元，每次trimCaches()递增
+
     vkcore::DescriptorSetLayoutCache *m_layoutCache = nullptr;  ///< 描述符集布局缓存
     vkcore::DescriptorPoolAllocator *m_poolAllocator = nullptr; ///< 描述符池分配器
 
     std::mutex m_descriptorSetMutex; ///< 互斥锁，保护描述符集缓存访问
     std::unordered_map<std::string, std::vector<vk::DescriptorSet>> m_descriptorSets; ///< 已分配的描述符集缓存
 
+    LoadScheduler m_loadScheduler; ///< 网格/纹理加载调度器（最后声明，保证最先析构）
+
   private:
+    /**
+     * @brief 记录条目的访问时间
+     * @return 条目本身
+     */
+    template <typename Entry> const Entry &touch(const Entry &entry) const
+    {
+        entry.lastAccess.store(m_accessEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return entry;
+    }
+
+    /**
+     * @brief 创建缓存条目
+     */
+    template <typename Entry>
+    std::shared_ptr<Entry> makeEntry(std::shared_ptr<typename Entry::ValueType> value, size_t bytes,
+                                     bool pinned = false) const
+    {
+        auto entry = std::make_shared<Entry>();
+        entry->value.store(std::move(value), std::memory_order_relaxed);
+        entry->bytes = bytes;
+        entry->pinned = pinned;
+        entry->lastAccess.store(m_accessEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return entry;
+    }
+
+    /**
+     * @brief 按LRU处理单个缓存中超出预算的条目：淘汰没有GPU数据的条目，释放GPU常驻条目的CPU数据（调用者需持有缓存锁）
+     * @return 被淘汰的条目数量（不含只释放CPU数据的条目）
+     */
+    template <typename Entry, typename Tag>
+    size_t evictToBudget(SnapshotMap<Entry> &loaded, std::unordered_map<std::string, Handle<Tag>> &handles,
+                         SlotRegistry<Entry, Tag> &slots, CacheCounters &counters, size_t budget, uint64_t epoch);
+
+    /**
+     * @brief 将新加入缓存的网格排队等待上传（GPU常驻未启用时无操作）
+     */
+    void queueMeshUpload(const std::string &resourceId, LoadPriority priority = LoadPriority::Normal);
+
+    /**
+     * @brief 将新加入缓存的纹理排队等待上传（GPU常驻未启用时无操作）
+     */
+    void queueTextureUpload(const std::string &resourceId, LoadPriority priority = LoadPriority::Normal);
+
+    /**
+     * @brief 条目被卸载、淘汰或替换时，将其连同GPU数据（以及仍在沿用的旧条目）移入延迟释放列表
+     */
+    void retireEntry(const std::shared_ptr<const MeshEntry> &entry);
+    void retireEntry(const std::shared_ptr<const TextureEntry> &entry);
+
+    /**
+     * @brief 将条目沿用的旧条目链连同GPU数据移入延迟释放列表（调用者需持有GPU常驻互斥锁）
+     */
+    template <typename Entry, typename RetireFn> void retireSuperseded(const Entry &entry, RetireFn retire);
+
+    /**
+     * @brief 将对象移入延迟释放列表（用于被替换的着色器程序）
+     */
+    void retireObject(std::shared_ptr<const void> object);
+
+    /**
+     * @brief 退役资源需要等待的帧时间线值：尚未提交（可能正在录制）的下一帧
+     */
+    uint64_t retireFrameValue() const
+    {
+        return m_gpuResidency.frameValue.load(std::memory_order_acquire) + 1;
+    }
+
+    /**
+     * @brief 原子替换已缓存的条目，句柄保持不变
+     * @details 旧条目已发布的GPU数据由新条目沿用，直到新条目上传完成后才延迟释放
+     * @return false 如果条目已被卸载
+     */
+    template <typename Entry, typename Tag>
+    bool replaceEntry(std::mutex &mutex, SnapshotMap<Entry> &loaded,
+                      std::unordered_map<std::string, Handle<Tag>> &handles, SlotRegistry<Entry, Tag> &slots,
+                      CacheCounters &counters, const std::string &resourceId, std::shared_ptr<Entry> entry);
+
+    /**
+     * @brief 读取着色器程序各阶段的SPIR-V并创建着色器模块
+     * @param directory 着色器目录
+     * @param shaderName 着色器名称（文件名前缀）
+     * @param enableComputeShader 是否加载计算着色器
+     * @param spirvCodes 输出各阶段的SPIR-V字节码
+     */
+    shaderProgram createShaderProgram(const std::filesystem::path &directory, const std::string &shaderName,
+                                      bool enableComputeShader, std::vector<std::vector<uint32_t>> &spirvCodes);
+
+    /**
+     * @brief 编译着色器程序各阶段的GLSL源码并创建着色器模块
+     * @param source 编译参数
+     * @param spirvCodes 输出各阶段的SPIR-V字节码
+     */
+    shaderProgram compileShaderProgram(const ShaderSource &source, std::vector<std::vector<uint32_t>> &spirvCodes);
+
+    /**
+     * @brief 由各阶段的SPIR-V创建着色器模块（顺序为顶点、片段、可选的计算）
+     */
+    shaderProgram buildShaderProgram(const std::vector<std::vector<uint32_t>> &spirvCodes, bool enableComputeShader);
+
+    /**
+     * @brief 将新加载的着色器程序以资源标识符与名称两个键登记到缓存
+     */
+    void registerShaderProgram(const std::string &resourceId, const std::string &shaderName, shaderProgram program);
+
+    /**
+     * @brief 发布已完成的上传，丢弃失败的上传并复位条目的上传标记（调用者需持有GPU常驻互斥锁）
+     * @param wait 是否阻塞等待所有飞行中的上传
+     */
+    void publishCompletedUploads(bool wait);
+
+    /**
+     * @brief 发布已完成的上传，并把排队中的上传转为传输管理器的流式上传请求
+     */
+    void scheduleGpuUploads();
+
+    /**
+     * @brief 创建网格的GPU缓冲并将上传录制到批次中
+     */
+    GpuResidency::InFlight<MeshEntry> uploadMesh(const std::string &resourceId,
+                                                 const std::shared_ptr<const MeshEntry> &entry,
+                                                 vkcore::UploadBatch &batch);
+
+    /**
+     * @brief 创建纹理的GPU图像并将上传录制到批次中
+     */
+    GpuResidency::InFlight<TextureEntry> uploadTexture(const std::string &resourceId,
+                                                       const std::shared_ptr<const TextureEntry> &entry,
+                                                       vkcore::UploadBatch &batch);
+
     /**
      * @brief 反射单个着色器模块的资源绑定信息
      *
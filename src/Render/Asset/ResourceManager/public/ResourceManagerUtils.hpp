@@ -22,6 +22,15 @@ namespace asset
 {
 struct ShaderModule;
 
+/**
+ * @brief 将文件路径归一化为资源标识符（绝对路径并消除 . 与 ..）
+ * @details 各缓存与热重载均以该结果作为键，保证同一文件只对应一个资源
+ */
+inline std::string normalizeResourcePath(const std::filesystem::path &filepath)
+{
+    return std::filesystem::absolute(filepath).lexically_normal().string();
+}
+
 // ============================================================================
 // 纯内存数据结构（不包含GPU资源）
 // ============================================================================
@@ -74,6 +83,7 @@ struct TextureData
     int height{0};                  ///< 图像高度（像素）
     int channels{0};                ///< 通道数（1=灰度, 2=灰度+alpha, 3=RGB, 4=RGBA）
     size_t dataSize{0};             ///< 数据大小（字节）
+    bool isFloat{false};            ///< 像素是否为32位浮点（HDR）
 
     /**
      * @brief 释放纹理数据（使用 stbi_image_free）
@@ -129,6 +139,18 @@ class ModelLoader
      */
     static std::vector<MeshData> loadFromFile(const std::filesystem::path &filePath, bool flipUVs = false);
 
+    /**
+     * @brief 从内存中的文件内容加载模型数据（如资源包条目）
+     * @param data 文件内容
+     * @param dataSize 字节数
+     * @param filePath 原始文件路径，用于推断格式与错误信息
+     * @param flipUVs 是否翻转 UV 坐标（默认 false）
+     * @return std::vector<MeshData> 纯内存网格数据列表
+     * @throws std::runtime_error 如果格式不支持或数据无效
+     */
+    static std::vector<MeshData> loadFromMemory(const uint8_t *data, size_t dataSize,
+                                                const std::filesystem::path &filePath, bool flipUVs = false);
+
     /**
      * @brief 从 OBJ 文件加载模型数据到内存
      * @param filePath OBJ 文件路径
@@ -168,15 +190,26 @@ class ModelLoader
                                  const glm::vec4 &color = glm::vec4(1.0f));
 
   private:
+    /**
+     * @brief 从流中解析 OBJ 数据
+     * @param sourceName 用于错误信息的来源名称
+     */
+    static std::vector<MeshData> parseOBJ(std::istream &file, const std::string &sourceName, bool flipUVs);
+
+    /**
+     * @brief 从流中解析 STL 数据（自动区分二进制与 ASCII）
+     */
+    static MeshData parseSTL(std::istream &file);
+
     /**
      * @brief 加载二进制 STL 文件
      */
-    static MeshData loadSTLBinary(std::ifstream &file);
+    static MeshData loadSTLBinary(std::istream &file);
 
     /**
      * @brief 加载 ASCII STL 文件
      */
-    static MeshData loadSTLAscii(std::ifstream &file);
+    static MeshData loadSTLAscii(std::istream &file);
 };
 
 // ============================================================================
@@ -222,7 +255,7 @@ class TextureLoader
                                     bool flipVertically = false);
 
     /**
-     * @brief 从内存加载纹理数据
+     * @brief 从内存加载纹理数据（自动检测格式，HDR 与 loadFromFile 一样返回浮点数据）
      * @param data 内存数据指针
      * @param dataSize 数据大小（字节）
      * @param desiredChannels 期望的通道数
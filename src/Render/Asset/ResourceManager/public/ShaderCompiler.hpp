@@ -0,0 +1,82 @@
+/**
+ * @file ShaderCompiler.hpp
+ * @author Summer
+ * @brief 运行时GLSL编译与按内容寻址的SPIR-V磁盘缓存
+ *
+ * 缓存键为以下内容的 FNV-1a 哈希：
+ * - 编译器版本（升级shaderc后缓存自动失效）
+ * - 着色器阶段与宏定义
+ * - 预处理后的源码（已展开 #include，头文件修改同样会使缓存失效）
+ *
+ * 每个变体对应缓存目录下的一个 `<哈希>.spv` 文件，内容即SPIR-V字节码。
+ *
+ * @version 1.0
+ * @date 2025-11-29
+ */
+
+#pragma once
+
+#include "VkUtils.hpp"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace asset
+{
+
+/**
+ * @brief 着色器变体的宏定义（名称, 值）
+ */
+using ShaderDefines = vkcore::VkUtils::ShaderDefines;
+
+/**
+ * @struct ShaderCompilerStats
+ * @brief 运行时编译统计信息
+ */
+struct ShaderCompilerStats
+{
+    uint64_t cacheHits = 0; ///< 从磁盘缓存读取的阶段数
+    uint64_t compiled = 0;  ///< 实际编译的阶段数
+};
+
+/**
+ * @class ShaderCompiler
+ * @brief 编译GLSL源码并缓存生成的SPIR-V（线程安全，可在多个工作线程中并发编译）
+ */
+class ShaderCompiler
+{
+  public:
+    /**
+     * @param cacheDirectory SPIR-V缓存目录，为空时每次都重新编译
+     */
+    explicit ShaderCompiler(std::filesystem::path cacheDirectory = {});
+
+    /**
+     * @brief 编译一个着色器阶段，缓存命中时直接返回缓存的SPIR-V
+     * @param source GLSL源码
+     * @param sourceFile 源文件路径（用于错误信息与解析 #include）
+     * @param stage 着色器阶段
+     * @param defines 宏定义
+     * @throws std::runtime_error 编译失败或未启用shaderc
+     */
+    std::vector<uint32_t> compile(const std::string &source, const std::filesystem::path &sourceFile,
+                                  vk::ShaderStageFlagBits stage, const ShaderDefines &defines);
+
+    /**
+     * @brief 生成变体名称，如 `car[ALPHA_TEST,NORMAL_MAP=1]`（宏按名称排序，与声明顺序无关）
+     */
+    static std::string permutationName(const std::string &shaderName, const ShaderDefines &defines);
+
+    ShaderCompilerStats getStats() const;
+
+  private:
+    std::filesystem::path m_cacheDirectory; ///< SPIR-V缓存目录
+    std::string m_compilerVersion;          ///< 编译器版本，参与缓存键计算
+
+    std::atomic<uint64_t> m_cacheHits{0};
+    std::atomic<uint64_t> m_compiled{0};
+};
+
+} // namespace asset
@@ -0,0 +1,93 @@
+/**
+ * @file ShaderReflectionCache.hpp
+ * @author Summer
+ * @brief 着色器程序反射结果缓存，以SPIR-V内容哈希为键
+ *
+ * 缓存的是合并、排序后的描述符集绑定（与registerSetLayout的输入一致），
+ * 命中时无需再调用spirv-reflect解析各个阶段的模块。
+ *
+ * 磁盘文件布局（小端序，每个着色器程序一个文件 `<哈希>.refl`）：
+ * - 文件头：magic、格式版本、描述符集数量
+ * - 每个描述符集：set 序号、绑定数量，随后为各绑定的名称长度、名称、binding、类型、数量与阶段
+ *
+ * @version 1.0
+ * @date 2025-11-29
+ */
+
+#pragma once
+
+#include "Descriptor.hpp"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace asset
+{
+
+/**
+ * @brief 着色器程序的描述符集绑定（set 序号 -> 按 binding 排序的绑定列表）
+ */
+using DescriptorSetBindings = std::unordered_map<uint32_t, std::vector<vkcore::DescriptorBindingInfo>>;
+
+/**
+ * @struct ReflectionCacheStats
+ * @brief 反射缓存统计信息
+ */
+struct ReflectionCacheStats
+{
+    uint64_t memoryHits = 0; ///< 内存命中次数
+    uint64_t diskHits = 0;   ///< 磁盘命中次数
+    uint64_t misses = 0;     ///< 未命中（执行了反射）次数
+    size_t entryCount = 0;   ///< 内存中的条目数量
+};
+
+/**
+ * @class ShaderReflectionCache
+ * @brief 线程安全的反射结果缓存，可选持久化到磁盘目录
+ */
+class ShaderReflectionCache
+{
+  public:
+    /**
+     * @param cacheDirectory 磁盘缓存目录，为空时仅缓存在内存中
+     */
+    explicit ShaderReflectionCache(std::filesystem::path cacheDirectory = {});
+
+    /**
+     * @brief 计算着色器程序的缓存键
+     * @param spirvCodes 各阶段的SPIR-V代码（顺序即阶段，与reflectDescriptorSetLayouts一致）
+     */
+    static uint64_t computeKey(const std::vector<std::vector<uint32_t>> &spirvCodes);
+
+    /**
+     * @brief 查找反射结果，内存未命中时尝试读取磁盘缓存
+     */
+    std::optional<DescriptorSetBindings> find(uint64_t key);
+
+    /**
+     * @brief 记录反射结果，配置了磁盘目录时同时写入磁盘
+     */
+    void store(uint64_t key, const DescriptorSetBindings &sets);
+
+    ReflectionCacheStats getStats() const;
+
+  private:
+    std::filesystem::path entryPath(uint64_t key) const;
+
+    static std::vector<uint8_t> serialize(const DescriptorSetBindings &sets);
+    static std::optional<DescriptorSetBindings> deserialize(const std::vector<uint8_t> &bytes);
+
+    std::filesystem::path m_cacheDirectory;                        ///< 磁盘缓存目录
+    mutable std::mutex m_mutex;                                    ///< 保护内存条目
+    std::unordered_map<uint64_t, DescriptorSetBindings> m_entries; ///< 内存中的反射结果
+
+    std::atomic<uint64_t> m_memoryHits{0};
+    std::atomic<uint64_t> m_diskHits{0};
+    std::atomic<uint64_t> m_misses{0};
+};
+
+} // namespace asset
@@ -0,0 +1,426 @@
+/**
+ * @file SnapshotMap.hpp
+ * @author Summer
+ * @brief 读多写少的快照式资源映射表
+ *
+ * 按键哈希分为固定数量的分片，每个分片写入时复制并原子发布新快照（RCU风格）。
+ * 读取只需原子加载所在分片的快照，不会与写入者竞争同一把锁；读者的引用计数与写入的复制量
+ * 都分散在各分片上。适用于渲染线程频繁查找、加载线程批量写入的资源缓存。
+ *
+ * @version 1.0
+ * @date 2025-11-26
+ */
+
+#pragma once
+
+#include "Trace.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace asset
+{
+
+/**
+ * @struct SnapshotMapStats
+ * @brief 快照映射表的写入统计，用于衡量写时复制的开销与写入者之间的竞争
+ */
+struct SnapshotMapStats
+{
+    uint64_t publishes = 0;       ///< 发布的新分片快照数量
+    uint64_t copiedEntries = 0;   ///< 写入时复制的条目总数（写放大，每次写入只复制一个分片）
+    uint64_t contendedWrites = 0; ///< 写锁已被其他写入者持有而等待的次数
+    double writeWaitTimeMs = 0.0; ///< 累计等待写锁的时间（毫秒）
+};
+
+/**
+ * @class SnapshotMap
+ * @brief 字符串键到共享资源的快照映射表
+ *
+ * @details
+ * - 按键哈希分为 kShardCount 个分片，每个分片独立发布快照并拥有自己的写锁
+ * - 读操作（find/contains）无需互斥锁，只加载键所在分片的不可变快照；
+ *   不同键的读者访问不同分片的控制块，引用计数不会集中在同一缓存行上
+ * - 写操作（tryEmplace/erase/clear）按分片串行化，只复制被修改的分片，
+ *   批量加载的总复制量约为 n²/(2·kShardCount)，不同分片的写入者互不等待
+ * - snapshot() 返回各分片快照的组合，可在不持锁的情况下遍历；它不是跨分片的原子快照，
+ *   遍历期间其他分片的写入可能可见也可能不可见
+ * - 旧快照由仍在使用它的读者持有，最后一个读者释放时自动回收
+ * - 写入者之间的竞争与复制量计入getStats，等待写锁的区间记录为 SnapshotMap::writeContention 追踪事件
+ *
+ * @tparam T 资源类型，表中保存 std::shared_ptr<T>
+ */
+template <typename T> class SnapshotMap
+{
+  public:
+    using ValuePtr = std::shared_ptr<T>;
+    using Map = std::unordered_map<std::string, ValuePtr>;
+
+    static constexpr size_t kShardCount = 256; ///< 分片数量（2的幂）
+
+    /**
+     * @class Snapshot
+     * @brief 各分片快照的组合，持有期间其中的条目不会被回收
+     */
+    class Snapshot
+    {
+      public:
+        /**
+         * @brief 依次遍历各分片条目的前向迭代器
+         */
+        class Iterator
+        {
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename Map::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type *;
+            using reference = const value_type &;
+
+            Iterator() = default;
+
+            reference operator*() const
+            {
+                return *m_it;
+            }
+
+            pointer operator->() const
+            {
+                return &*m_it;
+            }
+
+            Iterator &operator++()
+            {
+                ++m_it;
+                skipEmpty();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator previous = *this;
+                ++*this;
+                return previous;
+            }
+
+            bool operator==(const Iterator &other) const
+            {
+                return m_shard == other.m_shard && (m_shard == kShardCount || m_it == other.m_it);
+            }
+
+          private:
+            friend class Snapshot;
+
+            Iterator(const Snapshot *owner, size_t shard) : m_owner(owner), m_shard(shard)
+            {
+                if (m_shard < kShardCount)
+                {
+                    m_it = m_owner->m_shards[m_shard]->begin();
+                    skipEmpty();
+                }
+            }
+
+            /// 当前分片遍历完后前进到下一个非空分片
+            void skipEmpty()
+            {
+                while (m_it == m_owner->m_shards[m_shard]->end())
+                {
+                    if (++m_shard == kShardCount)
+                        return;
+                    m_it = m_owner->m_shards[m_shard]->begin();
+                }
+            }
+
+            const Snapshot *m_owner = nullptr;
+            size_t m_shard = kShardCount;
+            typename Map::const_iterator m_it{};
+        };
+
+        Iterator begin() const
+        {
+            return Iterator(this, 0);
+        }
+
+        Iterator end() const
+        {
+            return Iterator(this, kShardCount);
+        }
+
+        /**
+         * @brief 快照中的条目数量
+         */
+        size_t size() const
+        {
+            size_t count = 0;
+            for (const auto &shard : m_shards)
+            {
+                count += shard->size();
+            }
+            return count;
+        }
+
+      private:
+        friend class SnapshotMap;
+
+        std::array<std::shared_ptr<const Map>, kShardCount> m_shards;
+    };
+
+    SnapshotMap() = default;
+
+    SnapshotMap(const SnapshotMap &) = delete;
+    SnapshotMap &operator=(const SnapshotMap &) = delete;
+
+    /**
+     * @brief 获取各分片的当前快照，可在不持锁的情况下遍历
+     */
+    Snapshot snapshot() const
+    {
+        Snapshot snap;
+        for (size_t i = 0; i < kShardCount; ++i)
+        {
+            snap.m_shards[i] = m_shards[i].snapshot.load(std::memory_order_acquire);
+        }
+        return snap;
+    }
+
+    /**
+     * @brief 查找资源
+     * @param key 资源标识符
+     * @return 资源指针，不存在时返回nullptr
+     */
+    ValuePtr find(const std::string &key) const
+    {
+        auto snap = shardFor(key).snapshot.load(std::memory_order_acquire);
+        auto it = snap->find(key);
+        return it != snap->end() ? it->second : nullptr;
+    }
+
+    /**
+     * @brief 资源是否存在
+     */
+    bool contains(const std::string &key) const
+    {
+        return shardFor(key).snapshot.load(std::memory_order_acquire)->count(key) > 0;
+    }
+
+    /**
+     * @brief 当前资源数量
+     */
+    size_t size() const
+    {
+        size_t count = 0;
+        for (const auto &shard : m_shards)
+        {
+            count += shard.snapshot.load(std::memory_order_acquire)->size();
+        }
+        return count;
+    }
+
+    /**
+     * @brief 仅在键不存在时插入
+     * @param key 资源标识符
+     * @param value 资源指针
+     * @return pair<表中的资源, 是否插入>
+     */
+    std::pair<ValuePtr, bool> tryEmplace(const std::string &key, ValuePtr value)
+    {
+        Shard &shard = shardFor(key);
+        auto lock = lockWriter(shard);
+        auto current = shard.snapshot.load(std::memory_order_relaxed);
+        if (auto it = current->find(key); it != current->end())
+        {
+            return {it->second, false};
+        }
+
+        auto next = copyCurrent(shard);
+        next->emplace(key, value);
+        publish(shard, std::move(next));
+        return {std::move(value), true};
+    }
+
+    /**
+     * @brief 插入或替换资源
+     * @param key 资源标识符
+     * @param value 资源指针
+     * @return 被替换的旧资源，不存在时返回nullptr
+     */
+    ValuePtr insertOrAssign(const std::string &key, ValuePtr value)
+    {
+        Shard &shard = shardFor(key);
+        auto lock = lockWriter(shard);
+        auto next = copyCurrent(shard);
+        ValuePtr previous;
+        if (auto it = next->find(key); it != next->end())
+        {
+            previous = std::exchange(it->second, std::move(value));
+        }
+        else
+        {
+            next->emplace(key, std::move(value));
+        }
+        publish(shard, std::move(next));
+        return previous;
+    }
+
+    /**
+     * @brief 移除资源
+     * @return true 如果资源存在并被移除
+     */
+    bool erase(const std::string &key)
+    {
+        Shard &shard = shardFor(key);
+        auto lock = lockWriter(shard);
+        auto current = shard.snapshot.load(std::memory_order_relaxed);
+        if (current->find(key) == current->end())
+        {
+            return false;
+        }
+
+        auto next = copyCurrent(shard);
+        next->erase(key);
+        publish(shard, std::move(next));
+        return true;
+    }
+
+    /**
+     * @brief 批量移除资源，每个涉及的分片只发布一次新快照
+     * @return 实际移除的数量
+     */
+    size_t erase(const std::vector<std::string> &keys)
+    {
+        std::array<std::vector<const std::string *>, kShardCount> grouped;
+        for (const auto &key : keys)
+        {
+            grouped[shardIndex(key)].push_back(&key);
+        }
+
+        size_t erased = 0;
+        for (size_t i = 0; i < kShardCount; ++i)
+        {
+            if (grouped[i].empty())
+                continue;
+            Shard &shard = m_shards[i];
+            auto lock = lockWriter(shard);
+            auto next = copyCurrent(shard);
+            size_t shardErased = 0;
+            for (const auto *key : grouped[i])
+            {
+                shardErased += next->erase(*key);
+            }
+            if (shardErased > 0)
+            {
+                publish(shard, std::move(next));
+                erased += shardErased;
+            }
+        }
+        return erased;
+    }
+
+    /**
+     * @brief 清空所有资源
+     */
+    void clear()
+    {
+        for (auto &shard : m_shards)
+        {
+            auto lock = lockWriter(shard);
+            publish(shard, std::make_shared<const Map>());
+        }
+    }
+
+    /**
+     * @brief 获取写入统计
+     */
+    SnapshotMapStats getStats() const
+    {
+        SnapshotMapStats stats;
+        stats.publishes = m_publishes.load(std::memory_order_relaxed);
+        stats.copiedEntries = m_copiedEntries.load(std::memory_order_relaxed);
+        stats.contendedWrites = m_contendedWrites.load(std::memory_order_relaxed);
+        stats.writeWaitTimeMs = static_cast<double>(m_writeWaitNs.load(std::memory_order_relaxed)) / 1.0e6;
+        return stats;
+    }
+
+  private:
+    /**
+     * @struct Shard
+     * @brief 一个分片：独立发布的快照与写锁，按缓存行对齐避免相邻分片的伪共享
+     */
+    struct alignas(64) Shard
+    {
+        std::atomic<std::shared_ptr<const Map>> snapshot{std::make_shared<const Map>()}; ///< 当前发布的快照
+        std::mutex writeMutex;                                                           ///< 串行化该分片的写入者
+    };
+
+    static size_t shardIndex(const std::string &key)
+    {
+        return std::hash<std::string>{}(key) & (kShardCount - 1);
+    }
+
+    Shard &shardFor(const std::string &key)
+    {
+        return m_shards[shardIndex(key)];
+    }
+
+    const Shard &shardFor(const std::string &key) const
+    {
+        return m_shards[shardIndex(key)];
+    }
+
+    /**
+     * @brief 获取分片的写锁，锁已被其他写入者持有时记录等待次数与时间
+     */
+    std::unique_lock<std::mutex> lockWriter(Shard &shard)
+    {
+        std::unique_lock<std::mutex> lock(shard.writeMutex, std::try_to_lock);
+        if (!lock.owns_lock())
+        {
+            TRACE_SCOPE("SnapshotMap::writeContention");
+            const auto start = std::chrono::steady_clock::now();
+            lock.lock();
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            m_contendedWrites.fetch_add(1, std::memory_order_relaxed);
+            m_writeWaitNs.fetch_add(
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                std::memory_order_relaxed);
+        }
+        return lock;
+    }
+
+    /**
+     * @brief 复制分片的当前快照（调用者需持有该分片的写锁）
+     */
+    std::shared_ptr<Map> copyCurrent(Shard &shard)
+    {
+        auto current = shard.snapshot.load(std::memory_order_relaxed);
+        m_copiedEntries.fetch_add(current->size(), std::memory_order_relaxed);
+        return std::make_shared<Map>(*current);
+    }
+
+    /**
+     * @brief 发布分片的新快照（调用者需持有该分片的写锁）
+     */
+    void publish(Shard &shard, std::shared_ptr<const Map> next)
+    {
+        shard.snapshot.store(std::move(next), std::memory_order_release);
+        m_publishes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::array<Shard, kShardCount> m_shards; ///< 按键哈希划分的分片
+
+    std::atomic<uint64_t> m_publishes{0};       ///< 发布的快照数量
+    std::atomic<uint64_t> m_copiedEntries{0};   ///< 写入时复制的条目总数
+    std::atomic<uint64_t> m_contendedWrites{0}; ///< 等待写锁的次数
+    std::atomic<uint64_t> m_writeWaitNs{0};     ///< 累计等待写锁的时间（纳秒）
+};
+
+} // namespace asset
@@ -6,11 +6,6 @@
 
 namespace asset
 {
-inline std::string normalizeResourcePath(const std::filesystem::path &filepath)
-{
-    return std::filesystem::absolute(filepath).lexically_normal().string();
-}
-
 static vk::DescriptorType ToVkDescriptorType(SpvReflectDescriptorType type)
 {
     switch (type)
@@ -0,0 +1,129 @@
+/**
+ * @file VirtualFileSystem.hpp
+ * @author Summer
+ * @brief 资源文件访问层：优先从挂载的资源包中读取，未命中时回退到磁盘
+ *
+ * @version 1.0
+ * @date 2025-11-28
+ */
+
+#pragma once
+
+#include "AssetPackage.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace asset
+{
+
+/**
+ * @class FileBlob
+ * @brief 一次文件读取的结果
+ *
+ * @details 来自未压缩包条目时直接引用映射内存（并保持资源包存活），否则持有读取到的数据
+ */
+class FileBlob
+{
+  public:
+    FileBlob() = default;
+    explicit FileBlob(std::vector<uint8_t> bytes) : m_owned(std::move(bytes)), m_view(m_owned)
+    {
+    }
+    FileBlob(std::span<const uint8_t> view, std::shared_ptr<const AssetPackage> package)
+        : m_package(std::move(package)), m_view(view)
+    {
+    }
+
+    FileBlob(FileBlob &&) noexcept = default;
+    FileBlob &operator=(FileBlob &&) noexcept = default;
+    FileBlob(const FileBlob &) = delete;
+    FileBlob &operator=(const FileBlob &) = delete;
+
+    const uint8_t *data() const
+    {
+        return m_view.data();
+    }
+
+    size_t size() const
+    {
+        return m_view.size();
+    }
+
+    std::string_view asString() const
+    {
+        return {reinterpret_cast<const char *>(m_view.data()), m_view.size()};
+    }
+
+  private:
+    std::vector<uint8_t> m_owned;                  ///< 自有数据（磁盘读取或解压结果）
+    std::shared_ptr<const AssetPackage> m_package; ///< 引用映射内存时保持资源包存活
+    std::span<const uint8_t> m_view;               ///< 数据视图
+};
+
+/**
+ * @class VirtualFileSystem
+ * @brief 将磁盘路径透明地解析到挂载的资源包
+ *
+ * @details
+ * - 资源包挂载到一个磁盘目录上，该目录下的路径按相对路径在包中查找
+ * - 后挂载的资源包优先（可用于补丁包），包中没有的文件回退到磁盘
+ * - 挂载通常在启动时完成；查找与读取可在多个加载线程中并发进行
+ * - 热重载监视的是磁盘文件，开发时不应挂载包含同一资源的资源包
+ */
+class VirtualFileSystem
+{
+  public:
+    /**
+     * @brief 挂载资源包
+     * @param packageFile 资源包文件
+     * @param mountRoot 包内路径对应的磁盘根目录
+     * @throws std::runtime_error 资源包无法打开或格式无效
+     */
+    void mount(const std::filesystem::path &packageFile, const std::filesystem::path &mountRoot);
+
+    /**
+     * @brief 卸载所有资源包（已读取的 FileBlob 仍然有效）
+     */
+    void unmountAll();
+
+    /**
+     * @brief 文件或目录是否存在（包内命中时不访问磁盘）
+     */
+    bool exists(const std::filesystem::path &path) const;
+
+    /**
+     * @brief 读取整个文件
+     * @throws std::runtime_error 文件不存在或读取失败
+     */
+    FileBlob readFile(const std::filesystem::path &path) const;
+
+    /**
+     * @brief 是否挂载了资源包
+     */
+    bool hasMounts() const;
+
+  private:
+    struct Mount
+    {
+        std::string root;                            ///< 归一化的挂载目录（'/' 分隔）
+        std::shared_ptr<const AssetPackage> package; ///< 资源包
+    };
+
+    /**
+     * @brief 将磁盘路径转换为某个挂载点下的包内路径
+     * @return 包内路径，不在挂载点下时返回空字符串
+     */
+    static std::string toPackagePath(const Mount &mount, const std::string &path);
+    static std::string normalize(const std::filesystem::path &path);
+
+    std::vector<Mount> m_mounts;
+    mutable std::shared_mutex m_mutex;
+};
+
+} // namespace asset
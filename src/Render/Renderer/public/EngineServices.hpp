@@ -1,5 +1,6 @@
 #pragma once
 
+#include "HotReloadService.hpp"
 #include "MaterialManager.hpp"
 #include "ResourceManager.hpp"
 #include "Scene.hpp"
@@ -23,8 +24,8 @@ namespace renderer
  * EngineServices 为核心子系统提供统一的注册、获取与初始化接口，覆盖 Vulkan 上下文、
  * 资源分配与上传、资源/材质管理以及场景管理等主要服务。典型用法：
  * - 通过 @ref initializeVkContext 与 @ref initializeResourceAllocator 按依赖顺序构建底层设施
- * - 使用 @ref initializeTransferManager、@ref initializeResourceManager、@ref initializeMaterialManager
- *   和 @ref initializeScene 创建高层服务
+ * - 使用 @ref initializeTransferManager、@ref initializeResourceManager、@ref initializeMaterialManager、
+ *   @ref initializeScene 和 @ref initializeHotReload 创建高层服务
  * - 可通过 @ref registerExternalService 注册外部创建的服务实例
  */
 class EngineServices
@@ -131,9 +132,10 @@ class EngineServices
 
     /**
      * @brief 初始化资源管理器。
+     * @param config 资源管理器配置（缓存预算等）。
      * @return ResourceManager 引用。
      */
-    asset::ResourceManager &initializeResourceManager();
+    asset::ResourceManager &initializeResourceManager(const asset::ResourceManagerConfig &config = {});
 
     /**
      * @brief 初始化材质管理器。
@@ -147,6 +149,12 @@ class EngineServices
      */
     asset::Scene &initializeScene();
 
+    /**
+     * @brief 初始化资源热重载服务。
+     * @return HotReloadService 引用。
+     */
+    asset::HotReloadService &initializeHotReload();
+
   private:
     EngineServices() = default;
     ~EngineServices() = default;
@@ -245,7 +253,7 @@ inline vkcore::TransferManager &EngineServices::initializeTransferManager(const
     return transfer;
 }
 
-inline asset::ResourceManager &EngineServices::initializeResourceManager()
+inline asset::ResourceManager &EngineServices::initializeResourceManager(const asset::ResourceManagerConfig &config)
 {
     auto *ctx = tryGetService<vkcore::VkContext>();
     if (!ctx)
@@ -256,7 +264,7 @@ inline asset::ResourceManager &EngineServices::initializeResourceManager()
     {
         return *existing;
     }
-    return emplaceService<asset::ResourceManager>(*ctx);
+    return emplaceService<asset::ResourceManager>(*ctx, config);
 }
 
 inline asset::MaterialManager &EngineServices::initializeMaterialManager()
@@ -282,4 +290,19 @@ inline asset::Scene &EngineServices::initializeScene()
     return emplaceService<asset::Scene>();
 }
 
+inline asset::HotReloadService &EngineServices::initializeHotReload()
+{
+    auto *resourceManager = tryGetService<asset::ResourceManager>();
+    auto *materialManager = tryGetService<asset::MaterialManager>();
+    if (!resourceManager || !materialManager)
+    {
+        throw std::runtime_error("ResourceManager and MaterialManager must be initialized before HotReloadService");
+    }
+    if (auto *existing = tryGetService<asset::HotReloadService>())
+    {
+        return *existing;
+    }
+    return emplaceService<asset::HotReloadService>(*resourceManager, *materialManager);
+}
+
 } // namespace renderer
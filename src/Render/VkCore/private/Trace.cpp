@@ -0,0 +1,160 @@
+#include "../public/Trace.hpp"
+
+#ifdef ENABLE_LOAD_TRACE
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+
+namespace vkcore
+{
+namespace
+{
+/**
+ * @brief 按 JSON 字符串规则转义（Windows 路径中的反斜杠等）
+ */
+std::string escapeJson(const std::string &text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(c));
+                escaped += buffer;
+            }
+            else
+            {
+                escaped += c;
+            }
+        }
+    }
+    return escaped;
+}
+} // namespace
+
+TraceRecorder &TraceRecorder::instance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder() : m_origin(std::chrono::steady_clock::now())
+{
+}
+
+uint64_t TraceRecorder::now() const
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_origin).count());
+}
+
+uint32_t TraceRecorder::currentThreadId()
+{
+    static std::atomic<uint32_t> nextId{1};
+    thread_local const uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+void TraceRecorder::record(TraceEvent event)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.push_back(std::move(event));
+}
+
+void TraceRecorder::setThreadName(std::string name)
+{
+    const uint32_t threadId = currentThreadId();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = std::find_if(m_threadNames.begin(), m_threadNames.end(),
+                           [&](const auto &entry) { return entry.first == threadId; });
+    if (it != m_threadNames.end())
+    {
+        it->second = std::move(name);
+    }
+    else
+    {
+        m_threadNames.emplace_back(threadId, std::move(name));
+    }
+}
+
+void TraceRecorder::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.clear();
+}
+
+bool TraceRecorder::writeChromeTrace(const std::filesystem::path &file) const
+{
+    std::ofstream out(file, std::ios::trunc);
+    if (!out.is_open())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&]() {
+        if (!first)
+            out << ",";
+        first = false;
+        out << "\n";
+    };
+
+    for (const auto &[threadId, name] : m_threadNames)
+    {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId
+            << ",\"args\":{\"name\":\"" << escapeJson(name) << "\"}}";
+    }
+
+    // Chrome Trace 的时间单位为微秒
+    char timing[64];
+    for (const auto &event : m_events)
+    {
+        separator();
+        std::snprintf(timing, sizeof(timing), "\"ts\":%.3f,\"dur\":%.3f", event.startNs / 1000.0,
+                      event.durationNs / 1000.0);
+        out << "{\"name\":\"" << escapeJson(event.name) << "\",\"cat\":\"" << escapeJson(event.category)
+            << "\",\"ph\":\"X\"," << timing << ",\"pid\":1,\"tid\":" << event.threadId;
+        if (event.bytes != 0 || !event.detail.empty())
+        {
+            out << ",\"args\":{";
+            if (event.bytes != 0)
+            {
+                out << "\"bytes\":" << event.bytes;
+            }
+            if (!event.detail.empty())
+            {
+                out << (event.bytes != 0 ? "," : "") << "\"detail\":\"" << escapeJson(event.detail) << "\"";
+            }
+            out << "}";
+        }
+        out << "}";
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace vkcore
+
+#endif
@@ -2,12 +2,109 @@
 #include "../public/VkUtils.hpp"
 #include "TransferManager.hpp"
 #include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iterator>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <set>
 #include <stdexcept>
 #include <unordered_map>
 
 using namespace vkcore;
 
+namespace
+{
+// 逐级2x2盒式降采样：texelFetch不依赖线性过滤，奇数尺寸时边缘texel被重复采样
+constexpr const char *kMipmapDownsampleSource = R"(#version 450
+layout(local_size_x = 8, local_size_y = 8) in;
+layout(set = 0, binding = 0) uniform sampler2D srcMip;
+layout(set = 0, binding = 1, MIP_FORMAT) uniform writeonly image2D dstMip;
+
+void main()
+{
+    ivec2 dst = ivec2(gl_GlobalInvocationID.xy);
+    if (any(greaterThanEqual(dst, imageSize(dstMip))))
+        return;
+    ivec2 srcMax = textureSize(srcMip, 0) - 1;
+    ivec2 src = dst * 2;
+    vec4 color = texelFetch(srcMip, min(src, srcMax), 0);
+    color += texelFetch(srcMip, min(src + ivec2(1, 0), srcMax), 0);
+    color += texelFetch(srcMip, min(src + ivec2(0, 1), srcMax), 0);
+    color += texelFetch(srcMip, min(src + ivec2(1, 1), srcMax), 0);
+    imageStore(dstMip, dst, color * 0.25);
+}
+)";
+constexpr uint32_t kMipmapGroupSize = 8;
+
+// 完成线程单次等待的上限：等待期间登记的更早令牌最迟在超时后被处理
+constexpr uint64_t kCompletionWaitTimeoutNs = 2'000'000;
+
+/**
+ * @brief 格式对应的GLSL存储图像格式限定符，只支持浮点与归一化格式
+ */
+const char *storageFormatQualifier(vk::Format format)
+{
+    switch (format)
+    {
+    case vk::Format::eR8G8B8A8Unorm:
+        return "rgba8";
+    case vk::Format::eR8G8B8A8Snorm:
+        return "rgba8_snorm";
+    case vk::Format::eR8G8Unorm:
+        return "rg8";
+    case vk::Format::eR8Unorm:
+        return "r8";
+    case vk::Format::eR16G16B16A16Unorm:
+        return "rgba16";
+    case vk::Format::eR16G16B16A16Sfloat:
+        return "rgba16f";
+    case vk::Format::eR16G16Sfloat:
+        return "rg16f";
+    case vk::Format::eR16Sfloat:
+        return "r16f";
+    case vk::Format::eR32G32B32A32Sfloat:
+        return "rgba32f";
+    case vk::Format::eR32G32Sfloat:
+        return "rg32f";
+    case vk::Format::eR32Sfloat:
+        return "r32f";
+    case vk::Format::eA2B10G10R10UnormPack32:
+        return "rgb10_a2";
+    case vk::Format::eB10G11R11UfloatPack32:
+        return "r11f_g11f_b10f";
+    default:
+        return nullptr;
+    }
+}
+
+vk::ImageMemoryBarrier mipBarrier(const MipmapRequest &request, uint32_t baseLevel, uint32_t levelCount,
+                                  vk::ImageLayout oldLayout, vk::ImageLayout newLayout, vk::AccessFlags srcAccess,
+                                  vk::AccessFlags dstAccess)
+{
+    vk::ImageMemoryBarrier barrier{};
+    barrier.srcAccessMask = srcAccess;
+    barrier.dstAccessMask = dstAccess;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = request.image;
+    barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+    barrier.subresourceRange.baseMipLevel = baseLevel;
+    barrier.subresourceRange.levelCount = levelCount;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = request.layerCount;
+    return barrier;
+}
+
+uint32_t mipSize(uint32_t size, uint32_t level)
+{
+    return (std::max)(size >> level, 1u);
+}
+} // namespace
+
 TransferManager::~TransferManager()
 {
     cleanup();
@@ -21,6 +118,31 @@ void TransferManager::initialize(VkContext &ctx, VkResourceAllocator &allocator,
     m_ctx = &ctx;
     m_allocator = &allocator;
     m_config = config;
+
+    // 每个队列一个时间线信号量（需要 DeviceConfig::enableTimelineSemaphore）
+    vk::SemaphoreTypeCreateInfo typeInfo{};
+    typeInfo.semaphoreType = vk::SemaphoreType::eTimeline;
+    typeInfo.initialValue = 0;
+    vk::SemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.pNext = &typeInfo;
+    for (auto &timeline : m_timelines)
+    {
+        timeline.semaphore = m_ctx->getDevice().createSemaphore(semaphoreInfo);
+        timeline.lastSubmitted.store(0, std::memory_order_relaxed);
+    }
+
+    if (m_config.enableTransferService)
+    {
+        m_serviceStop.store(false, std::memory_order_relaxed);
+        m_serviceRunning.store(true, std::memory_order_release);
+        m_serviceThread = std::thread(&TransferManager::serviceLoop, this);
+    }
+
+    if (m_config.enableCompletionThread)
+    {
+        m_completionStop = false;
+        m_completionThread = std::thread(&TransferManager::completionLoop, this);
+    }
 }
 
 void TransferManager::cleanup()
@@ -28,17 +150,47 @@ void TransferManager::cleanup()
     if (!m_ctx)
         return;
 
+    // 传输线程会获取资源锁，需在加锁前停止；停止前已入队的请求全部提交
+    stopTransferService();
+    stopCompletionThread();
+
     std::lock_guard<std::mutex> lock(m_resourcesMutex);
     auto device = m_ctx->getDevice();
 
+    // 先等待所有时间线到达最近一次提交的值
+    std::vector<vk::Semaphore> semaphores;
+    std::vector<uint64_t> values;
+    for (const auto &timeline : m_timelines)
+    {
+        if (timeline.semaphore && timeline.lastSubmitted.load(std::memory_order_acquire) > 0)
+        {
+            semaphores.push_back(timeline.semaphore);
+            values.push_back(timeline.lastSubmitted.load(std::memory_order_acquire));
+        }
+    }
+    if (!semaphores.empty())
+    {
+        vk::SemaphoreWaitInfo waitInfo{};
+        waitInfo.semaphoreCount = static_cast<uint32_t>(semaphores.size());
+        waitInfo.pSemaphores = semaphores.data();
+        waitInfo.pValues = values.data();
+        if (device.waitSemaphores(waitInfo, UINT64_MAX) != vk::Result::eSuccess)
+        {
+            // Log warning?
+        }
+    }
+
     for (auto &resources : m_threadResources)
     {
-        // 销毁staging buffers
-        for (auto &info : resources->stagingBufferPool)
+        // 释放提交关联的资源
+        for (auto &pending : resources->pendingSubmissions)
         {
-            info.buffer.release();
+            for (const auto &sub : pending)
+            {
+                device.freeCommandBuffers(sub.commandPool, sub.cmdBuffer);
+            }
+            pending.clear();
         }
-        resources->stagingBufferPool.clear();
 
         if (resources->transferCommandPool)
         {
@@ -49,44 +201,87 @@ void TransferManager::cleanup()
             device.destroyCommandPool(resources->graphicsCommandPool);
         }
 
-        // 先等待所有activeSubmissions完成
-        if (!resources->activeSubmissions.empty())
+        // 销毁staging环与专用staging buffer（GPU已空闲）
+        auto &ring = resources->stagingRing;
+        for (auto &entry : ring.entries)
         {
-            std::vector<vk::Fence> fences;
-            for (const auto &sub : resources->activeSubmissions)
-            {
-                fences.push_back(sub.tokenState->fence);
-            }
-            if (device.waitForFences(fences, VK_TRUE, UINT64_MAX) != vk::Result::eSuccess)
+            if (entry.dedicated)
             {
-                // Log warning?
+                vmaUnmapMemory(m_allocator->getAllocator(), entry.dedicated.getAllocation());
+                entry.dedicated.release();
             }
+        }
+        ring.entries.clear();
+        if (ring.buffer)
+        {
+            vmaUnmapMemory(m_allocator->getAllocator(), ring.buffer.getAllocation());
+            ring.buffer.release();
+        }
+        ring.mapped = nullptr;
+    }
+    m_threadResources.clear();
 
-            // 释放提交关联的资源
-            for (const auto &sub : resources->activeSubmissions)
-            {
-                for (size_t idx : sub.stagingBuffersToRelease)
-                {
-                    if (idx < resources->stagingBufferPool.size())
-                        resources->stagingBufferPool[idx].inUse = false;
-                }
-                device.freeCommandBuffers(sub.commandPool, sub.cmdBuffer);
-            }
+    {
+        std::lock_guard<std::mutex> acquireLock(m_acquireMutex);
+        m_pendingAcquires.clear();
+    }
+
+    {
+        std::lock_guard<std::mutex> mipmapLock(m_mipmapMutex);
+        for (auto &scratch : m_mipmapScratch)
+        {
+            destroyMipmapScratch(scratch);
         }
+        m_mipmapScratch.clear();
+        for (auto &[format, pipeline] : m_mipmapPipelines)
+        {
+            if (pipeline)
+                device.destroyPipeline(pipeline);
+        }
+        m_mipmapPipelines.clear();
+        if (m_mipmapPipelineLayout)
+            device.destroyPipelineLayout(m_mipmapPipelineLayout);
+        if (m_mipmapSetLayout)
+            device.destroyDescriptorSetLayout(m_mipmapSetLayout);
+        if (m_mipmapSampler)
+            device.destroySampler(m_mipmapSampler);
+        m_mipmapPipelineLayout = nullptr;
+        m_mipmapSetLayout = nullptr;
+        m_mipmapSampler = nullptr;
+    }
+
+    // 未处理的流式上传直接丢弃，其回调不会被调用
+    {
+        std::lock_guard<std::mutex> streamingLock(m_streamingMutex);
+        m_streamingQueue.clear();
+    }
+
+    // 未执行的完成回调同样丢弃
+    {
+        std::lock_guard<std::mutex> continuationLock(m_continuationMutex);
+        m_continuations.clear();
+    }
 
-        // 销毁所有fences
-        for (auto fence : resources->fencePool)
+    // 仍被ReadbackResult持有的buffer也在此销毁，结果必须先于cleanup析构
+    {
+        std::lock_guard<std::mutex> readbackLock(m_readbackMutex);
+        for (auto &entry : m_readbackPool)
         {
-            device.destroyFence(fence);
+            vmaUnmapMemory(m_allocator->getAllocator(), entry->buffer.getAllocation());
+            entry->buffer.release();
         }
-        for (const auto &sub : resources->activeSubmissions)
+        m_readbackPool.clear();
+    }
+
+    for (auto &timeline : m_timelines)
+    {
+        if (timeline.semaphore)
         {
-            device.destroyFence(sub.tokenState->fence);
+            device.destroySemaphore(timeline.semaphore);
+            timeline.semaphore = nullptr;
         }
-        resources->activeSubmissions.clear();
-        resources->fencePool.clear();
+        timeline.lastSubmitted.store(0, std::memory_order_relaxed);
     }
-    m_threadResources.clear();
 
     m_ctx = nullptr;
     m_allocator = nullptr;
@@ -95,6 +290,8 @@ void TransferManager::cleanup()
 TransferToken TransferManager::uploadToBuffer(const ManagedBuffer &dstBuffer, const void *data, vk::DeviceSize size,
                                               vk::DeviceSize dstOffset)
 {
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::uploadToBuffer");
+    TRACE_SET_BYTES(traceZone, size);
     if (!m_allocator || !m_ctx)
         throw std::runtime_error("TransferManager is not initialized");
     if (!dstBuffer)
@@ -106,36 +303,68 @@ TransferToken TransferManager::uploadToBuffer(const ManagedBuffer &dstBuffer, co
     if (size > bufferSize - dstOffset)
         throw std::out_of_range("Upload size exceeds destination buffer capacity");
 
-    size_t stagingIndex = acquireStagingBuffer(size);
-    copyHostToStaging(stagingIndex, data, static_cast<size_t>(size));
+    if (tryDirectWrite(dstBuffer, data, size, dstOffset))
+        return TransferToken{};
+
+    if (isTransferServiceEnabled())
+    {
+        if (size == 0)
+            return TransferToken{};
+        auto request = std::make_unique<ServiceRequest>();
+        request->data = std::make_unique<uint8_t[]>(static_cast<size_t>(size));
+        std::memcpy(request->data.get(), data, static_cast<size_t>(size));
+        request->size = size;
+        request->dstBuffer = dstBuffer.getBuffer();
+        request->dstOffset = dstOffset;
+        return enqueueServiceRequest(std::move(request));
+    }
+
+    StagingAllocation staging = allocateStaging(size);
+    writeStaging(staging, data, size);
 
     // 直接录制命令，不调用copyBuffer以控制提交
     vk::CommandBuffer cmd = beginOneTimeCommands(TransferQueueType::Transfer);
     vk::BufferCopy copyRegion{};
-    copyRegion.srcOffset = 0;
+    copyRegion.srcOffset = staging.offset;
     copyRegion.dstOffset = dstOffset;
     copyRegion.size = size;
-    cmd.copyBuffer(getThreadResources().stagingBufferPool[stagingIndex].buffer.getBuffer(), dstBuffer.getBuffer(), 1,
-                   &copyRegion);
+    cmd.copyBuffer(staging.buffer, dstBuffer.getBuffer(), 1, &copyRegion);
 
-    // 提交并传递需要释放的staging buffer
-    TransferToken token = endOneTimeCommands(cmd, TransferQueueType::Transfer, {stagingIndex});
-
-    cleanupUnusedStagingBuffers();
-    return token;
+    // 提交并把staging分配关联到本次提交
+    return endOneTimeCommands(cmd, TransferQueueType::Transfer, {staging.sequence});
 }
 
 TransferToken TransferManager::uploadToImage(const ManagedImage &dstImage, const void *data, vk::DeviceSize dataSize,
                                              uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevel,
                                              uint32_t arrayLayer)
 {
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::uploadToImage");
+    TRACE_SET_BYTES(traceZone, dataSize);
     if (!m_allocator || !m_ctx)
         throw std::runtime_error("TransferManager is not initialized");
 
-    size_t stagingIndex = acquireStagingBuffer(dataSize);
-    copyHostToStaging(stagingIndex, data, static_cast<size_t>(dataSize));
+    // bufferOffset 必须是4与texel大小的倍数
+    const uint32_t texelSize = VkUtils::getFormatSize(dstImage.getFormat());
+    const vk::DeviceSize alignment = texelSize > 0 ? std::lcm<vk::DeviceSize>(4, texelSize) : 16;
 
-    vk::CommandBuffer cmd = beginOneTimeCommands(TransferQueueType::Graphics);
+    if (isTransferServiceEnabled())
+    {
+        auto request = std::make_unique<ServiceRequest>();
+        request->data = std::make_unique<uint8_t[]>(static_cast<size_t>(dataSize));
+        std::memcpy(request->data.get(), data, static_cast<size_t>(dataSize));
+        request->size = dataSize;
+        request->dstImage = dstImage.getImage();
+        request->alignment = alignment;
+        request->extent = vk::Extent3D{width, height, depth};
+        request->mipLevel = mipLevel;
+        request->arrayLayer = arrayLayer;
+        return enqueueServiceRequest(std::move(request));
+    }
+
+    StagingAllocation staging = allocateStaging(dataSize, alignment);
+    writeStaging(staging, data, dataSize);
+
+    vk::CommandBuffer cmd = beginOneTimeCommands(TransferQueueType::Transfer);
 
     // 转换到TransferDst
     BarrierInfo barrierInfo = getBarrierInfo(vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal);
@@ -155,7 +384,7 @@ TransferToken TransferManager::uploadToImage(const ManagedImage &dstImage, const
     cmd.pipelineBarrier(barrierInfo.srcStage, barrierInfo.dstStage, {}, nullptr, nullptr, barrier);
 
     vk::BufferImageCopy region{};
-    region.bufferOffset = 0;
+    region.bufferOffset = staging.offset;
     region.bufferRowLength = 0;
     region.bufferImageHeight = 0;
     region.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
@@ -165,23 +394,448 @@ TransferToken TransferManager::uploadToImage(const ManagedImage &dstImage, const
     region.imageOffset = vk::Offset3D{0, 0, 0};
     region.imageExtent = vk::Extent3D{width, height, depth};
 
-    cmd.copyBufferToImage(getThreadResources().stagingBufferPool[stagingIndex].buffer.getBuffer(), dstImage.getImage(),
-                          vk::ImageLayout::eTransferDstOptimal, 1, &region);
+    cmd.copyBufferToImage(staging.buffer, dstImage.getImage(), vk::ImageLayout::eTransferDstOptimal, 1, &region);
 
-    // 转换到ShaderReadOnly
-    barrierInfo = getBarrierInfo(vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal);
-    barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+    // 转换到ShaderReadOnly（专用传输队列上为队列族释放）
     barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-    barrier.srcAccessMask = barrierInfo.srcAccessMask;
-    barrier.dstAccessMask = barrierInfo.dstAccessMask;
-    cmd.pipelineBarrier(barrierInfo.srcStage, barrierInfo.dstStage, {}, nullptr, nullptr, barrier);
+    std::vector<vk::ImageMemoryBarrier> finalBarriers{barrier};
+    std::vector<PendingAcquire> acquires;
+    recordFinalImageBarriers(cmd, TransferQueueType::Transfer, finalBarriers, acquires);
+
+    TransferToken token = endOneTimeCommands(cmd, TransferQueueType::Transfer, {staging.sequence});
+    registerAcquires(std::move(acquires), token);
+    return token;
+}
+
+// ==================== UploadBatch ====================
+
+UploadBatch::UploadBatch(TransferManager &owner) : m_owner(&owner), m_thread(std::this_thread::get_id())
+{
+}
+
+UploadBatch::~UploadBatch()
+{
+    releaseStaging();
+}
+
+UploadBatch::UploadBatch(UploadBatch &&other) noexcept
+    : m_owner(other.m_owner), m_thread(other.m_thread), m_stagingSequences(std::move(other.m_stagingSequences)),
+      m_bufferCopies(std::move(other.m_bufferCopies)), m_imageCopies(std::move(other.m_imageCopies)),
+      m_stagingBytes(other.m_stagingBytes)
+{
+    other.reset();
+}
+
+UploadBatch &UploadBatch::operator=(UploadBatch &&other) noexcept
+{
+    if (this != &other)
+    {
+        releaseStaging();
+        m_owner = other.m_owner;
+        m_thread = other.m_thread;
+        m_stagingSequences = std::move(other.m_stagingSequences);
+        m_bufferCopies = std::move(other.m_bufferCopies);
+        m_imageCopies = std::move(other.m_imageCopies);
+        m_stagingBytes = other.m_stagingBytes;
+        other.reset();
+    }
+    return *this;
+}
+
+void UploadBatch::uploadToBuffer(const ManagedBuffer &dstBuffer, const void *data, vk::DeviceSize size,
+                                 vk::DeviceSize dstOffset)
+{
+    if (!dstBuffer)
+        throw std::runtime_error("Destination buffer is invalid");
+
+    const vk::DeviceSize bufferSize = dstBuffer.getSize();
+    if (dstOffset >= bufferSize)
+        throw std::out_of_range("dstOffset exceeds destination buffer size");
+    if (size > bufferSize - dstOffset)
+        throw std::out_of_range("Upload size exceeds destination buffer capacity");
+    if (size == 0)
+        return;
+    if (m_owner->tryDirectWrite(dstBuffer, data, size, dstOffset))
+        return;
+
+    recordBufferCopy(dstBuffer.getBuffer(), data, size, dstOffset);
+}
+
+void UploadBatch::uploadToImage(const ManagedImage &dstImage, const void *data, vk::DeviceSize dataSize,
+                                uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevel, uint32_t arrayLayer,
+                                vk::ImageLayout finalLayout)
+{
+    if (!dstImage)
+        throw std::runtime_error("Destination image is invalid");
 
-    TransferToken token = endOneTimeCommands(cmd, TransferQueueType::Graphics, {stagingIndex});
+    // bufferOffset 必须是4与texel大小的倍数
+    const uint32_t texelSize = VkUtils::getFormatSize(dstImage.getFormat());
+    const vk::DeviceSize alignment = texelSize > 0 ? std::lcm<vk::DeviceSize>(4, texelSize) : 16;
 
-    cleanupUnusedStagingBuffers();
+    recordImageCopy(dstImage.getImage(), data, dataSize, alignment, vk::Extent3D{width, height, depth}, mipLevel,
+                    arrayLayer, finalLayout);
+}
+
+void UploadBatch::recordBufferCopy(vk::Buffer dstBuffer, const void *data, vk::DeviceSize size,
+                                   vk::DeviceSize dstOffset)
+{
+    BufferCopy copy{};
+    copy.dstBuffer = dstBuffer;
+    copy.region.srcOffset = stage(data, size, 4, copy.srcBuffer);
+    copy.region.dstOffset = dstOffset;
+    copy.region.size = size;
+    m_bufferCopies.push_back(copy);
+}
+
+void UploadBatch::recordImageCopy(vk::Image dstImage, const void *data, vk::DeviceSize dataSize,
+                                  vk::DeviceSize alignment, vk::Extent3D extent, uint32_t mipLevel,
+                                  uint32_t arrayLayer, vk::ImageLayout finalLayout)
+{
+    ImageCopy copy{};
+    copy.dstImage = dstImage;
+    copy.finalLayout = finalLayout;
+    copy.region.bufferOffset = stage(data, dataSize, alignment, copy.srcBuffer);
+    copy.region.bufferRowLength = 0;
+    copy.region.bufferImageHeight = 0;
+    copy.region.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+    copy.region.imageSubresource.mipLevel = mipLevel;
+    copy.region.imageSubresource.baseArrayLayer = arrayLayer;
+    copy.region.imageSubresource.layerCount = 1;
+    copy.region.imageOffset = vk::Offset3D{0, 0, 0};
+    copy.region.imageExtent = extent;
+    m_imageCopies.push_back(copy);
+}
+
+TransferToken UploadBatch::submit()
+{
+    if (!m_owner)
+        throw std::runtime_error("UploadBatch is not bound to a TransferManager");
+    checkThread();
+    return m_owner->submitUploadBatch(*this);
+}
+
+vk::DeviceSize UploadBatch::stage(const void *data, vk::DeviceSize size, vk::DeviceSize alignment,
+                                  vk::Buffer &outBuffer)
+{
+    if (!m_owner)
+        throw std::runtime_error("UploadBatch is not bound to a TransferManager");
+    checkThread();
+
+    StagingAllocation staging = m_owner->allocateStaging(size, alignment);
+    m_stagingSequences.push_back(staging.sequence);
+    m_owner->writeStaging(staging, data, size);
+    m_stagingBytes += size;
+    outBuffer = staging.buffer;
+    return staging.offset;
+}
+
+void UploadBatch::checkThread() const
+{
+    if (std::this_thread::get_id() != m_thread)
+        throw std::runtime_error("UploadBatch must be recorded and submitted on the thread that created it");
+}
+
+void UploadBatch::releaseStaging()
+{
+    // 未提交的批次放弃其staging分配；所属线程之外无法访问线程局部的环
+    if (m_owner && !m_stagingSequences.empty() && std::this_thread::get_id() == m_thread && m_owner->getAllocator())
+    {
+        m_owner->abandonStaging(m_stagingSequences);
+    }
+    reset();
+}
+
+void UploadBatch::reset()
+{
+    m_stagingSequences.clear();
+    m_bufferCopies.clear();
+    m_imageCopies.clear();
+    m_stagingBytes = 0;
+}
+
+UploadBatch TransferManager::createUploadBatch()
+{
+    if (!m_allocator || !m_ctx)
+        throw std::runtime_error("TransferManager is not initialized");
+    return UploadBatch(*this);
+}
+
+void TransferManager::scheduleUpload(StreamingUpload upload)
+{
+    if (!upload.record)
+        throw std::invalid_argument("StreamingUpload requires a record callback");
+
+    std::lock_guard<std::mutex> lock(m_streamingMutex);
+    const std::pair<int64_t, uint64_t> key{-static_cast<int64_t>(upload.priority), m_streamingSequence++};
+    m_streamingQueue.emplace(key, std::move(upload));
+}
+
+StreamingStats TransferManager::processStreamingUploads(bool ignoreBudget)
+{
+    if (!m_allocator || !m_ctx)
+        throw std::runtime_error("TransferManager is not initialized");
+
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::streamingFrame");
+    StreamingBudget budget;
+    {
+        std::lock_guard<std::mutex> lock(m_streamingMutex);
+        budget = m_config.streaming;
+    }
+
+    vk::DeviceSize frameBytes = 0;
+    uint32_t frameSubmits = 0;
+    uint32_t frameRequests = 0;
+
+    UploadBatch batch = createUploadBatch();
+    vk::DeviceSize batchBytes = 0;
+    std::vector<std::function<void(const TransferToken &)>> callbacks;
+    auto submitBatch = [&]() {
+        if (callbacks.empty())
+            return;
+        const bool needsSubmit = !batch.empty();
+        TransferToken token;
+        try
+        {
+            token = batch.submit();
+        }
+        catch (const std::exception &e)
+        {
+            // 提交失败的请求以失败令牌通知请求方，由其释放资源或重试
+            std::cerr << "Failed to submit streaming uploads: " << e.what() << std::endl;
+            batch = createUploadBatch();
+            token = TransferToken::makeFailed(e.what());
+        }
+        if (needsSubmit && !token.isFailed())
+            ++frameSubmits;
+        for (auto &callback : callbacks)
+        {
+            if (callback)
+                callback(token);
+        }
+        callbacks.clear();
+        batchBytes = 0;
+    };
+
+    while (ignoreBudget || frameSubmits < budget.submitsPerFrame)
+    {
+        StreamingUpload upload;
+        {
+            std::lock_guard<std::mutex> lock(m_streamingMutex);
+            if (m_streamingQueue.empty())
+                break;
+            auto next = m_streamingQueue.begin();
+            // 本帧已有上传时超出预算的请求顺延到下一帧；空帧总是处理一个，保证超大请求不会饿死
+            if (!ignoreBudget && frameBytes > 0 && frameBytes + next->second.bytes > budget.bytesPerFrame)
+                break;
+            upload = std::move(next->second);
+            m_streamingQueue.erase(next);
+        }
+
+        // 录制在锁外进行，回调中可以继续排队新的请求
+        try
+        {
+            upload.record(batch);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Failed to record streaming upload: " << e.what() << std::endl;
+            continue;
+        }
+        frameBytes += upload.bytes;
+        batchBytes += upload.bytes;
+        ++frameRequests;
+        callbacks.push_back(std::move(upload.onSubmitted));
+
+        if (batchBytes >= budget.bytesPerSubmit)
+            submitBatch();
+    }
+    submitBatch();
+
+    // 每帧顺带回收已退出线程的资源，传输服务默认关闭时也不会泄漏命令池与staging环
+    {
+        std::lock_guard<std::mutex> lock(m_resourcesMutex);
+        reclaimExitedThreads();
+    }
+
+    std::lock_guard<std::mutex> lock(m_streamingMutex);
+    m_streamingStats.frames++;
+    m_streamingStats.frameBytes = frameBytes;
+    m_streamingStats.frameSubmits = frameSubmits;
+    m_streamingStats.frameRequests = frameRequests;
+    m_streamingStats.peakFrameBytes = (std::max)(m_streamingStats.peakFrameBytes, frameBytes);
+    m_streamingStats.totalBytes += frameBytes;
+    StreamingStats stats = m_streamingStats;
+    stats.backlogRequests = m_streamingQueue.size();
+    for (const auto &[key, upload] : m_streamingQueue)
+    {
+        stats.backlogBytes += upload.bytes;
+    }
+    TRACE_SET_BYTES(traceZone, frameBytes);
+    TRACE_SET_DETAIL(traceZone, std::to_string(frameRequests) + " requests, " + std::to_string(frameSubmits) +
+                                    " submits, backlog " + std::to_string(stats.backlogRequests));
+    return stats;
+}
+
+void TransferManager::setStreamingBudget(const StreamingBudget &budget)
+{
+    std::lock_guard<std::mutex> lock(m_streamingMutex);
+    m_config.streaming = budget;
+}
+
+StreamingStats TransferManager::getStreamingStats() const
+{
+    std::lock_guard<std::mutex> lock(m_streamingMutex);
+    StreamingStats stats = m_streamingStats;
+    stats.backlogRequests = m_streamingQueue.size();
+    for (const auto &[key, upload] : m_streamingQueue)
+    {
+        stats.backlogBytes += upload.bytes;
+    }
+    return stats;
+}
+
+TransferToken TransferManager::submitUploadBatch(UploadBatch &batch)
+{
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::submitUploadBatch");
+    TRACE_SET_BYTES(traceZone, batch.m_stagingBytes);
+    if (!m_allocator || !m_ctx)
+        throw std::runtime_error("TransferManager is not initialized");
+
+    if (batch.empty())
+    {
+        batch.releaseStaging();
+        return TransferToken{};
+    }
+
+    // 图像的最终布局转换在专用传输队列上以队列族释放完成，整个批次都可以走传输队列
+    const TransferQueueType queueType = TransferQueueType::Transfer;
+    vk::CommandBuffer cmd = beginOneTimeCommands(queueType);
+
+    // 所有图像一次转换到TransferDst
+    std::vector<vk::ImageMemoryBarrier> barriers;
+    barriers.reserve(batch.m_imageCopies.size());
+    BarrierInfo toTransfer = getBarrierInfo(vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal);
+    for (const auto &copy : batch.m_imageCopies)
+    {
+        vk::ImageMemoryBarrier barrier{};
+        barrier.oldLayout = vk::ImageLayout::eUndefined;
+        barrier.newLayout = vk::ImageLayout::eTransferDstOptimal;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = copy.dstImage;
+        barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+        barrier.subresourceRange.baseMipLevel = copy.region.imageSubresource.mipLevel;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.baseArrayLayer = copy.region.imageSubresource.baseArrayLayer;
+        barrier.subresourceRange.layerCount = 1;
+        barrier.srcAccessMask = toTransfer.srcAccessMask;
+        barrier.dstAccessMask = toTransfer.dstAccessMask;
+        barriers.push_back(barrier);
+    }
+    if (!barriers.empty())
+        cmd.pipelineBarrier(toTransfer.srcStage, toTransfer.dstStage, {}, nullptr, nullptr, barriers);
+
+    // 相邻且源/目标相同的Buffer复制合并为一条命令
+    std::vector<vk::BufferCopy> regions;
+    for (size_t i = 0; i < batch.m_bufferCopies.size();)
+    {
+        const auto &first = batch.m_bufferCopies[i];
+        regions.clear();
+        size_t j = i;
+        while (j < batch.m_bufferCopies.size() && batch.m_bufferCopies[j].srcBuffer == first.srcBuffer &&
+               batch.m_bufferCopies[j].dstBuffer == first.dstBuffer)
+        {
+            regions.push_back(batch.m_bufferCopies[j].region);
+            ++j;
+        }
+        cmd.copyBuffer(first.srcBuffer, first.dstBuffer, regions);
+        i = j;
+    }
+
+    for (const auto &copy : batch.m_imageCopies)
+    {
+        cmd.copyBufferToImage(copy.srcBuffer, copy.dstImage, vk::ImageLayout::eTransferDstOptimal, 1, &copy.region);
+    }
+
+    // 所有图像一次转换到各自的目标布局
+    std::vector<PendingAcquire> acquires;
+    if (!barriers.empty())
+    {
+        for (size_t i = 0; i < barriers.size(); ++i)
+        {
+            barriers[i].newLayout = batch.m_imageCopies[i].finalLayout;
+        }
+        recordFinalImageBarriers(cmd, queueType, barriers, acquires);
+    }
+
+    // staging分配关联到本次提交，时间线达到提交值后由环回收
+    TransferToken token = endOneTimeCommands(cmd, queueType, batch.m_stagingSequences);
+    registerAcquires(std::move(acquires), token);
+    batch.reset();
     return token;
 }
 
+// ==================== ReadbackResult ====================
+
+ReadbackResult::~ReadbackResult()
+{
+    release();
+}
+
+ReadbackResult::ReadbackResult(ReadbackResult &&other) noexcept
+    : m_owner(other.m_owner), m_buffer(other.m_buffer), m_size(other.m_size), m_token(std::move(other.m_token)),
+      m_invalidated(other.m_invalidated)
+{
+    other.m_owner = nullptr;
+    other.m_buffer = nullptr;
+    other.m_size = 0;
+}
+
+ReadbackResult &ReadbackResult::operator=(ReadbackResult &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        m_owner = other.m_owner;
+        m_buffer = other.m_buffer;
+        m_size = other.m_size;
+        m_token = std::move(other.m_token);
+        m_invalidated = other.m_invalidated;
+        other.m_owner = nullptr;
+        other.m_buffer = nullptr;
+        other.m_size = 0;
+    }
+    return *this;
+}
+
+const void *ReadbackResult::data()
+{
+    if (!m_buffer)
+        return nullptr;
+
+    m_token.wait();
+    if (!m_invalidated)
+    {
+        // GpuToCpu内存可能不是HOST_COHERENT，读取前使CPU缓存失效
+        vmaInvalidateAllocation(m_owner->m_allocator->getAllocator(), m_buffer->buffer.getAllocation(), 0, m_size);
+        m_invalidated = true;
+    }
+    return m_buffer->mapped;
+}
+
+void ReadbackResult::release()
+{
+    if (m_owner && m_buffer)
+    {
+        m_owner->releaseReadbackBuffer(m_buffer, m_token);
+    }
+    m_owner = nullptr;
+    m_buffer = nullptr;
+    m_size = 0;
+    m_token = {};
+    m_invalidated = false;
+}
+
 TransferToken TransferManager::copyBuffer(const ManagedBuffer &srcBuffer, const ManagedBuffer &dstBuffer,
                                           vk::DeviceSize size, vk::DeviceSize srcOffset, vk::DeviceSize dstOffset)
 {
@@ -228,7 +882,7 @@ TransferToken TransferManager::copyBufferToImage(const ManagedBuffer &srcBuffer,
     if (!m_ctx)
         throw std::runtime_error("TransferManager is not initialized");
 
-    vk::CommandBuffer cmd = beginOneTimeCommands(TransferQueueType::Graphics);
+    vk::CommandBuffer cmd = beginOneTimeCommands(TransferQueueType::Transfer);
 
     BarrierInfo barrierInfo = getBarrierInfo(vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal);
     vk::ImageMemoryBarrier barrier{};
@@ -259,14 +913,151 @@ TransferToken TransferManager::copyBufferToImage(const ManagedBuffer &srcBuffer,
 
     cmd.copyBufferToImage(srcBuffer.getBuffer(), dstImage.getImage(), vk::ImageLayout::eTransferDstOptimal, 1, &region);
 
-    barrierInfo = getBarrierInfo(vk::ImageLayout::eTransferDstOptimal, vk::ImageLayout::eShaderReadOnlyOptimal);
-    barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
     barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
-    barrier.srcAccessMask = barrierInfo.srcAccessMask;
-    barrier.dstAccessMask = barrierInfo.dstAccessMask;
-    cmd.pipelineBarrier(barrierInfo.srcStage, barrierInfo.dstStage, {}, nullptr, nullptr, barrier);
+    std::vector<vk::ImageMemoryBarrier> finalBarriers{barrier};
+    std::vector<PendingAcquire> acquires;
+    recordFinalImageBarriers(cmd, TransferQueueType::Transfer, finalBarriers, acquires);
 
-    return endOneTimeCommands(cmd, TransferQueueType::Graphics);
+    TransferToken token = endOneTimeCommands(cmd, TransferQueueType::Transfer);
+    registerAcquires(std::move(acquires), token);
+    return token;
+}
+
+TransferToken TransferManager::copyBufferToImageRegions(const ManagedBuffer &srcBuffer, const ManagedImage &dstImage,
+                                                        const std::vector<ImageUploadRegion> &regions,
+                                                        vk::ImageLayout finalLayout)
+{
+    if (!m_ctx)
+        throw std::runtime_error("TransferManager is not initialized");
+    if (!srcBuffer)
+        throw std::runtime_error("Source buffer is invalid");
+
+    return submitImageRegions(srcBuffer.getBuffer(), srcBuffer.getSize(), 0, dstImage, regions, finalLayout, {});
+}
+
+TransferToken TransferManager::uploadToImageRegions(const ManagedImage &dstImage, const void *data,
+                                                    vk::DeviceSize dataSize,
+                                                    const std::vector<ImageUploadRegion> &regions,
+                                                    vk::ImageLayout finalLayout)
+{
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::uploadToImageRegions");
+    TRACE_SET_BYTES(traceZone, dataSize);
+    TRACE_SET_DETAIL(traceZone, std::to_string(regions.size()) + " regions");
+    if (!m_allocator || !m_ctx)
+        throw std::runtime_error("TransferManager is not initialized");
+    if (regions.empty())
+        return TransferToken{};
+
+    // staging起点按4与texel大小对齐，区域偏移满足同样的对齐时bufferOffset即合法
+    const uint32_t texelSize = VkUtils::getFormatSize(dstImage.getFormat());
+    const vk::DeviceSize alignment = texelSize > 0 ? std::lcm<vk::DeviceSize>(4, texelSize) : 16;
+    StagingAllocation staging = allocateStaging(dataSize, alignment);
+    try
+    {
+        writeStaging(staging, data, dataSize);
+        return submitImageRegions(staging.buffer, dataSize, staging.offset, dstImage, regions, finalLayout,
+                                  {staging.sequence});
+    }
+    catch (...)
+    {
+        abandonStaging({staging.sequence});
+        throw;
+    }
+}
+
+TransferToken TransferManager::submitImageRegions(vk::Buffer srcBuffer, vk::DeviceSize srcSize,
+                                                  vk::DeviceSize baseOffset, const ManagedImage &dstImage,
+                                                  const std::vector<ImageUploadRegion> &regions,
+                                                  vk::ImageLayout finalLayout,
+                                                  const std::vector<uint64_t> &stagingSequences)
+{
+    if (regions.empty())
+        return TransferToken{};
+
+    const uint32_t texelSize = VkUtils::getFormatSize(dstImage.getFormat());
+    const vk::DeviceSize alignment = texelSize > 0 ? std::lcm<vk::DeviceSize>(4, texelSize) : 4;
+
+    // 只转换区域实际写入的子资源：包围范围内未被写入的mip与层若一并从Undefined转入，其内容会被丢弃
+    std::set<std::pair<uint32_t, uint32_t>> subresources; // (mip, layer)
+    std::vector<vk::BufferImageCopy> copies;
+    copies.reserve(regions.size());
+    for (const auto &region : regions)
+    {
+        if (region.layerCount == 0)
+            throw std::runtime_error("Image region has no array layers");
+        if (region.dataOffset % alignment != 0)
+            throw std::runtime_error("Image region data offset is not aligned to the texel size");
+        if (texelSize > 0)
+        {
+            const vk::DeviceSize regionSize = vk::DeviceSize{region.imageExtent.width} * region.imageExtent.height *
+                                              region.imageExtent.depth * region.layerCount * texelSize;
+            if (region.dataOffset > srcSize || regionSize > srcSize - region.dataOffset)
+                throw std::out_of_range("Image region exceeds source data size");
+        }
+
+        vk::BufferImageCopy copy{};
+        copy.bufferOffset = baseOffset + region.dataOffset;
+        copy.bufferRowLength = 0;
+        copy.bufferImageHeight = 0;
+        copy.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
+        copy.imageSubresource.mipLevel = region.mipLevel;
+        copy.imageSubresource.baseArrayLayer = region.baseArrayLayer;
+        copy.imageSubresource.layerCount = region.layerCount;
+        copy.imageOffset = region.imageOffset;
+        copy.imageExtent = region.imageExtent;
+        copies.push_back(copy);
+
+        for (uint32_t layer = region.baseArrayLayer; layer < region.baseArrayLayer + region.layerCount; ++layer)
+        {
+            subresources.emplace(region.mipLevel, layer);
+        }
+    }
+
+    // 同一mip上连续的层合并为一个屏障，重叠的区域不会产生重复的布局转换
+    BarrierInfo barrierInfo = getBarrierInfo(vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal);
+    std::vector<vk::ImageMemoryBarrier> barriers;
+    for (auto it = subresources.begin(); it != subresources.end();)
+    {
+        const auto [level, baseLayer] = *it;
+        uint32_t layerCount = 0;
+        while (it != subresources.end() && it->first == level && it->second == baseLayer + layerCount)
+        {
+            ++layerCount;
+            ++it;
+        }
+
+        vk::ImageMemoryBarrier barrier{};
+        barrier.oldLayout = vk::ImageLayout::eUndefined;
+        barrier.newLayout = vk::ImageLayout::eTransferDstOptimal;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = dstImage.getImage();
+        barrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+        barrier.subresourceRange.baseMipLevel = level;
+        barrier.subresourceRange.levelCount = 1;
+        barrier.subresourceRange.baseArrayLayer = baseLayer;
+        barrier.subresourceRange.layerCount = layerCount;
+        barrier.srcAccessMask = barrierInfo.srcAccessMask;
+        barrier.dstAccessMask = barrierInfo.dstAccessMask;
+        barriers.push_back(barrier);
+    }
+
+    vk::CommandBuffer cmd = beginOneTimeCommands(TransferQueueType::Transfer);
+    cmd.pipelineBarrier(barrierInfo.srcStage, barrierInfo.dstStage, {}, nullptr, nullptr, barriers);
+
+    cmd.copyBufferToImage(srcBuffer, dstImage.getImage(), vk::ImageLayout::eTransferDstOptimal, copies);
+
+    std::vector<vk::ImageMemoryBarrier> finalBarriers = std::move(barriers);
+    for (auto &barrier : finalBarriers)
+    {
+        barrier.newLayout = finalLayout;
+    }
+    std::vector<PendingAcquire> acquires;
+    recordFinalImageBarriers(cmd, TransferQueueType::Transfer, finalBarriers, acquires);
+
+    TransferToken token = endOneTimeCommands(cmd, TransferQueueType::Transfer, stagingSequences);
+    registerAcquires(std::move(acquires), token);
+    return token;
 }
 
 TransferToken TransferManager::transitionImageLayout(const ManagedImage &image, vk::ImageLayout oldLayout,
@@ -308,113 +1099,675 @@ TransferToken TransferManager::transitionImageLayout(const ManagedImage &image,
 }
 
 TransferToken TransferManager::generateMipmaps(const ManagedImage &image, uint32_t width, uint32_t height,
-                                               uint32_t mipLevels)
+                                               uint32_t mipLevels, vk::ImageLayout currentLayout)
+{
+    if (!m_ctx)
+        throw std::runtime_error("TransferManager is not initialized");
+
+    MipmapRequest request{};
+    request.image = image.getImage();
+    request.format = image.getFormat();
+    request.extent = vk::Extent2D{width, height};
+    request.mipLevels = mipLevels;
+    request.currentLayout = currentLayout;
+    return generateMipmaps(std::vector<MipmapRequest>{request});
+}
+
+TransferToken TransferManager::generateMipmaps(const std::vector<MipmapRequest> &requests)
 {
     if (!m_ctx)
         throw std::runtime_error("TransferManager is not initialized");
+    if (requests.empty())
+        return TransferToken{};
+
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::generateMipmaps");
+    TRACE_SET_DETAIL(traceZone, std::to_string(requests.size()) + " images");
+
+    // 由专用传输队列上传的图像仍归传输队列族所有，level 0要在获取屏障之后才处于currentLayout；
+    // 先等待这些上传完成（失败时在此抛出），获取屏障与mip转换录制在同一命令缓冲中
+    std::vector<vk::Image> images;
+    images.reserve(requests.size());
+    for (const auto &request : requests)
+    {
+        images.push_back(request.image);
+    }
+    std::vector<TransferToken> uploads;
+    {
+        std::lock_guard<std::mutex> acquireLock(m_acquireMutex);
+        for (const auto &acquire : m_pendingAcquires)
+        {
+            if (std::find(images.begin(), images.end(), acquire.barrier.image) != images.end())
+                uploads.push_back(acquire.token);
+        }
+    }
+    for (const auto &upload : uploads)
+    {
+        upload.wait();
+    }
+
+    const vk::FormatFeatureFlags blitFeatures = vk::FormatFeatureFlagBits::eBlitSrc |
+                                                vk::FormatFeatureFlagBits::eBlitDst |
+                                                vk::FormatFeatureFlagBits::eSampledImageFilterLinear;
+    const vk::FormatFeatureFlags computeFeatures =
+        vk::FormatFeatureFlagBits::eSampledImage | vk::FormatFeatureFlagBits::eStorageImage;
 
-    // 检查是否支持线性过滤blit
-    auto formatProperties = m_ctx->getPhysicalDevice().getFormatProperties(image.getFormat());
-    if (!(formatProperties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eSampledImageFilterLinear))
+    // 计算路径的图像为每个(level, layer)创建视图，并为每个(level>0, layer)分配一个描述符集
+    struct Job
     {
-        throw std::runtime_error("Image format does not support linear blitting for mipmaps");
+        const MipmapRequest *request = nullptr;
+        vk::Pipeline pipeline; ///< 为空时使用blit
+        std::vector<vk::DescriptorSet> sets;
+    };
+    std::vector<Job> jobs;
+    jobs.reserve(requests.size());
+    uint32_t maxLevels = 0;
+    uint32_t setCount = 0;
+    vk::Device device = m_ctx->getDevice();
+    std::unique_lock<std::mutex> lock(m_mipmapMutex);
+    reapMipmapScratch();
+    for (const auto &request : requests)
+    {
+        if (!request.image || request.mipLevels == 0 || request.layerCount == 0)
+            throw std::runtime_error("Invalid mipmap request");
+
+        const vk::FormatFeatureFlags features =
+            m_ctx->getPhysicalDevice().getFormatProperties(request.format).optimalTilingFeatures;
+        const bool blitSupported = (features & blitFeatures) == blitFeatures;
+        const bool computeSupported = request.storageCapable && (features & computeFeatures) == computeFeatures;
+
+        Job job{};
+        job.request = &request;
+        if (computeSupported && (!blitSupported || m_config.preferComputeMipmaps))
+            job.pipeline = getMipmapPipeline(request.format);
+        if (!job.pipeline && !blitSupported)
+            throw std::runtime_error("Image format supports neither linear blitting nor compute downsampling");
+        if (job.pipeline)
+            setCount += (request.mipLevels - 1) * request.layerCount;
+        maxLevels = (std::max)(maxLevels, request.mipLevels);
+        jobs.push_back(std::move(job));
     }
 
+    MipmapScratch scratch{};
+    try
+    {
+        if (setCount > 0)
+        {
+            std::array<vk::DescriptorPoolSize, 2> poolSizes{
+                vk::DescriptorPoolSize{vk::DescriptorType::eCombinedImageSampler, setCount},
+                vk::DescriptorPoolSize{vk::DescriptorType::eStorageImage, setCount}};
+            vk::DescriptorPoolCreateInfo poolInfo{};
+            poolInfo.maxSets = setCount;
+            poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+            poolInfo.pPoolSizes = poolSizes.data();
+            scratch.descriptorPool = device.createDescriptorPool(poolInfo);
+        }
+
+        for (auto &job : jobs)
+        {
+            if (!job.pipeline)
+                continue;
+            const MipmapRequest &request = *job.request;
+            if (request.mipLevels < 2)
+                continue;
+            const size_t viewBase = scratch.views.size();
+            for (uint32_t level = 0; level < request.mipLevels; ++level)
+            {
+                for (uint32_t layer = 0; layer < request.layerCount; ++layer)
+                {
+                    vk::ImageViewCreateInfo viewInfo{};
+                    viewInfo.image = request.image;
+                    viewInfo.viewType = vk::ImageViewType::e2D;
+                    viewInfo.format = request.format;
+                    viewInfo.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+                    viewInfo.subresourceRange.baseMipLevel = level;
+                    viewInfo.subresourceRange.levelCount = 1;
+                    viewInfo.subresourceRange.baseArrayLayer = layer;
+                    viewInfo.subresourceRange.layerCount = 1;
+                    scratch.views.push_back(device.createImageView(viewInfo));
+                }
+            }
+
+            std::vector<vk::DescriptorSetLayout> layouts((request.mipLevels - 1) * request.layerCount,
+                                                         m_mipmapSetLayout);
+            vk::DescriptorSetAllocateInfo allocInfo{};
+            allocInfo.descriptorPool = scratch.descriptorPool;
+            allocInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+            allocInfo.pSetLayouts = layouts.data();
+            job.sets = device.allocateDescriptorSets(allocInfo);
+
+            std::vector<vk::DescriptorImageInfo> imageInfos;
+            imageInfos.reserve(job.sets.size() * 2);
+            std::vector<vk::WriteDescriptorSet> writes;
+            writes.reserve(job.sets.size() * 2);
+            for (uint32_t level = 1; level < request.mipLevels; ++level)
+            {
+                for (uint32_t layer = 0; layer < request.layerCount; ++layer)
+                {
+                    const vk::DescriptorSet set = job.sets[(level - 1) * request.layerCount + layer];
+                    const size_t srcView = viewBase + (level - 1) * request.layerCount + layer;
+                    const size_t dstView = viewBase + level * request.layerCount + layer;
+                    imageInfos.push_back(vk::DescriptorImageInfo{nullptr, scratch.views[srcView],
+                                                                 vk::ImageLayout::eShaderReadOnlyOptimal});
+                    imageInfos.push_back(
+                        vk::DescriptorImageInfo{nullptr, scratch.views[dstView], vk::ImageLayout::eGeneral});
+
+                    vk::WriteDescriptorSet write{};
+                    write.dstSet = set;
+                    write.descriptorCount = 1;
+                    write.dstBinding = 0;
+                    write.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+                    write.pImageInfo = &imageInfos[imageInfos.size() - 2];
+                    writes.push_back(write);
+                    write.dstBinding = 1;
+                    write.descriptorType = vk::DescriptorType::eStorageImage;
+                    write.pImageInfo = &imageInfos.back();
+                    writes.push_back(write);
+                }
+            }
+            device.updateDescriptorSets(writes, nullptr);
+        }
+    }
+    catch (...)
+    {
+        destroyMipmapScratch(scratch);
+        throw;
+    }
+    // 管线创建后直到cleanup都不会变化，录制与提交无需持锁
+    lock.unlock();
+
     vk::CommandBuffer cmd = beginOneTimeCommands(TransferQueueType::Graphics);
-    VkUtils::generateMipmaps(cmd, image.getImage(), image.getFormat(), static_cast<int32_t>(width),
-                             static_cast<int32_t>(height), mipLevels);
-    return endOneTimeCommands(cmd, TransferQueueType::Graphics);
+
+    std::vector<vk::ImageMemoryBarrier> barriers;
+    for (const auto &acquire : takeReadyAcquires(images))
+    {
+        barriers.push_back(acquire.barrier);
+    }
+    if (!barriers.empty())
+    {
+        cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eAllCommands, {},
+                            nullptr, nullptr, barriers);
+        barriers.clear();
+    }
+
+    // level 0转换为读取布局，其余level丢弃旧内容转换为写入布局
+    for (const auto &job : jobs)
+    {
+        const MipmapRequest &request = *job.request;
+        const bool blit = !job.pipeline;
+        barriers.push_back(mipBarrier(request, 0, 1, request.currentLayout,
+                                      blit ? vk::ImageLayout::eTransferSrcOptimal
+                                           : vk::ImageLayout::eShaderReadOnlyOptimal,
+                                      vk::AccessFlagBits::eMemoryWrite,
+                                      blit ? vk::AccessFlagBits::eTransferRead : vk::AccessFlagBits::eShaderRead));
+        if (request.mipLevels > 1)
+        {
+            barriers.push_back(mipBarrier(
+                request, 1, request.mipLevels - 1, vk::ImageLayout::eUndefined,
+                blit ? vk::ImageLayout::eTransferDstOptimal : vk::ImageLayout::eGeneral, {},
+                blit ? vk::AccessFlagBits::eTransferWrite : vk::AccessFlagBits::eShaderWrite));
+        }
+    }
+    const vk::PipelineStageFlags workStages =
+        vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eComputeShader;
+    cmd.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, workStages, {}, nullptr, nullptr, barriers);
+
+    // 逐level录制所有图像，写完的level转换为下一level的读取布局
+    for (uint32_t level = 1; level < maxLevels; ++level)
+    {
+        barriers.clear();
+        vk::Pipeline boundPipeline;
+        for (const auto &job : jobs)
+        {
+            const MipmapRequest &request = *job.request;
+            if (level >= request.mipLevels)
+                continue;
+
+            const uint32_t dstWidth = mipSize(request.extent.width, level);
+            const uint32_t dstHeight = mipSize(request.extent.height, level);
+            if (!job.pipeline)
+            {
+                vk::ImageBlit blit{};
+                blit.srcSubresource = vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level - 1, 0,
+                                                                 request.layerCount};
+                blit.srcOffsets[1] = vk::Offset3D{static_cast<int32_t>(mipSize(request.extent.width, level - 1)),
+                                                  static_cast<int32_t>(mipSize(request.extent.height, level - 1)), 1};
+                blit.dstSubresource =
+                    vk::ImageSubresourceLayers{vk::ImageAspectFlagBits::eColor, level, 0, request.layerCount};
+                blit.dstOffsets[1] =
+                    vk::Offset3D{static_cast<int32_t>(dstWidth), static_cast<int32_t>(dstHeight), 1};
+                cmd.blitImage(request.image, vk::ImageLayout::eTransferSrcOptimal, request.image,
+                              vk::ImageLayout::eTransferDstOptimal, blit, vk::Filter::eLinear);
+                barriers.push_back(mipBarrier(request, level, 1, vk::ImageLayout::eTransferDstOptimal,
+                                              vk::ImageLayout::eTransferSrcOptimal, vk::AccessFlagBits::eTransferWrite,
+                                              vk::AccessFlagBits::eTransferRead));
+                continue;
+            }
+
+            if (job.pipeline != boundPipeline)
+            {
+                cmd.bindPipeline(vk::PipelineBindPoint::eCompute, job.pipeline);
+                boundPipeline = job.pipeline;
+            }
+            for (uint32_t layer = 0; layer < request.layerCount; ++layer)
+            {
+                cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_mipmapPipelineLayout, 0,
+                                       job.sets[(level - 1) * request.layerCount + layer], nullptr);
+                cmd.dispatch((dstWidth + kMipmapGroupSize - 1) / kMipmapGroupSize,
+                             (dstHeight + kMipmapGroupSize - 1) / kMipmapGroupSize, 1);
+            }
+            barriers.push_back(mipBarrier(request, level, 1, vk::ImageLayout::eGeneral,
+                                          vk::ImageLayout::eShaderReadOnlyOptimal, vk::AccessFlagBits::eShaderWrite,
+                                          vk::AccessFlagBits::eShaderRead));
+        }
+        cmd.pipelineBarrier(workStages, workStages, {}, nullptr, nullptr, barriers);
+    }
+
+    // blit图像此时所有level为TransferSrc，计算图像已是ShaderReadOnly，只需对片元着色器可见
+    barriers.clear();
+    for (const auto &job : jobs)
+    {
+        if (!job.pipeline)
+        {
+            barriers.push_back(mipBarrier(*job.request, 0, job.request->mipLevels, vk::ImageLayout::eTransferSrcOptimal,
+                                          vk::ImageLayout::eShaderReadOnlyOptimal, vk::AccessFlagBits::eTransferWrite,
+                                          vk::AccessFlagBits::eShaderRead));
+        }
+    }
+    vk::MemoryBarrier visible{};
+    visible.srcAccessMask = vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eTransferWrite;
+    visible.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+    cmd.pipelineBarrier(workStages,
+                        vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader, {},
+                        visible, nullptr, barriers);
+
+    TransferToken token;
+    try
+    {
+        token = endOneTimeCommands(cmd, TransferQueueType::Graphics);
+    }
+    catch (...)
+    {
+        destroyMipmapScratch(scratch);
+        throw;
+    }
+
+    if (scratch.descriptorPool || !scratch.views.empty())
+    {
+        scratch.token = token;
+        lock.lock();
+        m_mipmapScratch.push_back(std::move(scratch));
+    }
+    return token;
 }
 
-size_t TransferManager::acquireStagingBuffer(vk::DeviceSize size)
+vk::Pipeline TransferManager::getMipmapPipeline(vk::Format format)
+{
+    auto it = m_mipmapPipelines.find(format);
+    if (it != m_mipmapPipelines.end())
+        return it->second;
+
+    const char *qualifier = storageFormatQualifier(format);
+    if (!qualifier)
+    {
+        m_mipmapPipelines.emplace(format, vk::Pipeline{});
+        return {};
+    }
+
+    vk::Device device = m_ctx->getDevice();
+    if (!m_mipmapPipelineLayout)
+    {
+        vk::SamplerCreateInfo samplerInfo{};
+        samplerInfo.magFilter = vk::Filter::eNearest;
+        samplerInfo.minFilter = vk::Filter::eNearest;
+        samplerInfo.mipmapMode = vk::SamplerMipmapMode::eNearest;
+        samplerInfo.addressModeU = vk::SamplerAddressMode::eClampToEdge;
+        samplerInfo.addressModeV = vk::SamplerAddressMode::eClampToEdge;
+        samplerInfo.addressModeW = vk::SamplerAddressMode::eClampToEdge;
+        m_mipmapSampler = device.createSampler(samplerInfo);
+
+        std::array<vk::DescriptorSetLayoutBinding, 2> bindings{};
+        bindings[0].binding = 0;
+        bindings[0].descriptorType = vk::DescriptorType::eCombinedImageSampler;
+        bindings[0].descriptorCount = 1;
+        bindings[0].stageFlags = vk::ShaderStageFlagBits::eCompute;
+        bindings[0].pImmutableSamplers = &m_mipmapSampler;
+        bindings[1].binding = 1;
+        bindings[1].descriptorType = vk::DescriptorType::eStorageImage;
+        bindings[1].descriptorCount = 1;
+        bindings[1].stageFlags = vk::ShaderStageFlagBits::eCompute;
+        vk::DescriptorSetLayoutCreateInfo setLayoutInfo{};
+        setLayoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        setLayoutInfo.pBindings = bindings.data();
+        m_mipmapSetLayout = device.createDescriptorSetLayout(setLayoutInfo);
+
+        vk::PipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &m_mipmapSetLayout;
+        m_mipmapPipelineLayout = device.createPipelineLayout(layoutInfo);
+    }
+
+    // 编译失败（如未启用shaderc）时记录空管线，该格式此后直接回退到blit
+    std::vector<uint32_t> spirv;
+    try
+    {
+        TRACE_SCOPE("TransferManager::compileMipmapShader");
+        spirv = VkUtils::compileGLSLToSPIRV(kMipmapDownsampleSource, vk::ShaderStageFlagBits::eCompute,
+                                            "mipmap_downsample.comp", {{"MIP_FORMAT", qualifier}});
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Compute mipmap downsampling unavailable: " << e.what() << std::endl;
+        m_mipmapPipelines.emplace(format, vk::Pipeline{});
+        return {};
+    }
+
+    vk::ShaderModuleCreateInfo moduleInfo{};
+    moduleInfo.codeSize = spirv.size() * sizeof(uint32_t);
+    moduleInfo.pCode = spirv.data();
+    vk::ShaderModule module = device.createShaderModule(moduleInfo);
+
+    vk::ComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.stage.stage = vk::ShaderStageFlagBits::eCompute;
+    pipelineInfo.stage.module = module;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.layout = m_mipmapPipelineLayout;
+    vk::Pipeline pipeline;
+    try
+    {
+        pipeline = device.createComputePipeline(m_ctx->getPipelineCache(), pipelineInfo).value;
+    }
+    catch (...)
+    {
+        device.destroyShaderModule(module);
+        throw;
+    }
+    device.destroyShaderModule(module);
+
+    m_mipmapPipelines.emplace(format, pipeline);
+    return pipeline;
+}
+
+void TransferManager::destroyMipmapScratch(MipmapScratch &scratch)
+{
+    vk::Device device = m_ctx->getDevice();
+    for (vk::ImageView view : scratch.views)
+    {
+        device.destroyImageView(view);
+    }
+    scratch.views.clear();
+    if (scratch.descriptorPool)
+        device.destroyDescriptorPool(scratch.descriptorPool);
+    scratch.descriptorPool = nullptr;
+}
+
+void TransferManager::reapMipmapScratch()
+{
+    auto done = std::stable_partition(m_mipmapScratch.begin(), m_mipmapScratch.end(),
+                                      [](const MipmapScratch &scratch) { return !scratch.token.isComplete(); });
+    for (auto it = done; it != m_mipmapScratch.end(); ++it)
+    {
+        destroyMipmapScratch(*it);
+    }
+    m_mipmapScratch.erase(done, m_mipmapScratch.end());
+}
+
+StagingAllocation TransferManager::allocateStaging(vk::DeviceSize size, vk::DeviceSize alignment)
 {
     if (!m_allocator)
         throw std::runtime_error("TransferManager allocator not set");
 
-    auto &resources = getThreadResources();
-    auto &pool = resources.stagingBufferPool;
+    auto &ring = getThreadResources().stagingRing;
+    m_stagingAllocations.fetch_add(1, std::memory_order_relaxed);
+    m_stagingBytes.fetch_add(size, std::memory_order_relaxed);
+    reclaimStaging(ring);
 
-    if (m_config.enableStagingBufferPool)
+    StagingAllocation result{};
+    result.size = size;
+
+    // 环从较小的初始大小按需倍增，超过上限的上传直接使用专用buffer，不让单次大上传把环撑到上限
+    const vk::DeviceSize maxCapacity = (std::max)(m_config.maxStagingRingSize, m_config.stagingRingSize);
+    if (m_config.stagingRingSize > 0 && size <= maxCapacity)
     {
-        // 找到可用的且容量足够的buffer
-        for (size_t i = 0; i < pool.size(); ++i)
+        if (!ring.buffer || size > ring.capacity)
+            growStagingRing(ring, size);
+
+        while (true)
         {
-            auto &info = pool[i];
-            if (!info.inUse && info.size >= size)
+            // 指针推进分配；尾部放不下时回绕到开头，尾部剩余空间留空
+            const vk::DeviceSize aligned = (ring.head + alignment - 1) / alignment * alignment;
+            std::optional<vk::DeviceSize> offset;
+            if (ring.head >= ring.tail)
             {
-                info.inUse = true;
-                return i;
+                if (aligned + size <= ring.capacity)
+                    offset = aligned;
+                else if (size < ring.tail)
+                    offset = 0;
+            }
+            else if (aligned + size < ring.tail)
+            {
+                offset = aligned;
             }
-        }
 
-        // 需要新建
-        if (pool.size() < m_config.maxPooledStagingBuffers)
-        {
-            vk::DeviceSize allocSize = max(size, static_cast<vk::DeviceSize>(m_config.minStagingBufferSize));
-            if (m_config.maxStagingBufferSize > 0)
-                allocSize = max(size, min(allocSize, m_config.maxStagingBufferSize));
+            if (offset)
+            {
+                ring.head = *offset + size;
+                StagingRing::Entry entry{};
+                entry.end = ring.head;
+                result.sequence = ring.firstSequence + ring.entries.size();
+                ring.entries.push_back(std::move(entry));
+
+                result.buffer = ring.buffer.getBuffer();
+                result.allocation = ring.buffer.getAllocation();
+                result.offset = *offset;
+                result.mapped = ring.mapped + *offset;
+                return result;
+            }
 
-            StagingBufferInfo info{};
-            info.buffer = createStagingBuffer(allocSize);
-            info.size = allocSize;
-            info.inUse = true;
-            pool.push_back(std::move(info));
-            return pool.size() - 1;
+            // 环已满：未达上限时先扩容，达到上限后才等待GPU
+            if (ring.capacity < maxCapacity)
+            {
+                growStagingRing(ring, ring.capacity * 2);
+                continue;
+            }
+
+            // 最早的分配尚未提交时等待会死锁，改用专用buffer
+            if (ring.entries.empty() || !ring.entries.front().submission)
+                break;
+
+            TRACE_SCOPE("TransferManager::stagingStall");
+            const auto start = std::chrono::steady_clock::now();
+            TransferToken{ring.entries.front().submission}.wait();
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            m_stagingStalls.fetch_add(1, std::memory_order_relaxed);
+            m_stagingStallNs.fetch_add(
+                static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                std::memory_order_relaxed);
+            reclaimStaging(ring);
         }
     }
 
-    // 非池化或池已满，创建独立的buffer
-    StagingBufferInfo info{};
-    info.buffer = createStagingBuffer(size);
-    info.size = size;
-    info.inUse = true;
-    pool.push_back(std::move(info));
-    return pool.size() - 1;
+    // 超出环上限（或环被未提交的分配占满）时创建一次性专用buffer，随提交一起回收
+    m_dedicatedStaging.fetch_add(1, std::memory_order_relaxed);
+    StagingRing::Entry entry{};
+    entry.end = ring.head;
+    entry.dedicated = createStagingBuffer(size);
+    void *mapped = nullptr;
+    if (vmaMapMemory(m_allocator->getAllocator(), entry.dedicated.getAllocation(), &mapped) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to map memory");
+    }
+    result.buffer = entry.dedicated.getBuffer();
+    result.allocation = entry.dedicated.getAllocation();
+    result.offset = 0;
+    result.mapped = static_cast<uint8_t *>(mapped);
+    result.sequence = ring.firstSequence + ring.entries.size();
+    ring.entries.push_back(std::move(entry));
+    return result;
 }
 
-void TransferManager::releaseStagingBuffer(size_t index)
+void TransferManager::growStagingRing(StagingRing &ring, vk::DeviceSize required)
 {
-    auto &resources = getThreadResources();
-    if (index < resources.stagingBufferPool.size())
+    const vk::DeviceSize maxCapacity = (std::max)(m_config.maxStagingRingSize, m_config.stagingRingSize);
+    vk::DeviceSize capacity = (std::max)(ring.capacity, m_config.stagingRingSize);
+    while (capacity < required)
+        capacity *= 2;
+    capacity = (std::min)(capacity, maxCapacity);
+
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::growStagingRing");
+    TRACE_SET_BYTES(traceZone, capacity);
+    ManagedBuffer buffer = createStagingBuffer(capacity);
+    void *mapped = nullptr;
+    if (vmaMapMemory(m_allocator->getAllocator(), buffer.getAllocation(), &mapped) != VK_SUCCESS)
     {
-        resources.stagingBufferPool[index].inUse = false;
+        throw std::runtime_error("failed to map staging ring");
     }
+
+    if (ring.buffer)
+    {
+        m_stagingRingGrowths.fetch_add(1, std::memory_order_relaxed);
+        m_stagingRingBytes.fetch_sub(ring.capacity, std::memory_order_relaxed);
+        if (ring.entries.empty())
+        {
+            vmaUnmapMemory(m_allocator->getAllocator(), ring.buffer.getAllocation());
+            ring.buffer.release();
+        }
+        else
+        {
+            // 旧分配回收时tail回到新环的起点；旧环排在队尾，按顺序回收时所有旧分配均已完成
+            for (auto &entry : ring.entries)
+                entry.end = 0;
+            StagingRing::Entry retired{};
+            retired.dedicated = std::move(ring.buffer);
+            retired.submission = std::make_shared<TransferToken::State>();
+            retired.submission->completed.store(true, std::memory_order_release);
+            ring.entries.push_back(std::move(retired));
+        }
+    }
+
+    m_stagingRingBytes.fetch_add(capacity, std::memory_order_relaxed);
+    ring.buffer = std::move(buffer);
+    ring.mapped = static_cast<uint8_t *>(mapped);
+    ring.capacity = capacity;
+    ring.head = 0;
+    ring.tail = 0;
 }
 
-void TransferManager::cleanupUnusedStagingBuffers()
+void TransferManager::writeStaging(const StagingAllocation &allocation, const void *data, vk::DeviceSize size)
 {
-    if (!m_config.enableStagingBufferPool)
-        return;
+    std::memcpy(allocation.mapped, data, static_cast<size_t>(size));
+    vmaFlushAllocation(m_allocator->getAllocator(), allocation.allocation, allocation.offset, size);
+}
 
-    auto &resources = getThreadResources();
-    auto &pool = resources.stagingBufferPool;
+bool TransferManager::tryDirectWrite(const ManagedBuffer &dstBuffer, const void *data, vk::DeviceSize size,
+                                     vk::DeviceSize dstOffset)
+{
+    auto *mapped = static_cast<uint8_t *>(dstBuffer.getMappedData());
+    if (!m_config.enableDirectWrite || !mapped)
+        return false;
+
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::directWrite");
+    TRACE_SET_BYTES(traceZone, size);
+    // 主机写入在下一次vkQueueSubmit时自动对设备可见，无需命令与同步
+    std::memcpy(mapped + dstOffset, data, static_cast<size_t>(size));
+    vmaFlushAllocation(m_allocator->getAllocator(), dstBuffer.getAllocation(), dstOffset, size);
+    m_directWrites.fetch_add(1, std::memory_order_relaxed);
+    m_directWriteBytes.fetch_add(size, std::memory_order_relaxed);
+    return true;
+}
+
+void TransferManager::abandonStaging(const std::vector<uint64_t> &sequences)
+{
+    // 用已完成的状态标记，使这些分配在下一次回收时释放
+    auto &ring = getThreadResources().stagingRing;
+    auto completed = std::make_shared<TransferToken::State>();
+    completed->completed.store(true, std::memory_order_release);
+    for (uint64_t sequence : sequences)
+    {
+        if (sequence >= ring.firstSequence && sequence - ring.firstSequence < ring.entries.size())
+            ring.entries[static_cast<size_t>(sequence - ring.firstSequence)].submission = completed;
+    }
+}
 
-    // 只保留前maxPooledStagingBuffers个空闲buffer
-    for (size_t i = pool.size(); i > 0; --i)
+void TransferManager::reclaimStaging(StagingRing &ring)
+{
+    // 按分配顺序回收，遇到未完成或未提交的分配即停止
+    while (!ring.entries.empty())
     {
-        if (pool.size() <= m_config.maxPooledStagingBuffers)
+        auto &entry = ring.entries.front();
+        if (!entry.submission || !TransferToken{entry.submission}.isComplete())
             break;
 
-        size_t idx = i - 1;
-        if (!pool[idx].inUse)
+        if (entry.dedicated)
         {
-            pool[idx].buffer.release();
-            pool.erase(pool.begin() + idx);
+            vmaUnmapMemory(m_allocator->getAllocator(), entry.dedicated.getAllocation());
+            entry.dedicated.release();
         }
+        ring.tail = entry.end;
+        ring.entries.pop_front();
+        ++ring.firstSequence;
     }
+
+    if (ring.entries.empty())
+    {
+        ring.head = 0;
+        ring.tail = 0;
+    }
+}
+
+StagingStats TransferManager::getStagingStats() const
+{
+    StagingStats stats;
+    stats.allocations = m_stagingAllocations.load(std::memory_order_relaxed);
+    stats.allocatedBytes = m_stagingBytes.load(std::memory_order_relaxed);
+    stats.stalls = m_stagingStalls.load(std::memory_order_relaxed);
+    stats.stallTimeMs = static_cast<double>(m_stagingStallNs.load(std::memory_order_relaxed)) / 1.0e6;
+    stats.dedicatedAllocations = m_dedicatedStaging.load(std::memory_order_relaxed);
+    stats.directWrites = m_directWrites.load(std::memory_order_relaxed);
+    stats.directWriteBytes = m_directWriteBytes.load(std::memory_order_relaxed);
+    stats.ringGrowths = m_stagingRingGrowths.load(std::memory_order_relaxed);
+    stats.ringBytes = m_stagingRingBytes.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(m_resourcesMutex);
+    stats.ringCount = m_threadResources.size();
+    return stats;
+}
+
+CommandBufferStats TransferManager::getCommandBufferStats() const
+{
+    CommandBufferStats stats;
+    stats.allocations = m_commandBufferAllocations.load(std::memory_order_relaxed);
+    stats.reuses = m_commandBufferReuses.load(std::memory_order_relaxed);
+    stats.frees = m_commandBufferFrees.load(std::memory_order_relaxed);
+    return stats;
 }
 
 vk::CommandBuffer TransferManager::beginOneTimeCommands(TransferQueueType queueType)
 {
     auto &resources = getThreadResources();
-    vk::CommandPool pool =
-        (queueType == TransferQueueType::Transfer) ? resources.transferCommandPool : resources.graphicsCommandPool;
-    vk::CommandBufferAllocateInfo allocInfo{};
-    allocInfo.level = vk::CommandBufferLevel::ePrimary;
-    allocInfo.commandPool = pool;
-    allocInfo.commandBufferCount = 1;
+    const bool transfer = queueType == TransferQueueType::Transfer;
+    vk::CommandPool pool = transfer ? resources.transferCommandPool : resources.graphicsCommandPool;
+    auto &freeList = transfer ? resources.freeTransferCommandBuffers : resources.freeGraphicsCommandBuffers;
+    if (freeList.empty())
+        retireSubmissions(resources);
+
+    vk::CommandBuffer cmdBuffer;
+    if (!freeList.empty())
+    {
+        // 命令池带有ResetCommandBuffer标志，单独重置比释放后重新分配开销小
+        cmdBuffer = freeList.back();
+        freeList.pop_back();
+        cmdBuffer.reset();
+        m_commandBufferReuses.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        vk::CommandBufferAllocateInfo allocInfo{};
+        allocInfo.level = vk::CommandBufferLevel::ePrimary;
+        allocInfo.commandPool = pool;
+        allocInfo.commandBufferCount = 1;
+        cmdBuffer = m_ctx->getDevice().allocateCommandBuffers(allocInfo)[0];
+        m_commandBufferAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
 
-    vk::CommandBuffer cmdBuffer = m_ctx->getDevice().allocateCommandBuffers(allocInfo)[0];
     vk::CommandBufferBeginInfo beginInfo{};
     beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
     cmdBuffer.begin(beginInfo);
@@ -422,99 +1775,794 @@ vk::CommandBuffer TransferManager::beginOneTimeCommands(TransferQueueType queueT
 }
 
 TransferToken TransferManager::endOneTimeCommands(vk::CommandBuffer cmdBuffer, TransferQueueType queueType,
-                                                  std::vector<size_t> stagingBuffersToRelease)
+                                                  const std::vector<uint64_t> &stagingSequences)
 {
     cmdBuffer.end();
 
-    vk::SubmitInfo submitInfo{};
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmdBuffer;
-
     vk::Queue queue;
-    if (queueType == TransferQueueType::Transfer && m_ctx->getQueueFamilyIndices().transferFamily.has_value())
+    if (queueType == TransferQueueType::Transfer && hasDedicatedTransferQueue())
         queue = m_ctx->getTransferQueue();
     else
         queue = m_ctx->getGraphicsQueue();
 
     auto &resources = getThreadResources();
+
+    // 先回收staging与已完成的提交
+    reclaimStaging(resources.stagingRing);
+    retireSubmissions(resources);
+
+    // 在锁内分配信号值并提交，保证时间线上的值按提交顺序递增
+    const size_t index = timelineIndex(queueType);
+    QueueTimeline &timeline = m_timelines[index];
+    uint64_t signalValue = 0;
+    {
+        std::lock_guard<std::mutex> lock(timeline.submitMutex);
+        signalValue = timeline.lastSubmitted.load(std::memory_order_relaxed) + 1;
+
+        vk::TimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.signalSemaphoreValueCount = 1;
+        timelineInfo.pSignalSemaphoreValues = &signalValue;
+
+        vk::SubmitInfo submitInfo{};
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &cmdBuffer;
+        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.pSignalSemaphores = &timeline.semaphore;
+        queue.submit(submitInfo);
+
+        timeline.lastSubmitted.store(signalValue, std::memory_order_release);
+    }
+
+    vk::CommandPool pool =
+        (queueType == TransferQueueType::Transfer) ? resources.transferCommandPool : resources.graphicsCommandPool;
+
+    // 创建 token state
+    auto tokenState = std::make_shared<TransferToken::State>();
+    tokenState->device = m_ctx->getDevice();
+    tokenState->semaphore = timeline.semaphore;
+    tokenState->value = signalValue;
+
+    // 记录提交
+    ThreadResources::PendingSubmission submission{};
+    submission.value = signalValue;
+    submission.cmdBuffer = cmdBuffer;
+    submission.commandPool = pool;
+    resources.pendingSubmissions[index].push_back(submission);
+
+    // staging分配在时间线达到该值后回收
+    auto &ring = resources.stagingRing;
+    for (uint64_t sequence : stagingSequences)
+    {
+        if (sequence >= ring.firstSequence && sequence - ring.firstSequence < ring.entries.size())
+            ring.entries[static_cast<size_t>(sequence - ring.firstSequence)].submission = tokenState;
+    }
+
+    return TransferToken{tokenState};
+}
+
+void TransferManager::retireSubmissions(ThreadResources &resources)
+{
     vk::Device device = m_ctx->getDevice();
+    for (size_t i = 0; i < kTimelineCount; ++i)
+    {
+        auto &pending = resources.pendingSubmissions[i];
+        if (pending.empty())
+            continue;
 
-    // 检查并清理已完成的提交
-    for (auto it = resources.activeSubmissions.begin(); it != resources.activeSubmissions.end();)
+        // 每条时间线只读一次计数，按顺序回收已完成的命令缓冲
+        const uint64_t completed = device.getSemaphoreCounterValue(m_timelines[i].semaphore);
+        while (!pending.empty() && pending.front().value <= completed)
+        {
+            const auto &submission = pending.front();
+            auto &freeList = submission.commandPool == resources.transferCommandPool
+                                 ? resources.freeTransferCommandBuffers
+                                 : resources.freeGraphicsCommandBuffers;
+            if (freeList.size() < kMaxFreeCommandBuffers)
+            {
+                freeList.push_back(submission.cmdBuffer);
+            }
+            else
+            {
+                device.freeCommandBuffers(submission.commandPool, submission.cmdBuffer);
+                m_commandBufferFrees.fetch_add(1, std::memory_order_relaxed);
+            }
+            pending.pop_front();
+        }
+    }
+}
+
+void TransferManager::reclaimExitedThreads()
+{
+    vk::Device device = m_ctx->getDevice();
+    for (auto it = m_threadResources.begin(); it != m_threadResources.end();)
     {
-        bool signaled = false;
-        if (it->tokenState->completed.load(std::memory_order_acquire))
+        ThreadResources &resources = **it;
+        if (!resources.threadExited.load(std::memory_order_acquire))
         {
-            signaled = true;
+            ++it;
+            continue;
         }
-        else if (device.getFenceStatus(it->tokenState->fence) == vk::Result::eSuccess)
+
+        // 线程已退出，未提交的staging分配不会再被提交，直接视为完成
+        auto &ring = resources.stagingRing;
+        auto abandoned = std::make_shared<TransferToken::State>();
+        abandoned->completed.store(true, std::memory_order_release);
+        for (auto &entry : ring.entries)
         {
-            it->tokenState->completed.store(true, std::memory_order_release);
-            signaled = true;
+            if (!entry.submission)
+                entry.submission = abandoned;
         }
+        reclaimStaging(ring);
+        retireSubmissions(resources);
 
-        // 只清理已经没有外部引用的完成提交
-        if (signaled && it->tokenState.use_count() == 1)
+        const bool idle = ring.entries.empty() &&
+                          std::all_of(resources.pendingSubmissions.begin(), resources.pendingSubmissions.end(),
+                                      [](const auto &pending) { return pending.empty(); });
+        if (!idle)
         {
-            // 释放资源
-            device.resetFences(1, &it->tokenState->fence);
-            resources.fencePool.push_back(it->tokenState->fence);
+            ++it;
+            continue;
+        }
+
+        if (resources.transferCommandPool)
+            device.destroyCommandPool(resources.transferCommandPool);
+        if (resources.graphicsCommandPool)
+            device.destroyCommandPool(resources.graphicsCommandPool);
+        if (ring.buffer)
+        {
+            m_stagingRingBytes.fetch_sub(ring.capacity, std::memory_order_relaxed);
+            vmaUnmapMemory(m_allocator->getAllocator(), ring.buffer.getAllocation());
+            ring.buffer.release();
+        }
+        it = m_threadResources.erase(it);
+    }
+}
 
-            // 释放staging buffers
-            for (size_t idx : it->stagingBuffersToRelease)
+TransferToken TransferManager::enqueueServiceRequest(std::unique_ptr<ServiceRequest> request)
+{
+    // 令牌在提交前创建：信号量固定为传输时间线，值由传输线程在提交后写入
+    auto state = std::make_shared<TransferToken::State>();
+    state->device = m_ctx->getDevice();
+    state->semaphore = m_timelines[timelineIndex(TransferQueueType::Transfer)].semaphore;
+    request->token = state;
+
+    ServiceRequest *node = request.release();
+    ServiceRequest *head = m_serviceHead.load(std::memory_order_relaxed);
+    do
+    {
+        node->next = head;
+    } while (!m_serviceHead.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+    m_serviceSignal.fetch_add(1, std::memory_order_release);
+    m_serviceSignal.notify_one();
+    return TransferToken{state};
+}
+
+void TransferManager::serviceLoop()
+{
+    TRACE_THREAD_NAME("TransferService");
+    std::vector<std::unique_ptr<ServiceRequest>> requests;
+    while (true)
+    {
+        // 先读信号再取链表：取空之后的入队必然改变信号，wait不会错过唤醒
+        const uint32_t signal = m_serviceSignal.load(std::memory_order_acquire);
+        ServiceRequest *list = m_serviceHead.exchange(nullptr, std::memory_order_acquire);
+        if (!list)
+        {
+            if (m_serviceStop.load(std::memory_order_acquire))
+                break;
+            m_serviceSignal.wait(signal, std::memory_order_acquire);
+            continue;
+        }
+
+        // 链表为后进先出，反转后按入队顺序处理
+        requests.clear();
+        for (ServiceRequest *node = list; node;)
+        {
+            ServiceRequest *next = node->next;
+            requests.emplace_back(node);
+            node = next;
+        }
+        std::reverse(requests.begin(), requests.end());
+        submitServiceRequests(requests);
+
+        std::lock_guard<std::mutex> lock(m_resourcesMutex);
+        reclaimExitedThreads();
+    }
+}
+
+void TransferManager::submitServiceRequests(std::vector<std::unique_ptr<ServiceRequest>> &requests)
+{
+    TRACE_SCOPE_NAMED(traceZone, "TransferService::submit");
+    TRACE_SET_DETAIL(traceZone, std::to_string(requests.size()) + " requests");
+
+    // 单次提交的staging不超过环上限的一半，避免批次自身占满环而退化为专用buffer
+    const vk::DeviceSize maxRingSize = (std::max)(m_config.maxStagingRingSize, m_config.stagingRingSize);
+    const vk::DeviceSize submitBytes = (std::max)(maxRingSize / 2, vk::DeviceSize{1});
+    UploadBatch batch = createUploadBatch();
+    size_t first = 0;
+    vk::DeviceSize bytes = 0;
+    auto flush = [&](size_t end) {
+        if (first == end)
+            return;
+        TransferToken token;
+        bool submitted = true;
+        std::string error;
+        try
+        {
+            token = batch.submit();
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Transfer service failed to submit uploads: " << e.what() << std::endl;
+            batch = createUploadBatch();
+            submitted = false;
+            error = e.what();
+        }
+
+        const uint64_t value = token.getValue();
+        for (size_t i = first; i < end; ++i)
+        {
+            auto &state = requests[i]->token;
+            if (!submitted)
+            {
+                state->fail(error);
+                continue;
+            }
+            // 空批次没有GPU工作，直接视为完成；完成标记先于值写入，醒来的等待者即可看到
+            if (value == 0)
+            {
+                state->completed.store(true, std::memory_order_release);
+                state->value.store(1, std::memory_order_release);
+            }
+            else
             {
-                releaseStagingBuffer(idx);
+                state->value.store(value, std::memory_order_release);
             }
+            state->value.notify_all();
+        }
+        TRACE_SET_BYTES(traceZone, bytes);
+        first = end;
+    };
+
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        const ServiceRequest &request = *requests[i];
+        if (request.dstBuffer)
+            batch.recordBufferCopy(request.dstBuffer, request.data.get(), request.size, request.dstOffset);
+        else
+            batch.recordImageCopy(request.dstImage, request.data.get(), request.size, request.alignment,
+                                  request.extent, request.mipLevel, request.arrayLayer,
+                                  vk::ImageLayout::eShaderReadOnlyOptimal);
+        bytes += request.size;
+        if (batch.getStagingBytes() >= submitBytes)
+            flush(i + 1);
+    }
+    flush(requests.size());
+}
+
+void TransferManager::stopTransferService()
+{
+    if (!m_serviceThread.joinable())
+        return;
+
+    m_serviceStop.store(true, std::memory_order_release);
+    m_serviceSignal.fetch_add(1, std::memory_order_release);
+    m_serviceSignal.notify_one();
+    m_serviceThread.join();
+    m_serviceRunning.store(false, std::memory_order_release);
+
+    // 与停止竞争而晚到的请求不再提交，令牌标记为失败并唤醒等待者
+    ServiceRequest *list = m_serviceHead.exchange(nullptr, std::memory_order_acquire);
+    while (list)
+    {
+        std::unique_ptr<ServiceRequest> request(list);
+        list = request->next;
+        request->token->fail("transfer service stopped before the upload was submitted");
+    }
+}
+
+void TransferManager::then(const TransferToken &token, std::function<void(const TransferToken &)> callback)
+{
+    if (!callback)
+        return;
+    if (token.isComplete())
+    {
+        callback(token);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_continuationMutex);
+        m_continuations.push_back(Continuation{token, std::move(callback)});
+    }
+    m_continuationCv.notify_one();
+}
+
+std::shared_future<void> TransferManager::toFuture(const TransferToken &token)
+{
+    auto promise = std::make_shared<std::promise<void>>();
+    std::shared_future<void> future = promise->get_future().share();
+    then(token, [promise](const TransferToken &done) {
+        if (done.isFailed())
+            promise->set_exception(std::make_exception_ptr(std::runtime_error("Transfer failed: " + done.getError())));
+        else
+            promise->set_value();
+    });
+    return future;
+}
+
+size_t TransferManager::processCompletions()
+{
+    if (!m_ctx)
+        return 0;
+
+    std::vector<Continuation> ready;
+    {
+        std::lock_guard<std::mutex> lock(m_continuationMutex);
+        if (m_continuations.empty())
+            return 0;
+
+        // 同一批次的回调通常共享令牌，每条时间线只查询一次计数
+        vk::Device device = m_ctx->getDevice();
+        std::array<uint64_t, kTimelineCount> counters{};
+        for (size_t i = 0; i < kTimelineCount; ++i)
+        {
+            counters[i] = device.getSemaphoreCounterValue(m_timelines[i].semaphore);
+        }
+        auto pending = [&](const Continuation &continuation) {
+            const auto &state = continuation.token.state;
+            if (!state || state->completed.load(std::memory_order_acquire))
+                return false;
+            const uint64_t value = state->value.load(std::memory_order_acquire);
+            if (value == 0)
+                return true;
+            for (size_t i = 0; i < kTimelineCount; ++i)
+            {
+                if (state->semaphore == m_timelines[i].semaphore)
+                    return counters[i] < value;
+            }
+            return !continuation.token.isComplete();
+        };
+        auto split = std::stable_partition(m_continuations.begin(), m_continuations.end(), pending);
+        std::move(split, m_continuations.end(), std::back_inserter(ready));
+        m_continuations.erase(split, m_continuations.end());
+    }
+    if (ready.empty())
+        return 0;
+
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::processCompletions");
+    TRACE_SET_DETAIL(traceZone, std::to_string(ready.size()) + " callbacks");
+    for (auto &continuation : ready)
+    {
+        try
+        {
+            continuation.callback(continuation.token);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Transfer completion callback failed: " << e.what() << std::endl;
+        }
+    }
+    return ready.size();
+}
+
+void TransferManager::completionLoop()
+{
+    TRACE_THREAD_NAME("TransferCompletion");
+    vk::Device device = m_ctx->getDevice();
+    std::unique_lock<std::mutex> lock(m_continuationMutex);
+    while (!m_completionStop)
+    {
+        if (m_continuations.empty())
+        {
+            m_continuationCv.wait(lock);
+            continue;
+        }
+
+        // 每条时间线等待最早的未完成值，任一到达即唤醒
+        std::array<vk::Semaphore, kTimelineCount> semaphores{};
+        std::array<uint64_t, kTimelineCount> values{};
+        uint32_t count = 0;
+        for (size_t i = 0; i < kTimelineCount; ++i)
+        {
+            uint64_t earliest = UINT64_MAX;
+            for (const auto &continuation : m_continuations)
+            {
+                const auto &state = continuation.token.state;
+                const uint64_t value = continuation.token.getValue();
+                if (state && state->semaphore == m_timelines[i].semaphore && value != 0)
+                    earliest = (std::min)(earliest, value);
+            }
+            if (earliest != UINT64_MAX)
+            {
+                semaphores[count] = m_timelines[i].semaphore;
+                values[count] = earliest;
+                ++count;
+            }
+        }
+
+        // 只剩传输服务尚未提交的令牌（值为0）时定期复查
+        if (count == 0)
+        {
+            m_continuationCv.wait_for(lock, std::chrono::nanoseconds(kCompletionWaitTimeoutNs));
+            lock.unlock();
+            processCompletions();
+            lock.lock();
+            continue;
+        }
 
-            // 释放command buffer
-            device.freeCommandBuffers(it->commandPool, it->cmdBuffer);
+        lock.unlock();
+        vk::SemaphoreWaitInfo waitInfo{};
+        waitInfo.flags = vk::SemaphoreWaitFlagBits::eAny;
+        waitInfo.semaphoreCount = count;
+        waitInfo.pSemaphores = semaphores.data();
+        waitInfo.pValues = values.data();
+        try
+        {
+            // 超时属于正常返回，用于处理等待期间登记的回调与停止请求
+            (void)device.waitSemaphores(waitInfo, kCompletionWaitTimeoutNs);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Transfer completion wait failed: " << e.what() << std::endl;
+        }
+        processCompletions();
+        lock.lock();
+    }
+}
 
-            it = resources.activeSubmissions.erase(it);
+void TransferManager::stopCompletionThread()
+{
+    if (!m_completionThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_continuationMutex);
+        m_completionStop = true;
+    }
+    m_continuationCv.notify_all();
+    m_completionThread.join();
+}
+
+size_t TransferManager::timelineIndex(TransferQueueType queueType) const
+{
+    // 没有专用传输队列时传输也提交到图形队列，共用图形队列的时间线
+    if (queueType == TransferQueueType::Transfer && hasDedicatedTransferQueue())
+        return 0;
+    return 1;
+}
+
+bool TransferManager::hasDedicatedTransferQueue() const
+{
+    // 传输队列族与图形队列族相同时 getTransferQueue() 就是图形队列
+    const auto queueFamilies = m_ctx->getQueueFamilyIndices();
+    return queueFamilies.transferFamily.has_value() && queueFamilies.transferFamily != queueFamilies.graphicsFamily;
+}
+
+void TransferManager::recordFinalImageBarriers(vk::CommandBuffer cmd, TransferQueueType queueType,
+                                               std::vector<vk::ImageMemoryBarrier> &barriers,
+                                               std::vector<PendingAcquire> &acquires) const
+{
+    const bool release = queueType == TransferQueueType::Transfer && hasDedicatedTransferQueue();
+    const auto queueFamilies = m_ctx->getQueueFamilyIndices();
+
+    vk::PipelineStageFlags dstStages{};
+    for (auto &barrier : barriers)
+    {
+        BarrierInfo toFinal = getBarrierInfo(vk::ImageLayout::eTransferDstOptimal, barrier.newLayout);
+        barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+        barrier.srcAccessMask = toFinal.srcAccessMask;
+        if (release)
+        {
+            // 释放屏障只需让复制写入完成，目标访问由图形队列的获取屏障提供
+            barrier.srcQueueFamilyIndex = queueFamilies.transferFamily.value();
+            barrier.dstQueueFamilyIndex = queueFamilies.graphicsFamily.value();
+            barrier.dstAccessMask = {};
+
+            PendingAcquire acquire{};
+            acquire.barrier = barrier;
+            acquire.barrier.srcAccessMask = {};
+            acquire.barrier.dstAccessMask = toFinal.dstAccessMask;
+            acquire.dstStage = toFinal.dstStage;
+            acquires.push_back(acquire);
         }
         else
         {
-            ++it;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstAccessMask = toFinal.dstAccessMask;
+            dstStages |= toFinal.dstStage;
         }
     }
 
-    // 获取可用的fence
-    vk::Fence fence;
-    if (!resources.fencePool.empty())
+    cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                        release ? vk::PipelineStageFlags(vk::PipelineStageFlagBits::eBottomOfPipe) : dstStages, {},
+                        nullptr, nullptr, barriers);
+}
+
+void TransferManager::registerAcquires(std::vector<PendingAcquire> acquires, const TransferToken &token)
+{
+    if (acquires.empty())
+        return;
+    for (auto &acquire : acquires)
     {
-        fence = resources.fencePool.back();
-        resources.fencePool.pop_back();
+        acquire.token = token;
     }
-    else
+    std::lock_guard<std::mutex> lock(m_acquireMutex);
+    std::move(acquires.begin(), acquires.end(), std::back_inserter(m_pendingAcquires));
+}
+
+std::vector<TransferManager::PendingAcquire> TransferManager::takeReadyAcquires(const std::vector<vk::Image> &images)
+{
+    std::vector<PendingAcquire> ready;
+    std::lock_guard<std::mutex> lock(m_acquireMutex);
+    auto split = std::stable_partition(
+        m_pendingAcquires.begin(), m_pendingAcquires.end(), [&](const PendingAcquire &acquire) {
+            return !acquire.token.isComplete() ||
+                   (!images.empty() && std::find(images.begin(), images.end(), acquire.barrier.image) == images.end());
+        });
+    std::copy_if(std::make_move_iterator(split), std::make_move_iterator(m_pendingAcquires.end()),
+                 std::back_inserter(ready), [](const PendingAcquire &acquire) { return !acquire.token.isFailed(); });
+    m_pendingAcquires.erase(split, m_pendingAcquires.end());
+    return ready;
+}
+
+TransferToken TransferManager::recordPendingAcquires(vk::CommandBuffer graphicsCmd)
+{
+    if (!m_ctx)
+        return {};
+
+    // 只获取上传已完成的图像：资源在令牌完成后才会被发布使用，未完成的留到之后的帧
+    std::vector<PendingAcquire> ready = takeReadyAcquires();
+    if (ready.empty())
+        return {};
+
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::recordPendingAcquires");
+    TRACE_SET_DETAIL(traceZone, std::to_string(ready.size()) + " images");
+    std::vector<vk::ImageMemoryBarrier> barriers;
+    barriers.reserve(ready.size());
+    vk::PipelineStageFlags dstStages{};
+    TransferToken latest;
+    for (const auto &acquire : ready)
     {
-        vk::FenceCreateInfo fenceInfo{};
-        fence = device.createFence(fenceInfo);
+        barriers.push_back(acquire.barrier);
+        dstStages |= acquire.dstStage;
+        if (acquire.token.getValue() > latest.getValue())
+            latest = acquire.token;
     }
+    // 源阶段与提交时等待时间线的阶段一致，保证获取发生在信号量等待之后
+    graphicsCmd.pipelineBarrier(dstStages, dstStages, {}, nullptr, nullptr, barriers);
+    return latest;
+}
 
-    queue.submit(submitInfo, fence);
+ReadbackResult TransferManager::readbackBuffer(const ManagedBuffer &srcBuffer, vk::DeviceSize size,
+                                               vk::DeviceSize srcOffset)
+{
+    if (!m_ctx)
+        throw std::runtime_error("TransferManager is not initialized");
+    if (!srcBuffer)
+        throw std::runtime_error("Source buffer is invalid");
+    const vk::DeviceSize bufferSize = srcBuffer.getSize();
+    if (srcOffset >= bufferSize)
+        throw std::out_of_range("srcOffset exceeds source buffer size");
+    if (size == 0 || size > bufferSize - srcOffset)
+        throw std::out_of_range("Readback size exceeds source buffer size");
+
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::readbackBuffer");
+    TRACE_SET_BYTES(traceZone, size);
+
+    ReadbackResult result;
+    result.m_owner = this;
+    result.m_buffer = acquireReadbackBuffer(size);
+    result.m_size = size;
+
+    // 在图形队列上执行：源数据通常由本帧的渲染或计算写入，同队列的提交顺序加屏障即可保证可见
+    vk::CommandBuffer cmd = beginOneTimeCommands(TransferQueueType::Graphics);
+    vk::MemoryBarrier toTransfer{};
+    toTransfer.srcAccessMask = vk::AccessFlagBits::eMemoryWrite;
+    toTransfer.dstAccessMask = vk::AccessFlagBits::eTransferRead;
+    cmd.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands, vk::PipelineStageFlagBits::eTransfer, {}, toTransfer,
+                        nullptr, nullptr);
+
+    vk::BufferCopy region{};
+    region.srcOffset = srcOffset;
+    region.dstOffset = 0;
+    region.size = size;
+    cmd.copyBuffer(srcBuffer.getBuffer(), result.m_buffer->buffer.getBuffer(), 1, &region);
+
+    vk::BufferMemoryBarrier toHost{};
+    toHost.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    toHost.dstAccessMask = vk::AccessFlagBits::eHostRead;
+    toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.buffer = result.m_buffer->buffer.getBuffer();
+    toHost.offset = 0;
+    toHost.size = size;
+    cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eHost, {}, nullptr, toHost,
+                        nullptr);
+
+    result.m_token = endOneTimeCommands(cmd, TransferQueueType::Graphics);
+    return result;
+}
 
-    vk::CommandPool pool =
-        (queueType == TransferQueueType::Transfer) ? resources.transferCommandPool : resources.graphicsCommandPool;
+ReadbackResult TransferManager::readbackImage(vk::Image image, vk::Format format, vk::Extent3D extent,
+                                              vk::ImageLayout currentLayout, vk::ImageAspectFlags aspectMask,
+                                              uint32_t mipLevel, uint32_t arrayLayer)
+{
+    if (!m_ctx)
+        throw std::runtime_error("TransferManager is not initialized");
+    if (!image)
+        throw std::runtime_error("Source image is invalid");
+    if (currentLayout == vk::ImageLayout::eUndefined || currentLayout == vk::ImageLayout::ePreinitialized)
+        throw std::invalid_argument("readbackImage requires the current image layout");
+
+    const uint32_t texelSize = VkUtils::getFormatSize(format);
+    if (texelSize == 0)
+        throw std::runtime_error("Unsupported format for image readback");
+    const vk::DeviceSize size =
+        static_cast<vk::DeviceSize>(extent.width) * extent.height * (std::max)(extent.depth, 1u) * texelSize;
+    if (size == 0)
+        throw std::out_of_range("Image readback extent is empty");
+
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::readbackImage");
+    TRACE_SET_BYTES(traceZone, size);
+
+    ReadbackResult result;
+    result.m_owner = this;
+    result.m_buffer = acquireReadbackBuffer(size);
+    result.m_size = size;
 
-    // 创建 token state
-    auto tokenState = std::make_shared<TransferToken::State>();
-    tokenState->fence = fence;
-    tokenState->device = device;
-    tokenState->completed.store(false, std::memory_order_release);
+    vk::CommandBuffer cmd = beginOneTimeCommands(TransferQueueType::Graphics);
 
-    // 记录提交
-    ThreadResources::PendingSubmission submission{};
-    submission.tokenState = tokenState;
-    submission.cmdBuffer = cmdBuffer;
-    submission.commandPool = pool;
-    submission.stagingBuffersToRelease = stagingBuffersToRelease;
+    BarrierInfo toTransferInfo = getBarrierInfo(currentLayout, vk::ImageLayout::eTransferSrcOptimal);
+    vk::ImageMemoryBarrier barrier{};
+    barrier.oldLayout = currentLayout;
+    barrier.newLayout = vk::ImageLayout::eTransferSrcOptimal;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = aspectMask;
+    barrier.subresourceRange.baseMipLevel = mipLevel;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = arrayLayer;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.srcAccessMask = toTransferInfo.srcAccessMask;
+    barrier.dstAccessMask = toTransferInfo.dstAccessMask;
+    cmd.pipelineBarrier(toTransferInfo.srcStage, toTransferInfo.dstStage, {}, nullptr, nullptr, barrier);
+
+    // 行紧密排列，读取时无需考虑行距
+    vk::BufferImageCopy region{};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = aspectMask;
+    region.imageSubresource.mipLevel = mipLevel;
+    region.imageSubresource.baseArrayLayer = arrayLayer;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = vk::Offset3D{0, 0, 0};
+    region.imageExtent = vk::Extent3D{extent.width, extent.height, (std::max)(extent.depth, 1u)};
+    cmd.copyImageToBuffer(image, vk::ImageLayout::eTransferSrcOptimal, result.m_buffer->buffer.getBuffer(), 1,
+                          &region);
+
+    // 恢复原布局，调用方无需关心回读期间的布局变化
+    BarrierInfo restoreInfo = getBarrierInfo(vk::ImageLayout::eTransferSrcOptimal, currentLayout);
+    barrier.oldLayout = vk::ImageLayout::eTransferSrcOptimal;
+    barrier.newLayout = currentLayout;
+    barrier.srcAccessMask = restoreInfo.srcAccessMask;
+    barrier.dstAccessMask = restoreInfo.dstAccessMask;
+
+    vk::BufferMemoryBarrier toHost{};
+    toHost.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    toHost.dstAccessMask = vk::AccessFlagBits::eHostRead;
+    toHost.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toHost.buffer = result.m_buffer->buffer.getBuffer();
+    toHost.offset = 0;
+    toHost.size = size;
+    cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, restoreInfo.dstStage | vk::PipelineStageFlagBits::eHost,
+                        {}, nullptr, toHost, barrier);
+
+    result.m_token = endOneTimeCommands(cmd, TransferQueueType::Graphics);
+    return result;
+}
 
-    resources.activeSubmissions.push_back(submission);
+ReadbackResult TransferManager::readbackImage(const ManagedImage &image, vk::ImageLayout currentLayout)
+{
+    return readbackImage(image.getImage(), image.getFormat(), image.getExtent(), currentLayout, image.getAspectMask());
+}
 
-    return TransferToken{tokenState};
+ReadbackBuffer *TransferManager::acquireReadbackBuffer(vk::DeviceSize size)
+{
+    std::lock_guard<std::mutex> lock(m_readbackMutex);
+
+    // 选择容量足够的最小空闲buffer，上一次回读尚未完成的不能复用
+    ReadbackBuffer *best = nullptr;
+    for (auto &entry : m_readbackPool)
+    {
+        if (entry->inUse || entry->capacity < size || !entry->lastUse.isComplete())
+            continue;
+        if (!best || entry->capacity < best->capacity)
+            best = entry.get();
+    }
+    if (best)
+    {
+        best->inUse = true;
+        return best;
+    }
+
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::createReadbackBuffer");
+    auto entry = std::make_unique<ReadbackBuffer>();
+    entry->capacity = (std::max)(size, m_config.minReadbackBufferSize);
+    TRACE_SET_BYTES(traceZone, entry->capacity);
+
+    BufferDesc desc{};
+    desc.size = entry->capacity;
+    desc.usage = BufferUsageFlags::TransferDst;
+    desc.memory = MemoryUsage::GpuToCpu;
+    desc.debugName = "TransferManager_Readback";
+    entry->buffer = m_allocator->createBuffer(desc);
+
+    // 持久映射，复用时不再重新映射
+    void *mapped = nullptr;
+    if (vmaMapMemory(m_allocator->getAllocator(), entry->buffer.getAllocation(), &mapped) != VK_SUCCESS)
+    {
+        throw std::runtime_error("failed to map readback buffer");
+    }
+    entry->mapped = static_cast<uint8_t *>(mapped);
+    entry->inUse = true;
+    m_readbackPool.push_back(std::move(entry));
+    return m_readbackPool.back().get();
+}
+
+void TransferManager::releaseReadbackBuffer(ReadbackBuffer *buffer, const TransferToken &lastUse)
+{
+    std::lock_guard<std::mutex> lock(m_readbackMutex);
+    buffer->inUse = false;
+    buffer->lastUse = lastUse;
+
+    // 空闲buffer超出上限时销毁已完成的最小buffer，大buffer留给后续的大回读
+    size_t freeCount = static_cast<size_t>(std::count_if(
+        m_readbackPool.begin(), m_readbackPool.end(), [](const auto &entry) { return !entry->inUse; }));
+    while (freeCount > m_config.maxPooledReadbackBuffers)
+    {
+        auto victim = m_readbackPool.end();
+        for (auto it = m_readbackPool.begin(); it != m_readbackPool.end(); ++it)
+        {
+            const auto &entry = *it;
+            if (entry->inUse || !entry->lastUse.isComplete())
+                continue;
+            if (victim == m_readbackPool.end() || entry->capacity < (*victim)->capacity)
+                victim = it;
+        }
+        if (victim == m_readbackPool.end())
+            break;
+        vmaUnmapMemory(m_allocator->getAllocator(), (*victim)->buffer.getAllocation());
+        (*victim)->buffer.release();
+        m_readbackPool.erase(victim);
+        --freeCount;
+    }
+}
+
+vk::Semaphore TransferManager::getTimelineSemaphore(TransferQueueType queueType) const
+{
+    if (!m_ctx)
+        return {};
+    return m_timelines[timelineIndex(queueType)].semaphore;
+}
+
+uint64_t TransferManager::getLastSubmittedValue(TransferQueueType queueType) const
+{
+    if (!m_ctx)
+        return 0;
+    return m_timelines[timelineIndex(queueType)].lastSubmitted.load(std::memory_order_acquire);
 }
 
 ManagedBuffer TransferManager::createStagingBuffer(vk::DeviceSize size)
 {
+    TRACE_SCOPE_NAMED(traceZone, "TransferManager::createStagingBuffer");
+    TRACE_SET_BYTES(traceZone, size);
     BufferDesc desc{};
     desc.size = size;
     desc.usage = BufferUsageFlags::StagingSrc | BufferUsageFlags::TransferSrc;
@@ -525,7 +2573,21 @@ ManagedBuffer TransferManager::createStagingBuffer(vk::DeviceSize size)
 
 TransferManager::ThreadResources &TransferManager::getThreadResources()
 {
-    static thread_local std::unordered_map<TransferManager *, std::weak_ptr<ThreadResources>> tls_resources;
+    // 线程退出时标记其资源，GPU完成后由reclaimExitedThreads回收
+    struct ThreadSlots
+    {
+        std::unordered_map<TransferManager *, std::weak_ptr<ThreadResources>> slots;
+        ~ThreadSlots()
+        {
+            for (auto &[manager, weak] : slots)
+            {
+                if (auto resources = weak.lock())
+                    resources->threadExited.store(true, std::memory_order_release);
+            }
+        }
+    };
+    static thread_local ThreadSlots tls_slots;
+    auto &tls_resources = tls_slots.slots;
 
     auto it = tls_resources.find(this);
     if (it != tls_resources.end())
@@ -554,7 +2616,9 @@ TransferManager::ThreadResources &TransferManager::getThreadResources()
     newResources->graphicsCommandPool = m_ctx->getDevice().createCommandPool(poolInfo);
 
     {
+        // 新线程注册时先回收已退出的线程，短生命周期的工作线程不会无限累积资源
         std::lock_guard<std::mutex> lock(m_resourcesMutex);
+        reclaimExitedThreads();
         m_threadResources.push_back(newResources);
     }
 
@@ -616,15 +2680,3 @@ TransferManager::BarrierInfo TransferManager::getBarrierInfo(vk::ImageLayout old
     fill(newLayout, info.dstAccessMask, info.dstStage);
     return info;
 }
-
-void TransferManager::copyHostToStaging(size_t stagingIndex, const void *data, size_t size)
-{
-    const ManagedBuffer &stagingBuffer = getThreadResources().stagingBufferPool[stagingIndex].buffer;
-    void *dst = nullptr;
-    if (vmaMapMemory(m_allocator->getAllocator(), stagingBuffer.getAllocation(), &dst))
-    {
-        throw std::runtime_error("failed to map memory");
-    }
-    std::memcpy(static_cast<char *>(dst), data, size);
-    vmaUnmapMemory(m_allocator->getAllocator(), stagingBuffer.getAllocation());
-}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "../public/VkContext.hpp"
+#include "../public/VkUtils.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <limits>
 #include <set>
@@ -16,6 +19,31 @@
 
 using namespace vkcore;
 
+namespace
+{
+constexpr uint32_t kPipelineCacheMagic = 0x43504B56; // "VKPC"
+constexpr uint32_t kPipelineCacheVersion = 1;
+
+/**
+ * @struct PipelineCacheFileHeader
+ * @brief 管线缓存文件头，位于驱动返回的缓存数据之前
+ * @details 驱动自身的缓存头只包含vendorID/deviceID/UUID，额外记录驱动版本以便在驱动升级后丢弃旧缓存
+ */
+struct PipelineCacheFileHeader
+{
+    uint32_t magic = kPipelineCacheMagic;      ///< 文件标识
+    uint32_t version = kPipelineCacheVersion;  ///< 文件格式版本
+    uint32_t vendorID = 0;                     ///< 物理设备厂商ID
+    uint32_t deviceID = 0;                     ///< 物理设备ID
+    uint32_t driverVersion = 0;                ///< 驱动版本
+    uint32_t reserved = 0;                     ///< 对齐填充
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE]{}; ///< 管线缓存UUID
+    uint64_t dataSize = 0;                     ///< 缓存数据字节数
+    uint64_t checksum = 0;                     ///< 缓存数据的FNV-1a校验和
+};
+static_assert(sizeof(PipelineCacheFileHeader) == 56, "PipelineCacheFileHeader layout changed");
+} // namespace
+
 VkContext &VkContext::getInstance()
 {
     static VkContext s;
@@ -52,6 +80,7 @@ void VkContext::initialize(const InstanceConfig &instanceConfig, const DeviceCon
     createSurface(windowHandle);
     pickPhysicalDevice();
     createLogicalDevice(deviceConfig);
+    createPipelineCache(deviceConfig.pipelineCachePath);
 
     m_initialized = true;
 }
@@ -335,6 +364,151 @@ void VkContext::createLogicalDevice(const DeviceConfig &config)
         m_transferQueue = m_device.getQueue(m_queueFamilyIndices.transferFamily.value(), 0);
 }
 
+void VkContext::createPipelineCache(const std::filesystem::path &cacheFile)
+{
+    const auto start = std::chrono::steady_clock::now();
+    m_pipelineCachePath = cacheFile;
+    m_pipelineCacheStats = {};
+
+    std::vector<uint8_t> initialData;
+    if (!cacheFile.empty())
+    {
+        initialData = readPipelineCacheFile(cacheFile);
+    }
+
+    vk::PipelineCacheCreateInfo createInfo{};
+    createInfo.initialDataSize = initialData.size();
+    createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+    try
+    {
+        m_pipelineCache = m_device.createPipelineCache(createInfo);
+    }
+    catch (const vk::SystemError &)
+    {
+        // 驱动拒绝初始数据时退回到空缓存
+        if (initialData.empty())
+            throw;
+        m_pipelineCacheStats.rejected = true;
+        initialData.clear();
+        m_pipelineCache = m_device.createPipelineCache(vk::PipelineCacheCreateInfo{});
+    }
+
+    m_pipelineCacheStats.loadedBytes = initialData.size();
+    m_pipelineCacheStats.savedBytes = initialData.size();
+    m_pipelineCacheChecksum = initialData.empty() ? 0 : VkUtils::fnv1a64(initialData.data(), initialData.size());
+    m_pipelineCacheStats.loadTimeMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::vector<uint8_t> VkContext::readPipelineCacheFile(const std::filesystem::path &cacheFile)
+{
+    std::ifstream file(cacheFile, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        return {};
+
+    const auto fileSize = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+
+    PipelineCacheFileHeader header{};
+    if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    {
+        m_pipelineCacheStats.rejected = true;
+        return {};
+    }
+
+    const vk::PhysicalDeviceProperties properties = m_physicalDevice.getProperties();
+    if (header.magic != kPipelineCacheMagic || header.version != kPipelineCacheVersion ||
+        header.vendorID != properties.vendorID || header.deviceID != properties.deviceID ||
+        header.driverVersion != properties.driverVersion ||
+        std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE) != 0 ||
+        header.dataSize != fileSize - sizeof(header))
+    {
+        m_pipelineCacheStats.rejected = true;
+        return {};
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(header.dataSize));
+    if (!file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(data.size())) ||
+        VkUtils::fnv1a64(data.data(), data.size()) != header.checksum)
+    {
+        m_pipelineCacheStats.rejected = true;
+        return {};
+    }
+
+    // 驱动自身的缓存头（VkPipelineCacheHeaderVersionOne）也需与当前设备一致
+    VkPipelineCacheHeaderVersionOne driverHeader{};
+    if (data.size() < sizeof(driverHeader))
+    {
+        m_pipelineCacheStats.rejected = true;
+        return {};
+    }
+    std::memcpy(&driverHeader, data.data(), sizeof(driverHeader));
+    if (driverHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+        driverHeader.vendorID != properties.vendorID || driverHeader.deviceID != properties.deviceID ||
+        std::memcmp(driverHeader.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE) != 0)
+    {
+        m_pipelineCacheStats.rejected = true;
+        return {};
+    }
+    return data;
+}
+
+bool VkContext::savePipelineCache()
+{
+    if (!m_pipelineCache || m_pipelineCachePath.empty())
+        return true;
+
+    std::vector<uint8_t> data = m_device.getPipelineCacheData(m_pipelineCache);
+    if (data.empty())
+        return true;
+    // 驱动可能原地替换条目而大小不变，只有内容校验和相同才跳过
+    const uint64_t checksum = VkUtils::fnv1a64(data.data(), data.size());
+    if (data.size() == m_pipelineCacheStats.savedBytes && checksum == m_pipelineCacheChecksum)
+        return true;
+
+    const vk::PhysicalDeviceProperties properties = m_physicalDevice.getProperties();
+    PipelineCacheFileHeader header{};
+    header.vendorID = properties.vendorID;
+    header.deviceID = properties.deviceID;
+    header.driverVersion = properties.driverVersion;
+    std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID.data(), VK_UUID_SIZE);
+    header.dataSize = data.size();
+    header.checksum = checksum;
+
+    // 先写临时文件再替换，避免中途退出留下损坏的缓存
+    std::error_code ec;
+    if (m_pipelineCachePath.has_parent_path())
+        std::filesystem::create_directories(m_pipelineCachePath.parent_path(), ec);
+    std::filesystem::path tempFile = m_pipelineCachePath;
+    tempFile += ".tmp";
+    {
+        std::ofstream file(tempFile, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cerr << "Failed to write pipeline cache: " << tempFile.string() << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file)
+        {
+            std::cerr << "Failed to write pipeline cache: " << tempFile.string() << std::endl;
+            return false;
+        }
+    }
+    std::filesystem::rename(tempFile, m_pipelineCachePath, ec);
+    if (ec)
+    {
+        std::cerr << "Failed to replace pipeline cache: " << ec.message() << std::endl;
+        std::filesystem::remove(tempFile, ec);
+        return false;
+    }
+
+    m_pipelineCacheStats.savedBytes = data.size();
+    m_pipelineCacheChecksum = checksum;
+    return true;
+}
+
 void VkContext::createSwapchain(const SwapchainConfig &config)
 {
     if (!m_surface)
@@ -531,25 +705,33 @@ void VkContext::cleanup()
     if (m_device)
         m_device.waitIdle();
 
-    // 2. 销毁所有设备相关对象
+    // 2. 写回并销毁管线缓存
+    if (m_pipelineCache)
+    {
+        savePipelineCache();
+        m_device.destroyPipelineCache(m_pipelineCache);
+        m_pipelineCache = nullptr;
+    }
+
+    // 3. 销毁所有设备相关对象
     cleanupSwapchain();
 
-    // 3. 销毁逻辑设备
+    // 4. 销毁逻辑设备
     if (m_device)
         m_device.destroy();
 
-    // 4. 销毁Surface
+    // 5. 销毁Surface
     if (m_surface)
         m_instance.destroySurfaceKHR(m_surface);
 
-    // 5. 销毁Debug Messenger
+    // 6. 销毁Debug Messenger
     if (m_debugMessenger && m_enableValidation && m_pfnDestroyDebugUtilsMessenger)
     {
         m_pfnDestroyDebugUtilsMessenger(static_cast<VkInstance>(m_instance),
                                         static_cast<VkDebugUtilsMessengerEXT>(m_debugMessenger), nullptr);
     }
 
-    // 6. 最后销毁实例
+    // 7. 最后销毁实例
     if (m_instance)
         m_instance.destroy();
 
@@ -652,6 +834,10 @@ QueueFamilyIndices VkContext::findQueueFamilies(vk::PhysicalDevice device) const
         ++i;
     }
 
+    // 无Surface（离屏工具、基准测试）时不会呈现，呈现队列沿用图形队列
+    if (!m_surface)
+        indices.presentFamily = indices.graphicsFamily;
+
     return indices;
 }
 
@@ -686,8 +872,12 @@ bool VkContext::isDeviceSuitable(vk::PhysicalDevice device) const
     if (!checkDeviceExtensionSupport(device))
         return false;
 
-    auto swapDetails = querySwapchainSupport(device);
-    bool swapAdequate = !swapDetails.formats.empty() && !swapDetails.presentModes.empty();
+    bool swapAdequate = true;
+    if (m_surface)
+    {
+        auto swapDetails = querySwapchainSupport(device);
+        swapAdequate = !swapDetails.formats.empty() && !swapDetails.presentModes.empty();
+    }
 
     vk::PhysicalDeviceFeatures supportedFeatures = device.getFeatures();
 
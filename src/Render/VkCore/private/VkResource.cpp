@@ -1,4 +1,5 @@
 #include "../public/VkResource.hpp"
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
@@ -9,8 +10,9 @@ using namespace vkcore;
 
 // ManagedBuffer
 ManagedBuffer::ManagedBuffer(VkResourceAllocator *owner, vk::Buffer buffer, VmaAllocation allocation,
-                             vk::DeviceSize size, const std::string debugName)
-    : m_owner(owner), m_buffer(buffer), m_allocation(allocation), m_size(size), m_debugName(debugName)
+                             vk::DeviceSize size, const std::string debugName, void *mappedData)
+    : m_owner(owner), m_buffer(buffer), m_allocation(allocation), m_size(size), m_mappedData(mappedData),
+      m_debugName(debugName)
 {
 }
 
@@ -20,12 +22,14 @@ ManagedBuffer::ManagedBuffer(ManagedBuffer &&other) noexcept
     m_buffer = other.m_buffer;
     m_allocation = other.m_allocation;
     m_size = other.m_size;
+    m_mappedData = other.m_mappedData;
     m_debugName = std::move(other.m_debugName);
 
     other.m_owner = nullptr;
     other.m_buffer = VK_NULL_HANDLE;
     other.m_allocation = nullptr;
     other.m_size = 0;
+    other.m_mappedData = nullptr;
     other.m_debugName.clear();
 }
 
@@ -39,12 +43,14 @@ ManagedBuffer &ManagedBuffer::operator=(ManagedBuffer &&other) noexcept
         m_buffer = other.m_buffer;
         m_allocation = other.m_allocation;
         m_size = other.m_size;
+        m_mappedData = other.m_mappedData;
         m_debugName = std::move(other.m_debugName);
 
         other.m_owner = nullptr;
         other.m_buffer = VK_NULL_HANDLE;
         other.m_allocation = nullptr;
         other.m_size = 0;
+        other.m_mappedData = nullptr;
         other.m_debugName.clear();
     }
     return *this;
@@ -63,6 +69,7 @@ void ManagedBuffer::release()
         m_owner = nullptr;
         m_buffer = nullptr;
         m_allocation = nullptr;
+        m_mappedData = nullptr;
     }
 }
 
@@ -220,6 +227,26 @@ void VkResourceAllocator::initialize(VkContext &ctx)
     {
         throw std::runtime_error("failed to create allocator");
     }
+
+    // 查找HOST_VISIBLE|DEVICE_LOCAL内存：UMA设备上所有内存都是，独立显卡上需开启ReBAR才足够大
+    constexpr VkMemoryPropertyFlags kDirectWriteFlags =
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    constexpr VkDeviceSize kSmallBarSize = 256ull * 1024 * 1024;
+    const VkPhysicalDeviceMemoryProperties *memoryProperties = nullptr;
+    vmaGetMemoryProperties(m_allocator, &memoryProperties);
+    VkDeviceSize largestHeap = 0;
+    for (uint32_t i = 0; i < memoryProperties->memoryTypeCount; ++i)
+    {
+        const VkMemoryType &type = memoryProperties->memoryTypes[i];
+        if ((type.propertyFlags & kDirectWriteFlags) == kDirectWriteFlags)
+        {
+            largestHeap = (std::max)(largestHeap, memoryProperties->memoryHeaps[type.heapIndex].size);
+        }
+    }
+    const vk::PhysicalDeviceType deviceType = ctx.getPhysicalDevice().getProperties().deviceType;
+    const bool unifiedMemory =
+        deviceType == vk::PhysicalDeviceType::eIntegratedGpu || deviceType == vk::PhysicalDeviceType::eCpu;
+    m_directWriteSupported = largestHeap > 0 && (unifiedMemory || largestHeap > kSmallBarSize);
 }
 
 void VkResourceAllocator::cleanup()
@@ -326,15 +353,34 @@ ManagedBuffer VkResourceAllocator::createBuffer(const BufferDesc &desc)
     VmaAllocationCreateInfo allocInfo = {};
     allocInfo.usage = toVmaUsage(desc.memory);
 
+    // 直接写入：优先选择可映射的设备内存并持久映射，实际分配到的类型不可映射时映射标志被忽略
+    const bool directWrite = desc.allowDirectWrite && desc.memory == MemoryUsage::GpuOnly && m_directWriteSupported;
+    if (directWrite)
+    {
+        allocInfo.preferredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+    }
+
     VkBufferCreateInfo vkBufferInfo = static_cast<VkBufferCreateInfo>(bufferInfo);
     VkBuffer vkBuffer;
     VmaAllocation allocation;
+    VmaAllocationInfo allocationInfo = {};
 
-    if (vmaCreateBuffer(m_allocator, &vkBufferInfo, &allocInfo, &vkBuffer, &allocation, nullptr) != VK_SUCCESS)
+    if (vmaCreateBuffer(m_allocator, &vkBufferInfo, &allocInfo, &vkBuffer, &allocation, &allocationInfo) !=
+        VK_SUCCESS)
     {
         throw std::runtime_error("failed to create buffer");
     }
 
+    void *mappedData = nullptr;
+    if (directWrite)
+    {
+        VkMemoryPropertyFlags memoryFlags = 0;
+        vmaGetMemoryTypeProperties(m_allocator, allocationInfo.memoryType, &memoryFlags);
+        if (memoryFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+            mappedData = allocationInfo.pMappedData;
+    }
+
     vk::Buffer buffer = vkBuffer;
 
     // 设置Debug名称
@@ -343,7 +389,7 @@ ManagedBuffer VkResourceAllocator::createBuffer(const BufferDesc &desc)
         setDebugName(vk::ObjectType::eBuffer, (uint64_t) static_cast<VkBuffer>(buffer), desc.debugName);
     }
 
-    return ManagedBuffer{this, buffer, allocation, desc.size, desc.debugName};
+    return ManagedBuffer{this, buffer, allocation, desc.size, desc.debugName, mappedData};
 }
 
 void VkResourceAllocator::destroyBuffer(vk::Buffer buffer, VmaAllocation allocation)
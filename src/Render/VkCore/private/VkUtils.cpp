@@ -1,8 +1,19 @@
 #include "../public/VkUtils.hpp"
 #include "../public/VkContext.hpp"
+#include <filesystem>
 #include <fstream>
+#include <memory>
 #include <stdexcept>
 
+#ifdef ENABLE_SHADERC
+#include <iterator>
+#include <shaderc/shaderc.hpp>
+// 由构建系统定义为Vulkan SDK/shaderc版本
+#ifndef SHADERC_SDK_VERSION
+#define SHADERC_SDK_VERSION "unknown"
+#endif
+#endif
+
 namespace vkcore
 {
 namespace VkUtils
@@ -440,13 +451,164 @@ std::vector<uint32_t> loadSPIRV(const std::string &filename)
     return buffer;
 }
 
+#ifdef ENABLE_SHADERC
+namespace
+{
+shaderc_shader_kind toShadercKind(vk::ShaderStageFlagBits shaderType)
+{
+    switch (shaderType)
+    {
+    case vk::ShaderStageFlagBits::eVertex:
+        return shaderc_vertex_shader;
+    case vk::ShaderStageFlagBits::eFragment:
+        return shaderc_fragment_shader;
+    case vk::ShaderStageFlagBits::eCompute:
+        return shaderc_compute_shader;
+    case vk::ShaderStageFlagBits::eGeometry:
+        return shaderc_geometry_shader;
+    case vk::ShaderStageFlagBits::eTessellationControl:
+        return shaderc_tess_control_shader;
+    case vk::ShaderStageFlagBits::eTessellationEvaluation:
+        return shaderc_tess_evaluation_shader;
+    default:
+        throw std::runtime_error("Unsupported shader stage for GLSL compilation");
+    }
+}
+
+/**
+ * @class FileIncluder
+ * @brief 从磁盘解析 #include "..."（相对于包含者）与 #include <...>（相对于根源文件）
+ */
+class FileIncluder : public shaderc::CompileOptions::IncluderInterface
+{
+  public:
+    explicit FileIncluder(std::filesystem::path rootDirectory) : m_rootDirectory(std::move(rootDirectory))
+    {
+    }
+
+    shaderc_include_result *GetInclude(const char *requestedSource, shaderc_include_type type,
+                                       const char *requestingSource, size_t) override
+    {
+        auto *include = new IncludeData();
+        const std::filesystem::path base = type == shaderc_include_type_relative
+                                               ? std::filesystem::path(requestingSource).parent_path()
+                                               : m_rootDirectory;
+        const std::filesystem::path fullPath = base / requestedSource;
+
+        std::ifstream file(fullPath, std::ios::binary);
+        if (file.is_open())
+        {
+            include->name = fullPath.generic_string();
+            include->content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        else
+        {
+            // source_name 为空表示包含失败，content 为错误信息
+            include->content = "Cannot open include file: " + fullPath.generic_string();
+        }
+
+        include->result.source_name = include->name.c_str();
+        include->result.source_name_length = include->name.size();
+        include->result.content = include->content.c_str();
+        include->result.content_length = include->content.size();
+        include->result.user_data = include;
+        return &include->result;
+    }
+
+    void ReleaseInclude(shaderc_include_result *result) override
+    {
+        delete static_cast<IncludeData *>(result->user_data);
+    }
+
+  private:
+    struct IncludeData
+    {
+        shaderc_include_result result{};
+        std::string name;
+        std::string content;
+    };
+
+    std::filesystem::path m_rootDirectory;
+};
+
+shaderc::CompileOptions makeCompileOptions(const std::string &filename, const ShaderDefines &defines)
+{
+    shaderc::CompileOptions options;
+    options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_3);
+    options.SetOptimizationLevel(shaderc_optimization_level_performance);
+    options.SetIncluder(std::make_unique<FileIncluder>(std::filesystem::path(filename).parent_path()));
+    for (const auto &[name, value] : defines)
+    {
+        if (value.empty())
+            options.AddMacroDefinition(name);
+        else
+            options.AddMacroDefinition(name, value);
+    }
+    return options;
+}
+
+/**
+ * @brief 每个线程一个编译器实例，并发编译时无需加锁
+ */
+shaderc::Compiler &threadCompiler()
+{
+    thread_local shaderc::Compiler compiler;
+    return compiler;
+}
+} // namespace
+#endif
+
 std::vector<uint32_t> compileGLSLToSPIRV(const std::string &source, vk::ShaderStageFlagBits shaderType,
-                                         const std::string &filename)
+                                         const std::string &filename, const ShaderDefines &defines)
+{
+#ifdef ENABLE_SHADERC
+    shaderc::SpvCompilationResult result = threadCompiler().CompileGlslToSpv(
+        source, toShadercKind(shaderType), filename.c_str(), makeCompileOptions(filename, defines));
+    if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+    {
+        throw std::runtime_error("Failed to compile shader " + filename + ":\n" + result.GetErrorMessage());
+    }
+    return {result.cbegin(), result.cend()};
+#else
+    (void)source;
+    (void)shaderType;
+    (void)defines;
+    throw std::runtime_error("Cannot compile " + filename +
+                             ": runtime GLSL compilation is disabled (build with ENABLE_SHADERC and shaderc)");
+#endif
+}
+
+std::string preprocessGLSL(const std::string &source, vk::ShaderStageFlagBits shaderType, const std::string &filename,
+                           const ShaderDefines &defines)
+{
+#ifdef ENABLE_SHADERC
+    shaderc::PreprocessedSourceCompilationResult result = threadCompiler().PreprocessGlsl(
+        source, toShadercKind(shaderType), filename.c_str(), makeCompileOptions(filename, defines));
+    if (result.GetCompilationStatus() != shaderc_compilation_status_success)
+    {
+        throw std::runtime_error("Failed to preprocess shader " + filename + ":\n" + result.GetErrorMessage());
+    }
+    return {result.cbegin(), result.cend()};
+#else
+    (void)source;
+    (void)shaderType;
+    (void)defines;
+    throw std::runtime_error("Cannot preprocess " + filename +
+                             ": runtime GLSL compilation is disabled (build with ENABLE_SHADERC and shaderc)");
+#endif
+}
+
+std::string getGLSLCompilerVersion()
 {
-    // 这里需要集成shaderc库来编译GLSL
-    // 暂时抛出异常提示用户需要实现
-    throw std::runtime_error("compileGLSLToSPIRV not implemented yet. Please use pre-compiled SPIR-V or integrate "
-                             "shaderc library.");
+#ifdef ENABLE_SHADERC
+    unsigned int spirvVersion = 0;
+    unsigned int spirvRevision = 0;
+    shaderc_get_spv_version(&spirvVersion, &spirvRevision);
+    return std::string("shaderc ") + SHADERC_SDK_VERSION + " spv " + std::to_string(spirvVersion) + "." +
+           std::to_string(spirvRevision);
+#else
+    return {};
+#endif
 }
 
 // ==================== 验证与错误检查 ====================
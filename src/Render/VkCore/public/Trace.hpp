@@ -0,0 +1,159 @@
+/**
+ * @file Trace.hpp
+ * @brief 加载阶段的作用域追踪，根据ENABLE_LOAD_TRACE编译选项启用
+ * @details
+ * - 记录每个作用域的线程、起止时间、字节数与附加信息
+ * - 可导出为 Chrome Trace JSON（chrome://tracing 或 Perfetto 打开）
+ * - 禁用时所有宏展开为空语句，参数不会被求值，不产生任何代码
+ *
+ * 用法：
+ * @code
+ * TRACE_SCOPE("TextureLoader::decode");
+ * TRACE_SCOPE_NAMED(readZone, "VFS::readFile");
+ * TRACE_SET_BYTES(readZone, blob.size());
+ * TRACE_EXPORT("load_trace.json");
+ * @endcode
+ */
+
+#pragma once
+
+#ifdef ENABLE_LOAD_TRACE
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vkcore
+{
+
+/**
+ * @struct TraceEvent
+ * @brief 一个已结束的追踪作用域
+ */
+struct TraceEvent
+{
+    const char *name = nullptr;     ///< 作用域名称（字符串字面量）
+    const char *category = nullptr; ///< 分类（字符串字面量）
+    std::string detail;             ///< 附加信息（如资源路径）
+    uint64_t startNs = 0;           ///< 开始时间（相对记录器创建时刻）
+    uint64_t durationNs = 0;        ///< 持续时间
+    uint64_t bytes = 0;             ///< 处理的字节数，0 表示未记录
+    uint32_t threadId = 0;          ///< 记录器分配的线程序号
+};
+
+/**
+ * @class TraceRecorder
+ * @brief 进程内唯一的追踪事件收集器（线程安全）
+ */
+class TraceRecorder
+{
+  public:
+    static TraceRecorder &instance();
+
+    /**
+     * @brief 记录一个已结束的作用域
+     */
+    void record(TraceEvent event);
+
+    /**
+     * @brief 为当前线程命名（显示在追踪视图的线程列表中）
+     */
+    void setThreadName(std::string name);
+
+    /**
+     * @brief 导出为 Chrome Trace JSON
+     * @return true 如果写入成功
+     */
+    bool writeChromeTrace(const std::filesystem::path &file) const;
+
+    /**
+     * @brief 清空已记录的事件
+     */
+    void clear();
+
+    /**
+     * @brief 当前时间（相对记录器创建时刻，纳秒）
+     */
+    uint64_t now() const;
+
+    /**
+     * @brief 当前线程的序号
+     */
+    static uint32_t currentThreadId();
+
+  private:
+    TraceRecorder();
+
+    std::chrono::steady_clock::time_point m_origin;              ///< 时间原点
+    mutable std::mutex m_mutex;                                  ///< 保护事件与线程名
+    std::vector<TraceEvent> m_events;                            ///< 已记录的事件
+    std::vector<std::pair<uint32_t, std::string>> m_threadNames; ///< 线程序号 -> 名称
+};
+
+/**
+ * @class TraceScope
+ * @brief RAII 追踪作用域，析构时提交事件
+ */
+class TraceScope
+{
+  public:
+    TraceScope(const char *name, const char *category)
+    {
+        m_event.name = name;
+        m_event.category = category;
+        m_event.startNs = TraceRecorder::instance().now();
+    }
+
+    ~TraceScope()
+    {
+        auto &recorder = TraceRecorder::instance();
+        m_event.durationNs = recorder.now() - m_event.startNs;
+        m_event.threadId = TraceRecorder::currentThreadId();
+        recorder.record(std::move(m_event));
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+    void setBytes(uint64_t bytes)
+    {
+        m_event.bytes = bytes;
+    }
+
+    void setDetail(std::string detail)
+    {
+        m_event.detail = std::move(detail);
+    }
+
+  private:
+    TraceEvent m_event;
+};
+
+} // namespace vkcore
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+#define TRACE_SCOPE(name) ::vkcore::TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name, "load")
+#define TRACE_SCOPE_CAT(name, category) ::vkcore::TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name, category)
+#define TRACE_SCOPE_NAMED(var, name) ::vkcore::TraceScope var(name, "load")
+#define TRACE_SET_BYTES(var, bytes) (var).setBytes(static_cast<uint64_t>(bytes))
+#define TRACE_SET_DETAIL(var, detail) (var).setDetail(detail)
+#define TRACE_THREAD_NAME(name) ::vkcore::TraceRecorder::instance().setThreadName(name)
+#define TRACE_EXPORT(file) ::vkcore::TraceRecorder::instance().writeChromeTrace(file)
+
+#else
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_SCOPE_CAT(name, category) ((void)0)
+#define TRACE_SCOPE_NAMED(var, name) ((void)0)
+#define TRACE_SET_BYTES(var, bytes) ((void)0)
+#define TRACE_SET_DETAIL(var, detail) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_EXPORT(file) ((void)0)
+
+#endif
@@ -1,15 +1,22 @@
 /**
  * @file TransferManager.hpp
  * @author Summer
- * @brief Vulkan传输管理器，负责数据上传、命令缓冲管理和staging buffer池化
+ * @brief Vulkan传输管理器，负责数据上传、命令缓冲管理和staging环形分配
  *
  * 该文件提供了高效的数据传输管理，包括：
  * - 单次提交命令缓冲（one-time submit）
- * - Staging buffer池化管理
+ * - 持久映射的staging环形分配器（按时间线值回收）
+ * - 每个队列一个时间线信号量，令牌携带64位值，可在GPU端等待
+ * - 图像在专用传输队列上上传，通过队列族所有权转移交给图形队列
+ * - 异步GPU到CPU回读（池化的持久映射GpuToCpu buffer）
+ * - ReBAR/UMA设备上可映射的设备内存直接写入，跳过staging复制与提交
  * - 支持Transfer Queue和Graphics Queue
  * - Mipmap生成支持
  * - Buffer到Buffer传输
  * - Buffer到Image传输
+ * - 批量上传（多次复制合并为一次提交）
+ * - 流式上传调度（每帧字节与提交次数预算，超出部分按优先级顺延到后续帧）
+ * - 传输服务模式：生产者线程通过无锁MPSC队列提交上传，由单个传输线程合并录制与提交
  *
  * @version 1.0
  * @date 2025-11-22
@@ -17,12 +24,21 @@
 
 #pragma once
 
+#include "Trace.hpp"
 #include "VkContext.hpp"
 #include "VkResource.hpp"
+#include <array>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <vulkan/vulkan.hpp>
 
@@ -34,45 +50,88 @@ namespace vkcore
  */
 enum class TransferQueueType
 {
-    Transfer, ///< 专用传输队列（如果可用）
+    Transfer, ///< 专用传输队列（如果可用），图像上传也在此队列上完成
     Graphics  ///< 图形队列（用于mipmap生成等需要图形功能的操作）
 };
 
 /**
  * @brief 传输令牌，用于异步等待
+ *
+ * 令牌对应所属队列时间线信号量上的一个值，信号量达到该值即表示传输完成。
+ * 渲染队列可以在提交时通过 vk::TimelineSemaphoreSubmitInfo 等待 getSemaphore()/getValue()，
+ * 无需在CPU端等待。
  */
 struct TransferToken
 {
     struct State
     {
-        vk::Fence fence;
         vk::Device device;
+        vk::Semaphore semaphore;        ///< 所属队列的时间线信号量
+        std::atomic<uint64_t> value{0}; ///< 传输完成时信号量达到的值，0表示传输服务尚未提交
         std::atomic<bool> completed{false};
+        std::atomic<bool> failed{false}; ///< 传输未能提交到GPU（此时completed同为true）
+        std::string error;               ///< 失败原因，在failed置位前写入
+
+        /**
+         * @brief 标记传输失败（提交失败或被丢弃）并唤醒等待提交的线程
+         */
+        void fail(std::string message)
+        {
+            error = std::move(message);
+            failed.store(true, std::memory_order_release);
+            completed.store(true, std::memory_order_release);
+            value.store(1, std::memory_order_release);
+            value.notify_all();
+        }
     };
     std::shared_ptr<State> state;
 
     /**
      * @brief 等待传输完成
-     * @param timeout 超时时间（纳秒）
+     * @param timeout 超时时间（纳秒），不包括等待传输服务提交的时间
+     * @throws std::runtime_error 传输失败（未提交到GPU）或等待信号量失败
      */
     void wait(uint64_t timeout = UINT64_MAX) const
     {
-        if (!state || state->completed.load(std::memory_order_acquire))
+        if (!state)
+            return;
+        if (state->completed.load(std::memory_order_acquire))
+        {
+            throwIfFailed();
             return;
+        }
+
+        uint64_t value = state->value.load(std::memory_order_acquire);
+        if (value == 0)
+        {
+            TRACE_SCOPE("TransferToken::waitSubmit");
+            state->value.wait(0, std::memory_order_acquire);
+            value = state->value.load(std::memory_order_acquire);
+            if (state->completed.load(std::memory_order_acquire))
+            {
+                throwIfFailed();
+                return;
+            }
+        }
 
-        if (state->fence && state->device)
+        if (state->semaphore && state->device)
         {
-            if (state->device.waitForFences(1, &state->fence, VK_TRUE, timeout) != vk::Result::eSuccess)
+            TRACE_SCOPE("TransferToken::wait");
+            vk::SemaphoreWaitInfo waitInfo{};
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores = &state->semaphore;
+            waitInfo.pValues = &value;
+            if (state->device.waitSemaphores(waitInfo, timeout) != vk::Result::eSuccess)
             {
-                throw std::runtime_error("Wait for fence failed");
+                throw std::runtime_error("Wait for timeline semaphore failed");
             }
             state->completed.store(true, std::memory_order_release);
         }
     }
 
     /**
-     * @brief 检查传输是否完成
-     * @return true 如果完成或无效，false 如果仍在进行
+     * @brief 检查传输是否结束（读取一次时间线计数）
+     * @return true 如果完成、失败或无效，false 如果仍在进行；失败需通过isFailed区分
      */
     bool isComplete() const
     {
@@ -81,9 +140,12 @@ struct TransferToken
         if (state->completed.load(std::memory_order_acquire))
             return true;
 
-        if (state->fence && state->device)
+        const uint64_t value = state->value.load(std::memory_order_acquire);
+        if (value == 0)
+            return false;
+        if (state->semaphore && state->device)
         {
-            if (state->device.getFenceStatus(state->fence) == vk::Result::eSuccess)
+            if (state->device.getSemaphoreCounterValue(state->semaphore) >= value)
             {
                 state->completed.store(true, std::memory_order_release);
                 return true;
@@ -91,16 +153,150 @@ struct TransferToken
         }
         return false;
     }
+
+    /**
+     * @brief 所属队列的时间线信号量，无效令牌返回空句柄
+     */
+    vk::Semaphore getSemaphore() const
+    {
+        return state ? state->semaphore : vk::Semaphore{};
+    }
+
+    /**
+     * @brief 传输是否失败（数据未到达GPU）
+     */
+    bool isFailed() const
+    {
+        return state && state->failed.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 失败原因，未失败时为空
+     */
+    std::string getError() const
+    {
+        return isFailed() ? state->error : std::string{};
+    }
+
+    /**
+     * @brief 传输完成时时间线信号量达到的值，传输服务尚未提交或传输失败时为0
+     */
+    uint64_t getValue() const
+    {
+        return state && !state->failed.load(std::memory_order_acquire) ? state->value.load(std::memory_order_acquire)
+                                                                       : 0;
+    }
+
+    /**
+     * @brief 创建已失败的令牌
+     */
+    static TransferToken makeFailed(std::string message)
+    {
+        TransferToken token{std::make_shared<State>()};
+        token.state->fail(std::move(message));
+        return token;
+    }
+
+  private:
+    void throwIfFailed() const
+    {
+        if (state->failed.load(std::memory_order_acquire))
+            throw std::runtime_error("Transfer failed: " + state->error);
+    }
 };
 
 /**
- * @brief Staging Buffer信息
+ * @brief staging分配：环形缓冲中的一段，或超出环容量时的专用buffer
  */
-struct StagingBufferInfo
+struct StagingAllocation
 {
-    ManagedBuffer buffer;
-    vk::DeviceSize size = 0;
-    bool inUse = false;
+    vk::Buffer buffer;                  ///< 所在的staging buffer
+    VmaAllocation allocation = nullptr; ///< 所在buffer的内存（用于flush）
+    vk::DeviceSize offset = 0;          ///< 在buffer中的偏移
+    vk::DeviceSize size = 0;            ///< 分配大小
+    uint8_t *mapped = nullptr;          ///< 写入地址（已包含偏移）
+    uint64_t sequence = 0;              ///< 分配序号，提交时据此关联到所属提交
+};
+
+/**
+ * @brief staging分配统计
+ */
+struct StagingStats
+{
+    uint64_t allocations = 0;          ///< 分配次数
+    uint64_t allocatedBytes = 0;       ///< 累计分配字节数
+    uint64_t stalls = 0;               ///< 环已满而等待GPU完成的次数
+    double stallTimeMs = 0.0;          ///< 累计等待时间（毫秒）
+    uint64_t dedicatedAllocations = 0; ///< 无法放入环而创建专用buffer的次数
+    size_t ringCount = 0;              ///< 环形缓冲数量（每个上传线程一个）
+    uint64_t ringGrowths = 0;          ///< 环因放不下分配而扩容的次数
+    uint64_t ringBytes = 0;            ///< 当前全部环的容量之和
+    uint64_t directWrites = 0;         ///< 直接写入设备内存（跳过staging）的次数
+    uint64_t directWriteBytes = 0;     ///< 累计直接写入字节数
+};
+
+/**
+ * @brief 命令缓冲复用统计
+ */
+struct CommandBufferStats
+{
+    uint64_t allocations = 0; ///< 实际分配的命令缓冲数量
+    uint64_t reuses = 0;      ///< 复用已完成命令缓冲（省去的分配）次数
+    uint64_t frees = 0;       ///< 空闲列表已满而释放的命令缓冲数量
+};
+
+/**
+ * @brief 批量生成mipmap时的单个图像描述
+ *
+ * blit路径要求图像带有TransferSrc与TransferDst用途，计算路径要求Sampled与Storage用途。
+ */
+struct MipmapRequest
+{
+    vk::Image image;                                                         ///< 目标图像
+    vk::Format format = vk::Format::eUndefined;                              ///< 图像格式
+    vk::Extent2D extent{};                                                   ///< level 0 的尺寸
+    uint32_t mipLevels = 1;                                                  ///< mip level数量
+    uint32_t layerCount = 1;                                                 ///< 数组层数量（各层独立降采样）
+    vk::ImageLayout currentLayout = vk::ImageLayout::eShaderReadOnlyOptimal; ///< level 0 的当前布局
+    bool storageCapable = false;                                             ///< 带有Storage用途，可用计算着色器降采样
+};
+
+/**
+ * @brief 多区域图像上传中的一个区域，数据紧密排列（多层时按层依次存放）
+ */
+struct ImageUploadRegion
+{
+    vk::DeviceSize dataOffset = 0; ///< 区域数据相对源数据起点的偏移，需为4与texel大小的倍数
+    uint32_t mipLevel = 0;         ///< 目标mip level
+    uint32_t baseArrayLayer = 0;   ///< 目标起始数组层
+    uint32_t layerCount = 1;       ///< 数组层数量
+    vk::Offset3D imageOffset{};    ///< 目标区域偏移
+    vk::Extent3D imageExtent{};    ///< 目标区域尺寸
+};
+
+/**
+ * @brief 流式上传的每帧预算
+ */
+struct StreamingBudget
+{
+    vk::DeviceSize bytesPerFrame = 16 * 1024 * 1024; ///< 每帧最多录制的上传字节数（超出的单个请求独占一帧）
+    uint32_t submitsPerFrame = 2;                    ///< 每帧最多提交次数
+    vk::DeviceSize bytesPerSubmit = 8 * 1024 * 1024; ///< 单次提交累积到该字节数后立即提交
+};
+
+/**
+ * @brief 流式上传统计
+ */
+struct StreamingStats
+{
+    uint64_t frames = 0;               ///< 已处理的帧数
+    vk::DeviceSize frameBytes = 0;     ///< 最近一帧上传的字节数
+    uint32_t frameSubmits = 0;         ///< 最近一帧的提交次数
+    uint32_t frameRequests = 0;        ///< 最近一帧处理的请求数
+    vk::DeviceSize peakFrameBytes = 0; ///< 单帧上传字节数峰值
+    uint64_t totalBytes = 0;           ///< 累计上传字节数
+    size_t backlogRequests = 0;        ///< 积压的请求数
+    vk::DeviceSize backlogBytes = 0;   ///< 积压的字节数
 };
 
 /**
@@ -108,10 +304,226 @@ struct StagingBufferInfo
  */
 struct TransferManagerConfig
 {
-    bool enableStagingBufferPool = true;                    ///< 是否启用staging buffer池化
-    size_t maxPooledStagingBuffers = 8;                     ///< 池中最大staging buffer数量
-    vk::DeviceSize minStagingBufferSize = 1024 * 1024;      ///< 最小staging buffer大小（1MB）
-    vk::DeviceSize maxStagingBufferSize = 64 * 1024 * 1024; ///< 最大staging buffer大小（64MB）
+    vk::DeviceSize stagingRingSize = 4 * 1024 * 1024;     ///< 每个线程staging环的初始大小（4MB），首次分配时创建
+    vk::DeviceSize maxStagingRingSize = 64 * 1024 * 1024; ///< 环按需倍增的上限（64MB），更大的上传使用一次性专用buffer
+    size_t maxPooledReadbackBuffers = 8;                  ///< 回读池中保留的空闲buffer数量
+    vk::DeviceSize minReadbackBufferSize = 256 * 1024;    ///< 回读buffer的最小大小（256KB）
+    bool enableDirectWrite = true;                        ///< 目标buffer已映射时直接写入，关闭可对比staging路径
+    StreamingBudget streaming;                            ///< 流式上传的每帧预算
+    bool enableTransferService = false;                   ///< 启用传输服务线程，上传不再占用调用线程的命令池与staging
+    bool preferComputeMipmaps = true;                     ///< storageCapable的图像优先使用计算着色器生成mipmap
+    bool enableCompletionThread = false;                  ///< 启用完成线程，令牌完成后立即执行回调
+};
+
+class TransferManager;
+
+/**
+ * @brief 回读池中的持久映射buffer
+ */
+struct ReadbackBuffer
+{
+    ManagedBuffer buffer;        ///< GpuToCpu buffer
+    uint8_t *mapped = nullptr;   ///< 持久映射地址
+    vk::DeviceSize capacity = 0; ///< buffer大小
+    bool inUse = false;          ///< 是否被ReadbackResult持有
+    TransferToken lastUse;       ///< 最近一次写入它的提交，完成前不能复用
+};
+
+/**
+ * @brief 异步回读结果
+ *
+ * 持有回读池中的一个buffer，析构时归还。令牌完成前可以继续录制与提交其他帧，
+ * 多个回读可以同时在途。
+ *
+ * @note 必须在TransferManager::cleanup之前析构
+ */
+class ReadbackResult
+{
+  public:
+    ReadbackResult() = default;
+    ~ReadbackResult();
+
+    ReadbackResult(const ReadbackResult &) = delete;
+    ReadbackResult &operator=(const ReadbackResult &) = delete;
+    ReadbackResult(ReadbackResult &&other) noexcept;
+    ReadbackResult &operator=(ReadbackResult &&other) noexcept;
+
+    /**
+     * @brief 回读所在提交的令牌
+     */
+    const TransferToken &getToken() const
+    {
+        return m_token;
+    }
+
+    /**
+     * @brief 回读是否已完成（不阻塞）
+     */
+    bool isReady() const
+    {
+        return m_token.isComplete();
+    }
+
+    /**
+     * @brief 等待回读完成并返回数据（图像按行紧密排列）
+     */
+    const void *data();
+
+    vk::DeviceSize size() const
+    {
+        return m_size;
+    }
+
+    explicit operator bool() const
+    {
+        return m_buffer != nullptr;
+    }
+
+  private:
+    friend class TransferManager;
+
+    void release();
+
+    TransferManager *m_owner = nullptr; ///< 所属传输管理器
+    ReadbackBuffer *m_buffer = nullptr; ///< 池中的buffer
+    vk::DeviceSize m_size = 0;          ///< 回读字节数
+    TransferToken m_token;              ///< 回读所在提交
+    bool m_invalidated = false;         ///< 是否已使CPU缓存失效
+};
+
+/**
+ * @brief 批量上传上下文
+ *
+ * 将多次Buffer/Image上传录制到同一个命令缓冲，一次提交并返回一个令牌：
+ * - 数据在录制时即复制到线程的staging环中，提交完成后由环回收
+ * - 所有图像先通过一次屏障转换到TransferDst，复制完成后再通过一次屏障转换到目标布局
+ * - 提交到传输队列；存在专用传输队列时图像通过队列族释放交给图形队列（见recordPendingAcquires）
+ *
+ * @note staging与命令池是线程局部资源，批次必须在创建它的线程中录制和提交。
+ *       需要从大量加载线程上传时使用传输服务模式（TransferManagerConfig::enableTransferService）
+ */
+class UploadBatch
+{
+  public:
+    UploadBatch() = default;
+    ~UploadBatch();
+
+    UploadBatch(const UploadBatch &) = delete;
+    UploadBatch &operator=(const UploadBatch &) = delete;
+    UploadBatch(UploadBatch &&other) noexcept;
+    UploadBatch &operator=(UploadBatch &&other) noexcept;
+
+    /**
+     * @brief 录制一次Buffer上传（目标为直接写入的设备内存时立即写入，不占用批次）
+     * @param dstBuffer 目标buffer
+     * @param data 数据指针（录制时即复制，调用返回后可释放）
+     * @param size 数据大小
+     * @param dstOffset 目标buffer偏移
+     */
+    void uploadToBuffer(const ManagedBuffer &dstBuffer, const void *data, vk::DeviceSize size,
+                        vk::DeviceSize dstOffset = 0);
+
+    /**
+     * @brief 录制一次数组数据上传
+     */
+    template <typename T>
+    void uploadToBuffer(const ManagedBuffer &dstBuffer, const std::vector<T> &data, vk::DeviceSize dstOffset = 0)
+    {
+        uploadToBuffer(dstBuffer, data.data(), data.size() * sizeof(T), dstOffset);
+    }
+
+    /**
+     * @brief 录制一次Image上传（从Undefined布局开始）
+     * @param dstImage 目标image
+     * @param data 数据指针（录制时即复制，调用返回后可释放）
+     * @param dataSize 数据大小
+     * @param width 图像宽度
+     * @param height 图像高度
+     * @param depth 图像深度
+     * @param mipLevel 目标mip level
+     * @param arrayLayer 目标数组层
+     * @param finalLayout 复制完成后的布局
+     */
+    void uploadToImage(const ManagedImage &dstImage, const void *data, vk::DeviceSize dataSize, uint32_t width,
+                       uint32_t height, uint32_t depth = 1, uint32_t mipLevel = 0, uint32_t arrayLayer = 0,
+                       vk::ImageLayout finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal);
+
+    /**
+     * @brief 提交所有录制的复制，之后批次为空，可继续复用
+     * @return TransferToken 覆盖整个批次的令牌，批次为空时返回已完成的令牌
+     */
+    TransferToken submit();
+
+    bool empty() const
+    {
+        return m_bufferCopies.empty() && m_imageCopies.empty();
+    }
+    size_t getCopyCount() const
+    {
+        return m_bufferCopies.size() + m_imageCopies.size();
+    }
+    vk::DeviceSize getStagingBytes() const
+    {
+        return m_stagingBytes;
+    }
+
+  private:
+    friend class TransferManager;
+    explicit UploadBatch(TransferManager &owner);
+
+    /**
+     * @brief 写入staging并登记Buffer复制（参数已校验）
+     */
+    void recordBufferCopy(vk::Buffer dstBuffer, const void *data, vk::DeviceSize size, vk::DeviceSize dstOffset);
+
+    /**
+     * @brief 写入staging并登记Image复制（参数已校验）
+     */
+    void recordImageCopy(vk::Image dstImage, const void *data, vk::DeviceSize dataSize, vk::DeviceSize alignment,
+                         vk::Extent3D extent, uint32_t mipLevel, uint32_t arrayLayer, vk::ImageLayout finalLayout);
+
+    struct BufferCopy
+    {
+        vk::Buffer srcBuffer;
+        vk::Buffer dstBuffer;
+        vk::BufferCopy region;
+    };
+
+    struct ImageCopy
+    {
+        vk::Buffer srcBuffer;
+        vk::Image dstImage;
+        vk::BufferImageCopy region;
+        vk::ImageLayout finalLayout;
+    };
+
+    /**
+     * @brief 复制数据到staging并返回所在buffer与偏移
+     */
+    vk::DeviceSize stage(const void *data, vk::DeviceSize size, vk::DeviceSize alignment, vk::Buffer &outBuffer);
+    void checkThread() const;
+    void releaseStaging();
+    void reset();
+
+    TransferManager *m_owner = nullptr;       ///< 所属传输管理器
+    std::thread::id m_thread;                 ///< 创建批次的线程
+    std::vector<uint64_t> m_stagingSequences; ///< 本批次的staging分配序号
+    std::vector<BufferCopy> m_bufferCopies;   ///< 待提交的Buffer复制
+    std::vector<ImageCopy> m_imageCopies;     ///< 待提交的Image复制
+    vk::DeviceSize m_stagingBytes = 0;        ///< 已写入staging的字节数
+};
+
+/**
+ * @brief 流式上传请求
+ *
+ * 请求在processStreamingUploads的调用线程上录制，与同一帧的其他请求共享批次与提交。
+ */
+struct StreamingUpload
+{
+    vk::DeviceSize bytes = 0;                               ///< 预计上传字节数，用于预算
+    uint32_t priority = 0;                                  ///< 优先级，值越大越先处理，相同优先级按排队顺序
+    std::function<void(UploadBatch &)> record;              ///< 录制上传；抛出异常时必须尚未录制任何复制
+    std::function<void(const TransferToken &)> onSubmitted; ///< 所在批次提交后调用，提交失败时传入失败的令牌
 };
 
 /**
@@ -119,7 +531,7 @@ struct TransferManagerConfig
  *
  * 负责管理数据传输操作，包括：
  * - 维护Transfer和Graphics命令池
- * - 管理staging buffer池
+ * - 管理每个线程的持久映射staging环
  * - 支持mipmap生成
  */
 class TransferManager
@@ -147,12 +559,23 @@ class TransferManager
     // ==================== Buffer传输 ====================
 
     /**
-     * @brief 上传数据到Buffer（自动使用staging buffer）
+     * @brief 是否运行传输服务线程
+     */
+    bool isTransferServiceEnabled() const
+    {
+        return m_serviceRunning.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 上传数据到Buffer（目标已映射时直接写入，否则使用staging buffer）
+     *
+     * 传输服务模式下数据被复制到请求中交给传输线程，返回的令牌在传输线程提交后生效。
      * @param dstBuffer 目标buffer
      * @param data 数据指针
      * @param size 数据大小
      * @param dstOffset 目标buffer偏移
-     * @return TransferToken 传输令牌
+     * @return TransferToken 传输令牌，直接写入时为已完成的空令牌
+     * @note 直接写入在之后的队列提交中自动对GPU可见，调用方需保证GPU当前不在读取该区域
      */
     TransferToken uploadToBuffer(const ManagedBuffer &dstBuffer, const void *data, vk::DeviceSize size,
                                  vk::DeviceSize dstOffset = 0);
@@ -198,6 +621,34 @@ class TransferManager
      */
     void writeToUniformBuffer(const ManagedBuffer &dstBuffer, const void *data, vk::DeviceSize size,
                               vk::DeviceSize dstOffset = 0);
+    // ==================== 批量上传 ====================
+
+    /**
+     * @brief 创建批量上传上下文，多次复制共享一个命令缓冲与一次提交
+     */
+    UploadBatch createUploadBatch();
+
+    // ==================== 流式上传 ====================
+
+    /**
+     * @brief 排队一个流式上传请求（线程安全），由processStreamingUploads在预算内录制与提交
+     */
+    void scheduleUpload(StreamingUpload upload);
+
+    /**
+     * @brief 处理一帧的流式上传，应在每帧的固定位置调用一次（同时回收已退出线程的命令池与staging环）
+     * @param ignoreBudget 忽略预算，处理全部积压请求（如加载界面或等待所有上传完成时）
+     * @return StreamingStats 包含本帧数据的统计
+     */
+    StreamingStats processStreamingUploads(bool ignoreBudget = false);
+
+    /**
+     * @brief 调整每帧预算（线程安全，下一帧生效）
+     */
+    void setStreamingBudget(const StreamingBudget &budget);
+
+    StreamingStats getStreamingStats() const;
+
     // ==================== Image传输 ====================
 
     /**
@@ -215,6 +666,26 @@ class TransferManager
     TransferToken uploadToImage(const ManagedImage &dstImage, const void *data, vk::DeviceSize dataSize, uint32_t width,
                                 uint32_t height, uint32_t depth = 1, uint32_t mipLevel = 0, uint32_t arrayLayer = 0);
 
+    /**
+     * @brief 一次上传多个区域（完整mip链、立方体贴图各面、纹理数组各层）
+     *
+     * 所有数据写入同一个staging分配，以一条copyBufferToImage命令复制；
+     * 转入与转出各一次管线屏障，只包含区域写入的子资源（mip与层），其余子资源的内容与布局不受影响。
+     * 子资源从Undefined转入，区域只覆盖其一部分时其余内容被丢弃。
+     * 始终在调用线程上提交，不经过传输服务。
+     *
+     * @param dstImage 目标image
+     * @param data 所有区域的数据
+     * @param dataSize 数据大小
+     * @param regions 区域列表，各区域的数据位于data + dataOffset
+     * @param finalLayout 复制完成后的布局
+     * @return TransferToken 传输令牌
+     * @throws std::out_of_range 区域数据超出dataSize
+     */
+    TransferToken uploadToImageRegions(const ManagedImage &dstImage, const void *data, vk::DeviceSize dataSize,
+                                       const std::vector<ImageUploadRegion> &regions,
+                                       vk::ImageLayout finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal);
+
     /**
      * @brief Buffer到Image复制
      * @param srcBuffer 源buffer
@@ -230,6 +701,14 @@ class TransferManager
                                     uint32_t height, uint32_t depth = 1, uint32_t mipLevel = 0,
                                     uint32_t arrayLayer = 0);
 
+    /**
+     * @brief Buffer到Image的多区域复制，各区域的数据位于srcBuffer的dataOffset处
+     * @see uploadToImageRegions
+     */
+    TransferToken copyBufferToImageRegions(const ManagedBuffer &srcBuffer, const ManagedImage &dstImage,
+                                           const std::vector<ImageUploadRegion> &regions,
+                                           vk::ImageLayout finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal);
+
     /**
      * @brief Image布局转换
      * @param image 目标image
@@ -250,34 +729,137 @@ class TransferManager
                                         bool useGraphicsQueue = false);
 
     /**
-     * @brief 生成Mipmap（使用blit，需要图形队列）
+     * @brief 生成Mipmap（需要图形队列）
      * @param image 目标image
      * @param width 图像宽度
      * @param height 图像高度
      * @param mipLevels mip level数量
+     * @param currentLayout level 0的当前布局（uploadToImage完成后为ShaderReadOnlyOptimal）
      * @return TransferToken 传输令牌
+     * @see generateMipmaps(const std::vector<MipmapRequest> &)
+     */
+    TransferToken generateMipmaps(const ManagedImage &image, uint32_t width, uint32_t height, uint32_t mipLevels,
+                                  vk::ImageLayout currentLayout = vk::ImageLayout::eShaderReadOnlyOptimal);
+
+    /**
+     * @brief 在一个命令缓冲中为多个图像生成mipmap（图形队列，一次提交）
+     *
+     * 各图像按mip level交错录制，同一level的屏障合并为一次pipelineBarrier。
+     * 格式支持线性过滤blit时使用blit链；不支持blit，或图像storageCapable且配置了preferComputeMipmaps时，
+     * 使用计算着色器逐级2x2降采样（着色器在首次使用时由shaderc编译，失败时回退到blit）。
+     * 完成后所有level处于ShaderReadOnlyOptimal。
+     *
+     * @param requests 图像列表，level 0内容有效，其余level的内容被覆盖
+     * @return TransferToken 传输令牌（所有图像共用）
+     * @throws std::runtime_error 某个格式既不支持blit也无法使用计算降采样，或图像的上传失败
+     * @note 由专用传输队列上传、尚未获取所有权的图像会先等待上传完成，并在同一命令缓冲中获取所有权；
+     *       currentLayout应为上传时的finalLayout
      */
-    TransferToken generateMipmaps(const ManagedImage &image, uint32_t width, uint32_t height, uint32_t mipLevels);
+    TransferToken generateMipmaps(const std::vector<MipmapRequest> &requests);
 
-    // ==================== Staging Buffer管理 ====================
+    // ==================== Staging 统计 ====================
 
     /**
-     * @brief 从池中获取或创建staging buffer
-     * @param size 所需大小
-     * @return staging buffer索引
+     * @brief 汇总所有线程的staging分配统计（分配次数、环满等待次数与时间）
+     */
+    StagingStats getStagingStats() const;
+
+    /**
+     * @brief 命令缓冲的分配与复用统计
+     */
+    CommandBufferStats getCommandBufferStats() const;
+
+    // ==================== 回读 ====================
+
+    /**
+     * @brief 异步回读Buffer内容（在图形队列上执行，排在此前提交的渲染/计算之后）
+     * @param srcBuffer 源buffer（需要TransferSrc用途）
+     * @param size 回读大小
+     * @param srcOffset 源偏移
+     * @return ReadbackResult 回读结果，令牌完成后可读取
+     */
+    ReadbackResult readbackBuffer(const ManagedBuffer &srcBuffer, vk::DeviceSize size, vk::DeviceSize srcOffset = 0);
+
+    /**
+     * @brief 异步回读Image内容（在图形队列上执行，复制后恢复原布局）
+     * @param image 源image（需要TransferSrc用途）
+     * @param format 图像格式（用于计算大小，不支持压缩格式）
+     * @param extent 所选mip level的尺寸
+     * @param currentLayout 图像当前布局，不能为Undefined
+     * @param aspectMask 图像方面
+     * @param mipLevel 源mip level
+     * @param arrayLayer 源数组层
+     * @return ReadbackResult 回读结果，令牌完成后可读取
+     */
+    ReadbackResult readbackImage(vk::Image image, vk::Format format, vk::Extent3D extent,
+                                 vk::ImageLayout currentLayout,
+                                 vk::ImageAspectFlags aspectMask = vk::ImageAspectFlagBits::eColor,
+                                 uint32_t mipLevel = 0, uint32_t arrayLayer = 0);
+
+    /**
+     * @brief 异步回读ManagedImage的第0层mip
+     */
+    ReadbackResult readbackImage(const ManagedImage &image, vk::ImageLayout currentLayout);
+
+    // ==================== 完成回调 ====================
+
+    /**
+     * @brief 令牌完成后执行回调，用于串联 解码 -> 上传 -> 就绪 而不阻塞工作线程
+     *
+     * 回调在processCompletions的调用线程上执行，启用完成线程时也可能在完成线程上执行；
+     * 令牌已结束（包括空令牌）时立即在当前线程执行。cleanup时尚未执行的回调被丢弃。
+     * @param token 传输令牌
+     * @param callback 结束回调，参数为该令牌，通过isFailed/getError区分失败
+     */
+    void then(const TransferToken &token, std::function<void(const TransferToken &)> callback);
+
+    /**
+     * @brief 令牌完成时就绪的future，可与资源加载的future组合等待
+     * @note 依赖processCompletions或完成线程驱动；传输失败时future抛出std::runtime_error，
+     *       cleanup时仍未就绪的future抛出broken_promise
+     */
+    std::shared_future<void> toFuture(const TransferToken &token);
+
+    /**
+     * @brief 执行令牌已完成的回调（非阻塞，应每帧调用一次）
+     *
+     * 每条时间线只读取一次计数。回调抛出的异常被记录后忽略。
+     * @return 本次执行的回调数量
      */
-    size_t acquireStagingBuffer(vk::DeviceSize size);
+    size_t processCompletions();
+
+    // ==================== 时间线 ====================
 
     /**
-     * @brief 释放staging buffer回池
-     * @param index staging buffer索引
+     * @brief 队列的时间线信号量（无专用传输队列时Transfer与Graphics共用一个）
      */
-    void releaseStagingBuffer(size_t index);
+    vk::Semaphore getTimelineSemaphore(TransferQueueType queueType) const;
 
     /**
-     * @brief 清理未使用的staging buffer
+     * @brief 队列上最近一次提交的时间线值，GPU等待该值即等待此前所有上传
      */
-    void cleanupUnusedStagingBuffers();
+    uint64_t getLastSubmittedValue(TransferQueueType queueType) const;
+
+    // ==================== 队列族所有权 ====================
+
+    /**
+     * @brief 是否存在与图形队列族不同的传输队列族
+     *
+     * 存在时图像在传输队列上复制并释放所有权，需要图形队列通过recordPendingAcquires获取。
+     */
+    bool hasDedicatedTransferQueue() const;
+
+    /**
+     * @brief 在图形命令缓冲开头录制已完成上传的图像的所有权获取屏障
+     *
+     * 每帧在使用新发布的资源之前调用一次。只处理令牌已完成的上传，
+     * 上传仍在进行中的图像留到之后的帧。
+     *
+     * @param graphicsCmd 图形队列的命令缓冲
+     * @return 被获取图像中最晚的上传令牌，提交graphicsCmd时应在GPU端等待其时间线值；无获取时为空令牌
+     * @note 获取屏障的阶段为图像首次使用的阶段（着色器采样时为FragmentShader），等待时间线时使用相同阶段
+     */
+    TransferToken recordPendingAcquires(vk::CommandBuffer graphicsCmd);
 
     // ==================== Getter ====================
 
@@ -295,30 +877,251 @@ class TransferManager
     }
 
   private:
+    friend class UploadBatch;
+    friend class ReadbackResult;
+
+    /**
+     * @brief 从回读池获取容量足够且GPU不再使用的buffer
+     */
+    ReadbackBuffer *acquireReadbackBuffer(vk::DeviceSize size);
+
+    /**
+     * @brief 归还回读buffer，超出池上限的空闲buffer被销毁
+     */
+    void releaseReadbackBuffer(ReadbackBuffer *buffer, const TransferToken &lastUse);
+
+    /**
+     * @brief 录制并提交批次中的全部复制
+     */
+    TransferToken submitUploadBatch(UploadBatch &batch);
+
+    /**
+     * @brief 持久映射的staging环形缓冲
+     *
+     * 分配按顺序追加到entries，所属提交完成后从头部回收，回收即推进tail。
+     * 写满时head不会追上tail，因此head == tail表示环为空。
+     * 环在线程首次分配时按初始大小创建，放不下时倍增到配置的上限。
+     */
+    struct StagingRing
+    {
+        struct Entry
+        {
+            vk::DeviceSize end = 0;                           ///< 回收后tail推进到的位置
+            ManagedBuffer dedicated;                          ///< 超出环容量时的专用buffer
+            std::shared_ptr<TransferToken::State> submission; ///< 所属提交，为空表示尚未提交
+        };
+
+        ManagedBuffer buffer;        ///< 环形缓冲
+        uint8_t *mapped = nullptr;   ///< 持久映射地址
+        vk::DeviceSize capacity = 0; ///< 环大小
+        vk::DeviceSize head = 0;     ///< 下一次分配的起点
+        vk::DeviceSize tail = 0;     ///< 最早未回收分配的起点
+        std::deque<Entry> entries;   ///< 按分配顺序排列的未回收分配
+        uint64_t firstSequence = 1;  ///< entries.front()的分配序号
+    };
+
+    /**
+     * @brief 队列的时间线信号量，提交在锁内按值递增的顺序进行
+     */
+    struct QueueTimeline
+    {
+        vk::Semaphore semaphore;
+        std::atomic<uint64_t> lastSubmitted{0}; ///< 最近一次提交的信号值
+        std::mutex submitMutex;                 ///< 保证信号值与提交顺序一致（同时同步队列访问）
+    };
+    static constexpr size_t kTimelineCount = 2;
+    static constexpr size_t kMaxFreeCommandBuffers = 32; ///< 每个命令池保留的空闲命令缓冲上限
+
     struct ThreadResources
     {
         vk::CommandPool transferCommandPool;
         vk::CommandPool graphicsCommandPool;
-        std::vector<StagingBufferInfo> stagingBufferPool;
+        StagingRing stagingRing;
+        std::atomic<bool> threadExited{false}; ///< 所属线程已退出，GPU完成后由reclaimExitedThreads回收
 
-        // 异步提交管理
+        // 已完成的命令缓冲按所属命令池回到空闲列表，下次begin时重置复用
+        std::vector<vk::CommandBuffer> freeTransferCommandBuffers;
+        std::vector<vk::CommandBuffer> freeGraphicsCommandBuffers;
+
+        // 异步提交管理：同一线程在同一时间线上的值单调递增，按顺序回收
         struct PendingSubmission
         {
-            std::shared_ptr<TransferToken::State> tokenState;
+            uint64_t value = 0;
             vk::CommandBuffer cmdBuffer;
             vk::CommandPool commandPool;
-            std::vector<size_t> stagingBuffersToRelease;
         };
-        std::vector<PendingSubmission> activeSubmissions;
-        std::vector<vk::Fence> fencePool;
+        std::array<std::deque<PendingSubmission>, kTimelineCount> pendingSubmissions;
+    };
+
+    /**
+     * @brief 队列类型对应的时间线索引，与endOneTimeCommands选择的队列一致
+     */
+    size_t timelineIndex(TransferQueueType queueType) const;
+
+    /**
+     * @brief 回收时间线已越过的提交的命令缓冲（放回空闲列表，超出上限时释放）
+     */
+    void retireSubmissions(ThreadResources &resources);
+
+    /**
+     * @brief 回收已退出线程的命令池与staging环（调用者需持有m_resourcesMutex）
+     */
+    void reclaimExitedThreads();
+
+    /**
+     * @brief 传输服务的上传描述，同时是无锁MPSC链表的节点
+     */
+    struct ServiceRequest
+    {
+        ServiceRequest *next = nullptr;              ///< 链表中较早入队的请求
+        std::unique_ptr<uint8_t[]> data;             ///< 数据副本
+        vk::DeviceSize size = 0;                     ///< 数据大小
+        vk::Buffer dstBuffer;                        ///< Buffer目标，为空时为Image上传
+        vk::DeviceSize dstOffset = 0;                ///< Buffer目标偏移
+        vk::Image dstImage;                          ///< Image目标
+        vk::DeviceSize alignment = 4;                ///< staging对齐
+        vk::Extent3D extent{};                       ///< Image复制范围
+        uint32_t mipLevel = 0;                       ///< Image目标mip level
+        uint32_t arrayLayer = 0;                     ///< Image目标数组层
+        std::shared_ptr<TransferToken::State> token; ///< 提交后写入时间线值
+    };
+
+    /**
+     * @brief 把请求压入MPSC队列并唤醒传输线程（任意线程，无锁）
+     */
+    TransferToken enqueueServiceRequest(std::unique_ptr<ServiceRequest> request);
+
+    /**
+     * @brief 传输线程主循环：取出全部请求，合并录制到批次并提交
+     */
+    void serviceLoop();
+
+    /**
+     * @brief 在传输线程上录制并提交一组请求，完成后写入各请求令牌
+     */
+    void submitServiceRequests(std::vector<std::unique_ptr<ServiceRequest>> &requests);
+
+    /**
+     * @brief 停止传输线程，已入队的请求全部提交后返回
+     */
+    void stopTransferService();
+
+    struct Continuation
+    {
+        TransferToken token;
+        std::function<void(const TransferToken &)> callback;
+    };
+
+    /**
+     * @brief 完成线程主循环：在各时间线上等待最早的未完成值，到达后执行回调
+     */
+    void completionLoop();
+
+    void stopCompletionThread();
+
+    /**
+     * @brief 等待图形队列获取所有权的图像
+     */
+    struct PendingAcquire
+    {
+        vk::ImageMemoryBarrier barrier;  ///< 获取屏障（布局与队列族和释放屏障一致）
+        vk::PipelineStageFlags dstStage; ///< 获取后首次使用的管线阶段
+        TransferToken token;             ///< 释放所在的提交
+    };
+
+    /**
+     * @brief 校验区域并录制逐子资源的转入、一次复制与转出后提交（传输队列）
+     * @param srcSize 源数据大小，区域数据超出时抛出异常
+     * @param baseOffset 区域dataOffset在srcBuffer中的基准偏移
+     */
+    TransferToken submitImageRegions(vk::Buffer srcBuffer, vk::DeviceSize srcSize, vk::DeviceSize baseOffset,
+                                     const ManagedImage &dstImage, const std::vector<ImageUploadRegion> &regions,
+                                     vk::ImageLayout finalLayout, const std::vector<uint64_t> &stagingSequences);
+
+    /**
+     * @brief 录制图像从TransferDst到barriers中newLayout的转换
+     *
+     * 在专用传输队列上录制为队列族释放屏障，并把对应的获取屏障追加到acquires。
+     */
+    void recordFinalImageBarriers(vk::CommandBuffer cmd, TransferQueueType queueType,
+                                  std::vector<vk::ImageMemoryBarrier> &barriers,
+                                  std::vector<PendingAcquire> &acquires) const;
+
+    /**
+     * @brief 提交后登记获取屏障，等待图形队列录制
+     */
+    void registerAcquires(std::vector<PendingAcquire> acquires, const TransferToken &token);
+
+    /**
+     * @brief 取出上传已完成的获取屏障（images为空时不限图像），上传失败的没有对应的释放，直接丢弃
+     */
+    std::vector<PendingAcquire> takeReadyAcquires(const std::vector<vk::Image> &images = {});
+
+    /**
+     * @brief 从当前线程的staging环分配（指针推进），环满时等待最早的提交完成
+     * @param size 所需大小
+     * @param alignment 偏移对齐
+     * @note 分配必须通过endOneTimeCommands提交，或通过abandonStaging放弃，否则会阻塞回收
+     */
+    StagingAllocation allocateStaging(vk::DeviceSize size, vk::DeviceSize alignment = 4);
+
+    /**
+     * @brief 写入staging并刷新（非一致内存）
+     */
+    void writeStaging(const StagingAllocation &allocation, const void *data, vk::DeviceSize size);
+
+    /**
+     * @brief 目标buffer持久映射在设备内存中时直接写入并刷新
+     * @return 是否已直接写入，false时需要走staging路径
+     */
+    bool tryDirectWrite(const ManagedBuffer &dstBuffer, const void *data, vk::DeviceSize size,
+                        vk::DeviceSize dstOffset);
+
+    /**
+     * @brief 放弃未提交的staging分配，使其可以被回收
+     */
+    void abandonStaging(const std::vector<uint64_t> &sequences);
+
+    /**
+     * @brief 回收GPU已完成的staging分配
+     */
+    void reclaimStaging(StagingRing &ring);
+
+    /**
+     * @brief 将环扩容到至少required字节（不超过上限），环尚未创建时按初始大小创建
+     *
+     * 旧环仍被未回收的分配引用时不立即释放，而是作为已完成的专用条目排在队尾，
+     * 按顺序回收保证它在全部旧分配完成后才释放。
+     */
+    void growStagingRing(StagingRing &ring, vk::DeviceSize required);
+
+    /**
+     * @brief 计算降采样一次调用使用的描述符池与视图，GPU完成后销毁
+     */
+    struct MipmapScratch
+    {
+        TransferToken token;
+        vk::DescriptorPool descriptorPool;
+        std::vector<vk::ImageView> views;
     };
 
-    void copyHostToStaging(size_t stagingIndex, const void *data, size_t size);
+    /**
+     * @brief 获取格式对应的降采样计算管线（调用者需持有m_mipmapMutex）
+     * @return 格式没有GLSL存储格式或着色器编译失败时返回空句柄
+     */
+    vk::Pipeline getMipmapPipeline(vk::Format format);
+
+    void destroyMipmapScratch(MipmapScratch &scratch);
+
+    /**
+     * @brief 销毁GPU已完成的降采样临时资源（调用者需持有m_mipmapMutex）
+     */
+    void reapMipmapScratch();
 
     // 内部辅助函数
     vk::CommandBuffer beginOneTimeCommands(TransferQueueType queueType);
     TransferToken endOneTimeCommands(vk::CommandBuffer cmdBuffer, TransferQueueType queueType,
-                                     std::vector<size_t> stagingBuffersToRelease = {});
+                                     const std::vector<uint64_t> &stagingSequences = {});
 
     ManagedBuffer createStagingBuffer(vk::DeviceSize size);
     ThreadResources &getThreadResources();
@@ -337,9 +1140,64 @@ class TransferManager
     VkResourceAllocator *m_allocator = nullptr;
     TransferManagerConfig m_config;
 
+    // 0: 传输队列，1: 图形队列
+    std::array<QueueTimeline, kTimelineCount> m_timelines;
+
+    // 已释放所有权、等待图形队列获取的图像
+    std::vector<PendingAcquire> m_pendingAcquires;
+    std::mutex m_acquireMutex;
+
+    // 流式上传队列，键为（优先级取反, 排队序号），begin()即下一个要处理的请求
+    std::map<std::pair<int64_t, uint64_t>, StreamingUpload> m_streamingQueue;
+    uint64_t m_streamingSequence = 0;
+    StreamingStats m_streamingStats; ///< 不含积压字段，查询时填充
+    mutable std::mutex m_streamingMutex;
+
+    // 回读池（可在任意线程获取与归还）
+    std::vector<std::unique_ptr<ReadbackBuffer>> m_readbackPool;
+    std::mutex m_readbackMutex;
+
+    // 计算降采样资源（首次使用时创建）
+    std::mutex m_mipmapMutex;
+    vk::DescriptorSetLayout m_mipmapSetLayout;
+    vk::PipelineLayout m_mipmapPipelineLayout;
+    vk::Sampler m_mipmapSampler;
+    std::unordered_map<vk::Format, vk::Pipeline> m_mipmapPipelines; ///< 空句柄表示该格式不可用
+    std::vector<MipmapScratch> m_mipmapScratch;
+
     // 线程局部资源管理
     std::vector<std::shared_ptr<ThreadResources>> m_threadResources;
-    std::mutex m_resourcesMutex;
+    mutable std::mutex m_resourcesMutex;
+
+    // 传输服务：生产者CAS压栈，传输线程一次取走整条链表后反转为FIFO
+    std::atomic<ServiceRequest *> m_serviceHead{nullptr};
+    std::atomic<uint32_t> m_serviceSignal{0}; ///< 每次入队递增，传输线程在其上atomic wait
+    std::atomic<bool> m_serviceStop{false};
+    std::atomic<bool> m_serviceRunning{false};
+    std::thread m_serviceThread;
+
+    // 完成回调
+    std::vector<Continuation> m_continuations;
+    std::mutex m_continuationMutex;
+    std::condition_variable m_continuationCv; ///< 登记回调或停止时通知完成线程
+    bool m_completionStop = false;            ///< 受m_continuationMutex保护
+    std::thread m_completionThread;
+
+    // staging统计
+    std::atomic<uint64_t> m_stagingAllocations{0};
+    std::atomic<uint64_t> m_stagingBytes{0};
+    std::atomic<uint64_t> m_stagingStalls{0};
+    std::atomic<uint64_t> m_stagingStallNs{0};
+    std::atomic<uint64_t> m_dedicatedStaging{0};
+    std::atomic<uint64_t> m_directWrites{0};
+    std::atomic<uint64_t> m_directWriteBytes{0};
+    std::atomic<uint64_t> m_stagingRingGrowths{0};
+    std::atomic<uint64_t> m_stagingRingBytes{0};
+
+    // 命令缓冲统计
+    std::atomic<uint64_t> m_commandBufferAllocations{0};
+    std::atomic<uint64_t> m_commandBufferReuses{0};
+    std::atomic<uint64_t> m_commandBufferFrees{0};
 };
 
 } // namespace vkcore
@@ -9,6 +9,7 @@
  * - Logical Device和队列创建
  * - Swapchain管理
  * - Surface创建和管理
+ * - 管线缓存（VkPipelineCache）的磁盘持久化
  *
  * @version 1.0
  * @date 2025-11-21
@@ -20,6 +21,8 @@
 #define VK_USE_PLATFORM_WIN32_KHR
 #endif
 
+#include <cstddef>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
@@ -110,6 +113,9 @@ struct DeviceConfig
 
     // 队列优先级
     float queuePriority = 1.0f;
+
+    // 管线缓存文件，为空时仅使用内存中的管线缓存
+    std::filesystem::path pipelineCachePath;
 };
 
 /**
@@ -127,6 +133,18 @@ struct SwapchainConfig
     uint32_t imageCount = 3; // 0表示使用minImageCount + 1
 };
 
+/**
+ * @struct PipelineCacheStats
+ * @brief 管线缓存的加载与保存统计
+ */
+struct PipelineCacheStats
+{
+    size_t loadedBytes = 0;  ///< 启动时从磁盘载入的缓存数据大小，0 表示冷启动
+    size_t savedBytes = 0;   ///< 最近一次写回磁盘的数据大小
+    bool rejected = false;   ///< 磁盘缓存存在但校验失败（设备、驱动或数据不匹配）
+    double loadTimeMs = 0.0; ///< 读取、校验与创建管线缓存的耗时
+};
+
 /**
  * @class VkContext
  * @brief Vulkan上下文管理类，单例模式
@@ -151,7 +169,7 @@ class VkContext
      * @brief 初始化Vulkan上下文（完整配置版本）
      * @param instanceConfig Instance配置
      * @param deviceConfig Device配置
-     * @param windowHandle 窗口句柄（用于创建Surface）
+     * @param windowHandle 窗口句柄（用于创建Surface），为空时以无窗口模式初始化，不检查呈现支持
      */
     void initialize(const InstanceConfig &instanceConfig, const DeviceConfig &deviceConfig,
                     void *windowHandle = nullptr);
@@ -174,6 +192,28 @@ class VkContext
      */
     void cleanup();
 
+    // ==================== 管线缓存 ====================
+
+    /**
+     * @brief 获取管线缓存，创建管线时传入以复用之前编译的结果
+     */
+    vk::PipelineCache getPipelineCache() const
+    {
+        return m_pipelineCache;
+    }
+
+    /**
+     * @brief 将管线缓存写回DeviceConfig::pipelineCachePath
+     * @details 可在启动完成后或周期性调用；数据大小未变化时跳过写入。cleanup时会自动调用
+     * @return true 如果写入成功或无需写入
+     */
+    bool savePipelineCache();
+
+    const PipelineCacheStats &getPipelineCacheStats() const
+    {
+        return m_pipelineCacheStats;
+    }
+
     // ==================== Getter方法 ====================
 
     vk::Instance getVkInstance() const
@@ -317,6 +357,17 @@ class VkContext
      */
     void createLogicalDevice(const DeviceConfig &config);
 
+    /**
+     * @brief 创建管线缓存，并尝试载入磁盘上的缓存数据
+     */
+    void createPipelineCache(const std::filesystem::path &cacheFile);
+
+    /**
+     * @brief 读取并校验磁盘缓存文件
+     * @return 可直接作为初始数据的缓存内容，校验失败时返回空
+     */
+    std::vector<uint8_t> readPipelineCacheFile(const std::filesystem::path &cacheFile);
+
     /**
      * @brief 创建Swapchain（内部实现）
      */
@@ -414,6 +465,12 @@ class VkContext
 
     QueueFamilyIndices m_queueFamilyIndices;
 
+    // 管线缓存
+    vk::PipelineCache m_pipelineCache;
+    std::filesystem::path m_pipelineCachePath;
+    PipelineCacheStats m_pipelineCacheStats;
+    uint64_t m_pipelineCacheChecksum = 0; ///< 磁盘上缓存数据的校验和，内容未变化时跳过写回
+
     // Swapchain相关
     vk::Format m_swapchainImageFormat;
     vk::Extent2D m_swapchainExtent;
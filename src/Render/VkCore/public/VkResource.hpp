@@ -89,6 +89,7 @@ struct BufferDesc
     BufferUsageFlags usage = BufferUsageFlags::None;
     MemoryUsage memory = MemoryUsage::GpuOnly;
     std::string debugName = "";
+    bool allowDirectWrite = false; ///< GpuOnly时允许放入可映射的设备内存（ReBAR/UMA），由CPU直接写入
 };
 
 /**
@@ -125,7 +126,7 @@ class ManagedBuffer
   public:
     ManagedBuffer() = default;
     ManagedBuffer(VkResourceAllocator *owner, vk::Buffer buffer, VmaAllocation allocation, vk::DeviceSize size,
-                  const std::string debugName = "");
+                  const std::string debugName = "", void *mappedData = nullptr);
     ManagedBuffer(const ManagedBuffer &) = delete;
     ManagedBuffer &operator=(const ManagedBuffer &) = delete;
     ManagedBuffer(ManagedBuffer &&other) noexcept;
@@ -144,6 +145,11 @@ class ManagedBuffer
     {
         return m_size;
     }
+    /** 持久映射地址，仅直接写入的设备内存有效，否则为nullptr */
+    void *getMappedData() const
+    {
+        return m_mappedData;
+    }
     const std::string &getDebugName() const
     {
         return m_debugName;
@@ -161,6 +167,7 @@ class ManagedBuffer
     vk::Buffer m_buffer{};
     VmaAllocation m_allocation = nullptr;
     vk::DeviceSize m_size = 0;
+    void *m_mappedData = nullptr;
     std::string m_debugName = "";
 };
 
@@ -321,6 +328,17 @@ class VkResourceAllocator
         return m_ctx;
     }
 
+    /**
+     * @brief 是否支持直接写入设备内存
+     *
+     * UMA设备（集成显卡、lavapipe等CPU设备）或开启ReBAR、BAR堆大于256MB的独立显卡上为true。
+     * 传统256MB BAR容量有限，不用于普通资源。
+     */
+    bool supportsDirectWrite() const
+    {
+        return m_directWriteSupported;
+    }
+
   private:
     // 内部转换函数
     vk::BufferUsageFlags toVkBufferUsage(BufferUsageFlags usage) const;
@@ -338,6 +356,7 @@ class VkResourceAllocator
 
     VmaAllocator m_allocator = VK_NULL_HANDLE;
     VkContext *m_ctx = nullptr;
+    bool m_directWriteSupported = false; ///< 存在可用的HOST_VISIBLE|DEVICE_LOCAL内存
 };
 
 } // namespace vkcore
\ No newline at end of file
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <vulkan/vulkan.hpp>
 
@@ -241,14 +244,36 @@ void copyBuffer(vk::CommandBuffer commandBuffer, vk::Buffer srcBuffer, vk::Buffe
 std::vector<uint32_t> loadSPIRV(const std::string &filename);
 
 /**
- * @brief 从GLSL源码编译SPIR-V（需要shaderc）
+ * @brief 着色器宏定义列表（名称, 值），值为空时等价于 `#define 名称`
+ */
+using ShaderDefines = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief 从GLSL源码编译SPIR-V（需要shaderc，由ENABLE_SHADERC编译选项启用）
  * @param source GLSL源码
  * @param shaderType 着色器类型
- * @param filename 文件名（用于错误信息）
+ * @param filename 文件名（用于错误信息，并作为相对 #include 的基准路径）
+ * @param defines 额外的宏定义（着色器变体）
  * @return std::vector<uint32_t> SPIR-V字节码
+ * @throws std::runtime_error 编译失败或未启用shaderc
+ *
+ * @note 目标环境为 Vulkan 1.3，可在多个线程中并发调用
  */
 std::vector<uint32_t> compileGLSLToSPIRV(const std::string &source, vk::ShaderStageFlagBits shaderType,
-                                         const std::string &filename = "shader");
+                                         const std::string &filename = "shader", const ShaderDefines &defines = {});
+
+/**
+ * @brief 预处理GLSL源码（展开 #include 与宏），用于计算编译缓存的键
+ * @see compileGLSLToSPIRV
+ */
+std::string preprocessGLSL(const std::string &source, vk::ShaderStageFlagBits shaderType,
+                           const std::string &filename = "shader", const ShaderDefines &defines = {});
+
+/**
+ * @brief 获取GLSL编译器版本标识，编译器升级后缓存的SPIR-V随之失效
+ * @return 版本字符串，未启用shaderc时返回空字符串
+ */
+std::string getGLSLCompilerVersion();
 
 // ==================== 验证与错误检查 ====================
 
@@ -301,6 +326,35 @@ size_t getUniformBufferAlignment(vk::PhysicalDevice physicalDevice);
  */
 size_t getStorageBufferAlignment(vk::PhysicalDevice physicalDevice);
 
+// ==================== 哈希 ====================
+
+/// 64位FNV-1a的初始值
+inline constexpr uint64_t kFnv1a64Offset = 0xcbf29ce484222325ull;
+
+/**
+ * @brief 计算 64 位 FNV-1a 哈希（资源包路径、缓存键与缓存文件校验共用）
+ * @param text 输入数据
+ * @param hash 初始值，传入上一段的结果即可分段计算
+ */
+constexpr uint64_t fnv1a64(std::string_view text, uint64_t hash = kFnv1a64Offset)
+{
+    for (char c : text)
+    {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief 计算任意字节序列的 64 位 FNV-1a 哈希
+ * @see fnv1a64(std::string_view, uint64_t)
+ */
+inline uint64_t fnv1a64(const void *data, size_t size, uint64_t hash = kFnv1a64Offset)
+{
+    return fnv1a64(std::string_view(static_cast<const char *>(data), size), hash);
+}
+
 } // namespace VkUtils
 
 } // namespace vkcore
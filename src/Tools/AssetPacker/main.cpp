@@ -0,0 +1,80 @@
+#include "AssetPackage.hpp"
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+
+namespace
+{
+void printUsage()
+{
+    std::cout << "usage: asset_packer <assets-dir> <output.rpak> [--no-compress]\n\n"
+                 "  assets-dir    directory packed recursively; entry paths are relative to it\n"
+                 "  output.rpak   package file; mount it with the same directory as the mount root\n"
+                 "  --no-compress store every entry uncompressed\n";
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::filesystem::path inputDir;
+    std::filesystem::path outputFile;
+    bool compress = true;
+    int positional = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--no-compress")
+            compress = false;
+        else if (arg == "--help" || arg == "-h")
+        {
+            printUsage();
+            return EXIT_SUCCESS;
+        }
+        else if (positional == 0)
+        {
+            inputDir = argv[i];
+            ++positional;
+        }
+        else if (positional == 1)
+        {
+            outputFile = argv[i];
+            ++positional;
+        }
+        else
+        {
+            std::cerr << "unexpected argument: " << arg << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    if (positional != 2)
+    {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+    if (!std::filesystem::is_directory(inputDir))
+    {
+        std::cerr << "not a directory: " << inputDir.string() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        // 先写临时文件再替换，打包失败时不会留下被截断的资源包
+        asset::AssetPackageBuilder builder;
+        const size_t files = builder.addDirectory(inputDir, compress);
+        std::filesystem::path tempFile = outputFile;
+        tempFile += ".tmp";
+        builder.write(tempFile);
+        std::filesystem::rename(tempFile, outputFile);
+        std::cout << "packed " << files << " files from " << inputDir.string() << " into " << outputFile.string()
+                  << " (" << std::filesystem::file_size(outputFile) << " bytes)" << std::endl;
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "asset_packer failed: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -1,5 +1,6 @@
 #include "Render/Renderer/public/EngineServices.hpp"
 #include "Render/VkCore/public/Logger.hpp"
+#include "Render/VkCore/public/Trace.hpp"
 #include "Render/VkCore/public/vkcore.hpp"
 #include "UI/MainWindow.hpp"
 #include "UI/VkRenderWindow.hpp"
@@ -8,7 +9,9 @@
 #include <QTimer>
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <filesystem>
+#include <future>
 #include <glm/glm.hpp>
 #include <iostream>
 #include <limits>
@@ -50,14 +53,19 @@ int main(int argc, char *argv[])
     auto winId = vkRenderWindowHandle->winId();
     mainWindow.show();
     renderer::EngineServices &services = renderer::EngineServices::instance();
+    TRACE_THREAD_NAME("Main");
 
     const std::filesystem::path projectRoot = findProjectRoot();
     const std::filesystem::path assetsRoot = projectRoot / "assets";
     const std::filesystem::path carAssetRoot = assetsRoot / "car";
     const std::filesystem::path shaderRoot = assetsRoot / "shaders/spv";
+    const std::filesystem::path shaderSourceRoot = assetsRoot / "shaders/code";
 
     vkcore::InstanceConfig instanceConfig;
     vkcore::DeviceConfig deviceConfig;
+    deviceConfig.pipelineCachePath = projectRoot / "cache/pipeline_cache.bin";
+    // 几何池中的全部子网格通过一次 drawIndexedIndirect 绘制
+    deviceConfig.features10.multiDrawIndirect = VK_TRUE;
     vkcore::SwapchainConfig swapchainConfig;
     swapchainConfig.width = 1280;
     swapchainConfig.height = 720;
@@ -70,15 +78,44 @@ int main(int argc, char *argv[])
     services.initializeTransferManager();
     auto &allocator = services.getService<vkcore::VkResourceAllocator>();
     auto &transferManager = services.getService<vkcore::TransferManager>();
-    auto &resourceManager = services.initializeResourceManager();
+    asset::ResourceManagerConfig resourceConfig;
+    resourceConfig.reflectionCacheDir = projectRoot / "cache/reflection";
+    resourceConfig.shaderCacheDir = projectRoot / "cache/spirv";
+    auto &resourceManager = services.initializeResourceManager(resourceConfig);
+    const uint32_t maxFramesInFlight = 3;
+    // 网格与纹理加载后由ResourceManager负责上传到GPU，网格统一存放在几何池中
+    asset::GeometryPoolConfig geometryPoolConfig;
+    geometryPoolConfig.framesInFlight = maxFramesInFlight;
+    geometryPoolConfig.multiDrawIndirect = true;
+    asset::GeometryPool geometryPool(allocator, transferManager, geometryPoolConfig);
+    resourceManager.enableGpuResidency(allocator, transferManager, &geometryPool);
+    // 存在打包好的资源包时，assets 目录下的资源改为从资源包读取
+    const std::filesystem::path assetsPackage = projectRoot / "assets.rpak";
+    if (std::filesystem::exists(assetsPackage))
+    {
+        resourceManager.mountPackage(assetsPackage, assetsRoot);
+    }
     auto &materialManager = services.initializeMaterialManager();
     auto &scene = services.initializeScene();
 
     auto meshFuture = resourceManager.loadMeshAsync(carAssetRoot / "car.obj");
-    auto shaderFuture = resourceManager.loadShaderAsync(shaderRoot, "car", false);
+    // 没有预编译的SPIR-V时（如未运行compile_shaders.ps1）在运行时从GLSL源码编译
+    std::shared_future<std::string> shaderFuture;
+    if (std::filesystem::exists(shaderRoot / "car.vert.spv"))
+    {
+        shaderFuture = resourceManager.loadShaderAsync(shaderRoot, "car", false);
+    }
+    else
+    {
+        shaderFuture = std::async(std::launch::async, [&resourceManager, shaderSourceRoot]() {
+                           return resourceManager.loadShaderFromSource(shaderSourceRoot, "car");
+                       }).share();
+    }
 
-    //加载材质
-    std::string materialId = materialManager.loadMaterialFromJson(carAssetRoot / "car.json");
+    //加载材质，其纹理与网格、着色器并发加载
+    auto materialFuture =
+        materialManager.loadMaterialFromJsonAsync(carAssetRoot / "car.json", asset::LoadPriority::Visible);
+    std::string materialId = materialFuture.get();
     std::shared_ptr<asset::PBRMaterial> material = materialManager.getMaterial(materialId);
     std::vector<std::filesystem::path> texturePaths = {material->textures.baseColor, material->textures.metallic,
                                                        material->textures.roughness, material->textures.normal};
@@ -92,8 +129,15 @@ int main(int argc, char *argv[])
 
     // 等待资源加载完成
     auto meshName = meshFuture.get();
+    // 渲染循环中通过句柄访问网格，避免每帧的字符串查找
+    const asset::MeshHandle meshHandle = resourceManager.getMeshHandle(meshName);
     auto shaderName = shaderFuture.get();
     std::vector<std::string> textureNames = textureFutures.get();
+    std::vector<asset::TextureHandle> textureHandles;
+    for (const auto &texName : textureNames)
+    {
+        textureHandles.push_back(resourceManager.getTextureHandle(texName));
+    }
 
     // 创建渲染对象、相机和光源
     // 创建光源
@@ -153,43 +197,6 @@ int main(int argc, char *argv[])
     lightBufferDesc.debugName = "Light UBO Buffer";
     auto lightBuffer = allocator.createBuffer(lightBufferDesc);
 
-    //创建顶点缓冲区
-    vkcore::BufferDesc vertexBufferDesc;
-    vertexBufferDesc.size = (*resourceManager.getMesh(meshName))[0].vertices.size() * sizeof(asset::Vertex);
-    vertexBufferDesc.usage = vkcore::BufferUsageFlags::Vertex | vkcore::BufferUsageFlags::StagingDst;
-    vertexBufferDesc.memory = vkcore::MemoryUsage::GpuOnly;
-    vertexBufferDesc.debugName = "Vertex Buffer";
-    auto vertexBuffer = allocator.createBuffer(vertexBufferDesc);
-
-    //创建索引缓冲区
-    vkcore::BufferDesc indexBufferDesc;
-    indexBufferDesc.size = (*resourceManager.getMesh(meshName))[0].indices.size() * sizeof(uint32_t);
-    indexBufferDesc.usage = vkcore::BufferUsageFlags::Index | vkcore::BufferUsageFlags::StagingDst;
-    indexBufferDesc.memory = vkcore::MemoryUsage::GpuOnly;
-    indexBufferDesc.debugName = "Index Buffer";
-    auto indexBuffer = allocator.createBuffer(indexBufferDesc);
-
-    //创建材质纹理Image
-    std::vector<vkcore::ManagedImage> textureImages;
-    for (const auto &texName : textureNames)
-    {
-        vkcore::ImageDesc imageDesc;
-        imageDesc.debugName = "Texture Image: " + texName;
-        imageDesc.width = resourceManager.getTexture(texName)->width;
-        imageDesc.height = resourceManager.getTexture(texName)->height;
-        imageDesc.depth = 1;
-        imageDesc.mipLevels = 1;
-        imageDesc.arrayLayers = 1;
-        imageDesc.format = vk::Format::eR8G8B8A8Unorm;
-        imageDesc.usage = vkcore::ImageUsageFlags::Sampled | vkcore::ImageUsageFlags::TransferDst;
-        imageDesc.memory = vkcore::MemoryUsage::GpuOnly;
-        imageDesc.type = vk::ImageType::e2D;
-        imageDesc.tiling = vk::ImageTiling::eOptimal;
-        imageDesc.flags = {};
-        auto textureImage = allocator.createImage(imageDesc);
-        textureImages.push_back(std::move(textureImage));
-    }
-
     //上传GPU资源数据
     //上传Buffers数据
     auto cameraUBO = scene.buildCameraUBO(cameraNode);
@@ -197,35 +204,40 @@ int main(int argc, char *argv[])
     auto lightUBO = scene.buildLightUBO();
     transferManager.writeToUniformBuffer(lightBuffer, &lightUBO, sizeof(asset::LightUBO), 0);
 
-    auto vertexToken =
-        transferManager.uploadToBuffer(vertexBuffer, (*resourceManager.getMesh(meshName))[0].vertices, 0);
-    auto indexToken = transferManager.uploadToBuffer(indexBuffer, (*resourceManager.getMesh(meshName))[0].indices, 0);
-
-    //上传纹理数据
-    std::vector<vkcore::TransferToken> textureTokens;
-    for (size_t i = 0; i < textureNames.size(); ++i)
+    //等待网格与纹理上传完成
+    resourceManager.waitForGpuUploads();
+    TRACE_EXPORT(projectRoot / "load_trace.json");
+    const vkcore::StagingStats stagingStats = transferManager.getStagingStats();
+    std::cout << "Staging: " << stagingStats.allocations << " allocations, " << stagingStats.allocatedBytes
+              << " bytes, " << stagingStats.stalls << " stalls (" << stagingStats.stallTimeMs << " ms), "
+              << stagingStats.dedicatedAllocations << " dedicated, " << stagingStats.directWrites
+              << " direct writes (" << stagingStats.directWriteBytes << " bytes), " << stagingStats.ringCount
+              << " rings (" << stagingStats.ringBytes << " bytes, " << stagingStats.ringGrowths << " growths)"
+              << std::endl;
+    const vkcore::StreamingStats streamingStats = transferManager.getStreamingStats();
+    std::cout << "Streaming: " << streamingStats.totalBytes << " bytes over " << streamingStats.frames
+              << " frames, peak " << streamingStats.peakFrameBytes << " bytes/frame, backlog "
+              << streamingStats.backlogRequests << " requests (" << streamingStats.backlogBytes << " bytes)"
+              << std::endl;
+    const vkcore::CommandBufferStats commandBufferStats = transferManager.getCommandBufferStats();
+    std::cout << "Command buffers: " << commandBufferStats.allocations << " allocated, " << commandBufferStats.reuses
+              << " reused, " << commandBufferStats.frees << " freed" << std::endl;
+    const asset::CacheStats meshCacheStats = resourceManager.getMeshCacheStats();
+    const asset::CacheStats textureCacheStats = resourceManager.getTextureCacheStats();
+    std::cout << "Cache residency: mesh " << meshCacheStats.residentBytes << " CPU / "
+              << meshCacheStats.gpuResidentBytes << " GPU bytes; texture " << textureCacheStats.residentBytes
+              << " CPU / " << textureCacheStats.gpuResidentBytes << " GPU bytes" << std::endl;
+    const asset::SnapshotMapStats &meshSnapshots = meshCacheStats.snapshots;
+    const asset::SnapshotMapStats &textureSnapshots = textureCacheStats.snapshots;
+    std::cout << "Cache snapshots: mesh " << meshSnapshots.publishes << " publishes, " << meshSnapshots.copiedEntries
+              << " copied entries, " << meshSnapshots.contendedWrites << " contended writes ("
+              << meshSnapshots.writeWaitTimeMs << " ms); texture " << textureSnapshots.publishes << " publishes, "
+              << textureSnapshots.copiedEntries << " copied entries, " << textureSnapshots.contendedWrites
+              << " contended writes (" << textureSnapshots.writeWaitTimeMs << " ms)" << std::endl;
+    std::vector<const asset::GpuTexture *> gpuTextures;
+    for (const auto &handle : textureHandles)
     {
-        auto textureData = resourceManager.getTexture(textureNames[i]);
-        textureTokens.push_back(transferManager.uploadToImage(textureImages[i], textureData->pixels,
-                                                              textureData->dataSize, textureData->width,
-                                                              textureData->height, 1, 0, 0));
-    }
-    //等待上传完成
-    for (auto &token : textureTokens)
-    {
-        if (!token.isComplete())
-        {
-            token.wait();
-        }
-    }
-
-    if (!vertexToken.isComplete())
-    {
-        vertexToken.wait();
-    }
-    if (!indexToken.isComplete())
-    {
-        indexToken.wait();
+        gpuTextures.push_back(resourceManager.getGpuTexture(handle));
     }
     //获取描述符集布局和分配描述符
     std::vector<std::shared_ptr<const vkcore::DescriptorSetSchema>> descriptorSetSchemas =
@@ -245,16 +257,45 @@ int main(int argc, char *argv[])
         .writeBuffer("uCamera", vk::DescriptorBufferInfo{cameraBuffer.getBuffer(), 0, sizeof(asset::CameraUBO)})
         .update();
 
-    vkcore::DescriptorSetWriter::begin(context.getDevice(), descriptorSetSchemas[1], descriptorSets[1])
-        .writeImage("uBaseColorMap", vk::DescriptorImageInfo{sampler.getSampler(), textureImages[0].getView(),
-                                                             vk::ImageLayout::eShaderReadOnlyOptimal})
-        .writeImage("uMetallicMap", vk::DescriptorImageInfo{sampler.getSampler(), textureImages[1].getView(),
-                                                            vk::ImageLayout::eShaderReadOnlyOptimal})
-        .writeImage("uRoughnessMap", vk::DescriptorImageInfo{sampler.getSampler(), textureImages[2].getView(),
-                                                             vk::ImageLayout::eShaderReadOnlyOptimal})
-        .writeImage("uNormalMap", vk::DescriptorImageInfo{sampler.getSampler(), textureImages[3].getView(),
-                                                          vk::ImageLayout::eShaderReadOnlyOptimal})
-        .update();
+    auto writeMaterialDescriptors = [&]() {
+        vkcore::DescriptorSetWriter::begin(context.getDevice(), descriptorSetSchemas[1], descriptorSets[1])
+            .writeImage("uBaseColorMap", vk::DescriptorImageInfo{sampler.getSampler(), gpuTextures[0]->image.getView(),
+                                                                 vk::ImageLayout::eShaderReadOnlyOptimal})
+            .writeImage("uMetallicMap", vk::DescriptorImageInfo{sampler.getSampler(), gpuTextures[1]->image.getView(),
+                                                                vk::ImageLayout::eShaderReadOnlyOptimal})
+            .writeImage("uRoughnessMap", vk::DescriptorImageInfo{sampler.getSampler(), gpuTextures[2]->image.getView(),
+                                                                 vk::ImageLayout::eShaderReadOnlyOptimal})
+            .writeImage("uNormalMap", vk::DescriptorImageInfo{sampler.getSampler(), gpuTextures[3]->image.getView(),
+                                                              vk::ImageLayout::eShaderReadOnlyOptimal})
+            .update();
+    };
+    writeMaterialDescriptors();
+
+    //资源热重载：纹理替换后需要重写描述符集，着色器替换后需要重建管线
+    auto &hotReload = services.initializeHotReload();
+    hotReload.watchDirectory(assetsRoot);
+    hotReload.addListener([&](const asset::ReloadEvent &event) {
+        if (!event.succeeded)
+            return;
+        if (event.kind == asset::ReloadKind::Texture)
+        {
+            // 描述符集正被在途帧使用，等待新纹理上传与设备空闲后再更新
+            resourceManager.waitForGpuUploads();
+            context.getDevice().waitIdle();
+            for (size_t i = 0; i < textureHandles.size(); ++i)
+            {
+                if (const asset::GpuTexture *texture = resourceManager.getGpuTexture(textureHandles[i]))
+                {
+                    gpuTextures[i] = texture;
+                }
+            }
+            writeMaterialDescriptors();
+        }
+        else if (event.kind == asset::ReloadKind::Shader)
+        {
+            std::cout << "Shader " << event.resourceId << " reloaded, pipeline rebuild required" << std::endl;
+        }
+    });
 
     //创建交换链Image的视图
     std::vector<vk::ImageView> swapchainImageViews;
@@ -389,7 +430,17 @@ int main(int argc, char *argv[])
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
     pipelineInfo.pNext = &pipelineRenderingInfo;
 
-    vk::Pipeline graphicsPipeline = context.getDevice().createGraphicsPipeline(VK_NULL_HANDLE, pipelineInfo).value;
+    // 通过管线缓存创建，命中磁盘缓存时可跳过驱动的着色器编译
+    const auto pipelineStart = std::chrono::steady_clock::now();
+    vk::Pipeline graphicsPipeline =
+        context.getDevice().createGraphicsPipeline(context.getPipelineCache(), pipelineInfo).value;
+    const double pipelineMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pipelineStart).count();
+    const vkcore::PipelineCacheStats &cacheStats = context.getPipelineCacheStats();
+    std::cout << "Pipeline creation: " << pipelineMs << " ms ("
+              << (cacheStats.loadedBytes > 0 ? "warm" : "cold") << " cache, " << cacheStats.loadedBytes
+              << " bytes loaded in " << cacheStats.loadTimeMs << " ms)" << std::endl;
+    context.savePipelineCache();
 
     //创建命令缓冲区池和命令缓冲区
     vk::CommandPoolCreateInfo poolInfo{};
@@ -408,7 +459,6 @@ int main(int argc, char *argv[])
 
     //主渲染循环
     int frameIndex = 0;
-    const uint32_t maxFramesInFlight = 3;
 
     std::vector<vk::Semaphore> imageAvailableSemaphores(maxFramesInFlight);
     std::vector<vk::Semaphore> renderFinishedSemaphores(maxFramesInFlight);
@@ -426,6 +476,7 @@ int main(int argc, char *argv[])
     }
 
     bool depthInitialized = false;
+    std::vector<vk::DrawIndexedIndirectCommand> drawCommands;
     const uint32_t maxFrames = 1000;
     frameIndex = 0;
 
@@ -436,6 +487,11 @@ int main(int argc, char *argv[])
         context.getDevice().waitForFences(1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
         context.getDevice().resetFences(1, &inFlightFences[currentFrame]);
 
+        // 帧边界：按预算淘汰长时间未使用的CPU侧资源，释放帧时间线已越过的退役GPU资源
+        resourceManager.trimCaches();
+        resourceManager.flushGpuUploads();
+        hotReload.poll();
+
         auto acquireResult = context.getDevice().acquireNextImageKHR(
             context.getSwapchain(), UINT64_MAX, imageAvailableSemaphores[currentFrame], VK_NULL_HANDLE);
 
@@ -454,6 +510,9 @@ int main(int argc, char *argv[])
         beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
         commandBuffer.begin(beginInfo);
 
+        // 获取在传输队列上完成上传的图像的所有权
+        const vkcore::TransferToken acquireToken = transferManager.recordPendingAcquires(commandBuffer);
+
         //交换链颜色图像屏障
         {
             vk::ImageMemoryBarrier swapchainBarrier{};
@@ -543,12 +602,31 @@ int main(int argc, char *argv[])
         commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineLayout, 0,
                                          static_cast<uint32_t>(descriptorSets.size()), descriptorSets.data(), 0,
                                          nullptr);
-        auto renderVertex = vertexBuffer.getBuffer();
-        vk::DeviceSize offsets[] = {0};
-        commandBuffer.bindVertexBuffers(0, 1, &renderVertex, offsets);
-        commandBuffer.bindIndexBuffer(indexBuffer.getBuffer(), 0, vk::IndexType::eUint32);
-        commandBuffer.drawIndexed(static_cast<uint32_t>((*resourceManager.getMesh(meshName))[0].indices.size()), 1, 0,
-                                  0, 0);
+        // 网格可能被热重载替换，每帧通过句柄获取当前的GPU数据
+        const asset::GpuMesh *gpuMesh = resourceManager.getGpuMesh(meshHandle);
+        if (gpuMesh && gpuMesh->isPooled())
+        {
+            // 池中的子网格共享顶点/索引缓冲，合并为间接命令一次提交
+            drawCommands.clear();
+            for (const asset::GpuSubmesh &submesh : gpuMesh->submeshes)
+            {
+                drawCommands.push_back(asset::GeometryPool::makeDrawCommand(submesh));
+            }
+            geometryPool.bind(commandBuffer);
+            geometryPool.drawIndexedIndirect(commandBuffer, currentFrame, drawCommands);
+        }
+        else if (gpuMesh)
+        {
+            // 池空间不足时网格使用独立缓冲，逐个子网格绘制
+            auto renderVertex = gpuMesh->vertexBuffer.getBuffer();
+            vk::DeviceSize offsets[] = {0};
+            commandBuffer.bindVertexBuffers(0, 1, &renderVertex, offsets);
+            commandBuffer.bindIndexBuffer(gpuMesh->indexBuffer.getBuffer(), 0, vk::IndexType::eUint32);
+            for (const asset::GpuSubmesh &submesh : gpuMesh->submeshes)
+            {
+                commandBuffer.drawIndexed(submesh.indexCount, 1, submesh.firstIndex, submesh.vertexOffset, 0);
+            }
+        }
         commandBuffer.endRendering();
 
         //交换链图像屏障，准备呈现
@@ -572,18 +650,30 @@ int main(int argc, char *argv[])
         }
         commandBuffer.end();
 
-        // 提交命令缓冲区
+        // 提交命令缓冲区，有所有权获取时在GPU端等待对应的传输时间线值
         vk::SubmitInfo submitInfo{};
-        vk::Semaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame]};
-        vk::PipelineStageFlags waitStages[] = {vk::PipelineStageFlagBits::eColorAttachmentOutput};
-        vk::Semaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrame]};
-
-        submitInfo.waitSemaphoreCount = 1;
+        vk::Semaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame], acquireToken.getSemaphore()};
+        vk::PipelineStageFlags waitStages[] = {vk::PipelineStageFlagBits::eColorAttachmentOutput,
+                                               vk::PipelineStageFlagBits::eFragmentShader};
+        uint64_t waitValues[] = {0, acquireToken.getValue()};
+        // 同时发出帧时间线信号：资源管理器据此判断退役的GPU资源何时不再被命令缓冲引用
+        const asset::FrameSignal frameSignal = resourceManager.nextFrameSignal();
+        vk::Semaphore signalSemaphores[] = {renderFinishedSemaphores[currentFrame], frameSignal.semaphore};
+        uint64_t signalValues[] = {0, frameSignal.value};
+
+        vk::TimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.waitSemaphoreValueCount = acquireToken.getSemaphore() ? 2 : 1;
+        timelineInfo.pWaitSemaphoreValues = waitValues;
+        timelineInfo.signalSemaphoreValueCount = 2;
+        timelineInfo.pSignalSemaphoreValues = signalValues;
+
+        submitInfo.pNext = &timelineInfo;
+        submitInfo.waitSemaphoreCount = acquireToken.getSemaphore() ? 2 : 1;
         submitInfo.pWaitSemaphores = waitSemaphores;
         submitInfo.pWaitDstStageMask = waitStages;
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &commandBuffer;
-        submitInfo.signalSemaphoreCount = 1;
+        submitInfo.signalSemaphoreCount = 2;
         submitInfo.pSignalSemaphores = signalSemaphores;
         context.getGraphicsQueue().submit(1, &submitInfo, inFlightFences[currentFrame]);
 
@@ -600,5 +690,9 @@ int main(int argc, char *argv[])
         frameIndex = frameIndex + 1;
     }
 
+    // ResourceManager持有GPU资源，需在设备空闲后、分配器销毁前释放
+    context.getDevice().waitIdle();
+    resourceManager.cleanup();
+
     return app.exec();
 }
\ No newline at end of file